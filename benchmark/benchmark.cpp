@@ -0,0 +1,126 @@
+//
+// Created by user on 2026/10/17.
+//
+
+#include "benchmark.h"
+#include "libplatform/libplatform.h"
+#include "v8.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+/**
+ * 已注册的基准测试，使用函数内的静态变量避免静态初始化顺序问题
+ * @return
+ */
+static std::vector<std::pair<const char *, Benchmark::BenchmarkFun>> &registry() {
+    static std::vector<std::pair<const char *, Benchmark::BenchmarkFun>> benchmarks;
+    return benchmarks;
+}
+
+bool Benchmark::Register(const char *name, BenchmarkFun fun) {
+    registry().emplace_back(name, fun);
+    return true;
+}
+
+int Benchmark::RunAll(const char *filter) {
+    int count = 0;
+    for (auto &entry : registry()) {
+        if (filter != nullptr && strstr(entry.first, filter) == nullptr) {
+            continue;
+        }
+        Benchmark benchmark(entry.first);
+        entry.second(benchmark);
+        count++;
+    }
+    return count;
+}
+
+/**
+ * 所有用例的测量结果
+ * @return
+ */
+static std::vector<Benchmark::Result> &results() {
+    static std::vector<Benchmark::Result> results;
+    return results;
+}
+
+void Benchmark::report(const std::string &caseName, size_t iterations, size_t operations, std::vector<double> &samples) {
+    std::sort(samples.begin(), samples.end());
+    double sum = 0;
+    for (double sample : samples) {
+        sum += sample;
+    }
+    Result result{_name, caseName, iterations, operations, samples.front(), samples[samples.size() / 2], sum / static_cast<double>(samples.size())};
+    results().push_back(result);
+    // 进度输出到标准错误，标准输出只保留 JSON
+    fprintf(stderr, "%-40s %-32s %10zu iterations %14.1f ns/op (min %.1f)\n", _name.c_str(), caseName.c_str(), iterations,
+            result.median, result.min);
+}
+
+/**
+ * 输出 JSON 字符串，转义引号、反斜杠和控制字符
+ * @param out
+ * @param value
+ */
+static void writeJsonString(FILE *out, const std::string &value) {
+    fputc('"', out);
+    for (char c : value) {
+        if (c == '"' || c == '\\') {
+            fprintf(out, "\\%c", c);
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            fprintf(out, "\\u%04x", c);
+        } else {
+            fputc(c, out);
+        }
+    }
+    fputc('"', out);
+}
+
+void Benchmark::WriteJson(FILE *out) {
+    fprintf(out, "{\n  \"v8_version\": ");
+    writeJsonString(out, v8::V8::GetVersion());
+    fprintf(out, ",\n  \"unit\": \"ns/op\",\n  \"results\": [");
+    for (size_t i = 0; i < results().size(); i++) {
+        const Result &result = results()[i];
+        fprintf(out, "%s\n    {\"benchmark\": ", i == 0 ? "" : ",");
+        writeJsonString(out, result.benchmark);
+        fprintf(out, ", \"case\": ");
+        writeJsonString(out, result.caseName);
+        fprintf(out, ", \"iterations\": %zu, \"operations\": %zu, \"min\": %.3f, \"median\": %.3f, \"mean\": %.3f}",
+                result.iterations, result.operations, result.min, result.median, result.mean);
+    }
+    fprintf(out, "\n  ]\n}\n");
+    fflush(out);
+}
+
+int main(int argc, char **argv) {
+    v8::V8::InitializeICUDefaultLocation(argv[0]);
+    v8::V8::InitializeExternalStartupData(argv[0]);
+    std::unique_ptr<v8::Platform> platform = v8::platform::NewDefaultPlatform();
+    v8::V8::InitializePlatform(platform.get());
+    v8::V8::Initialize();
+    // 参数：[过滤条件] [--json=输出文件]，不指定输出文件时 JSON 写到标准输出
+    const char *filter = nullptr;
+    const char *jsonPath = nullptr;
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--json=", 7) == 0) {
+            jsonPath = argv[i] + 7;
+        } else {
+            filter = argv[i];
+        }
+    }
+    int count = Benchmark::RunAll(filter);
+    FILE *out = jsonPath != nullptr ? fopen(jsonPath, "w") : stdout;
+    if (out != nullptr) {
+        Benchmark::WriteJson(out);
+        if (out != stdout) {
+            fclose(out);
+        }
+    }
+    v8::V8::Dispose();
+    v8::V8::ShutdownPlatform();
+    return count > 0 ? 0 : 1;
+}
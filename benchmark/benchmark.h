@@ -0,0 +1,97 @@
+//
+// Created by user on 2026/10/17.
+//
+
+#ifndef V8_LEARN_BENCHMARK_H
+#define V8_LEARN_BENCHMARK_H
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/**
+ * 简单的基准测试框架。
+ * 通过 BENCHMARK 宏注册基准测试，在基准测试中调用 measure 测量每个用例。
+ * 每个用例重复测量 kRepetitions 轮，结果以 JSON 输出，便于在升级 v8 前后对比。
+ */
+class Benchmark {
+public:
+    using BenchmarkFun = void (*)(Benchmark &benchmark);
+    static const size_t kRepetitions = 5;
+    /**
+     * 一个用例的测量结果，时间单位为纳秒每次操作
+     */
+    struct Result {
+        std::string benchmark;
+        std::string caseName;
+        size_t iterations;
+        size_t operations;
+        double min;
+        double median;
+        double mean;
+    };
+    /**
+     * 注册基准测试
+     * @param name
+     * @param fun
+     * @return
+     */
+    static bool Register(const char *name, BenchmarkFun fun);
+    /**
+     * 执行名称包含 filter 的基准测试
+     * @param filter 为 nullptr 时全部执行
+     * @return
+     */
+    static int RunAll(const char *filter);
+    /**
+     * 把所有结果以 JSON 写出
+     * @param out
+     */
+    static void WriteJson(FILE *out);
+
+    explicit Benchmark(std::string name) : _name(std::move(name)) {}
+
+    /**
+     * 执行 iterations 次 fun，报告平均每次的耗时
+     * @param caseName
+     * @param iterations
+     * @param fun
+     */
+    template<typename F>
+    void measure(const std::string &caseName, size_t iterations, F fun) {
+        measure(caseName, iterations, 1, fun);
+    }
+    /**
+     * 执行 iterations 次 fun，每次 fun 内部包含 operations 次操作，报告平均每次操作的耗时
+     * @param caseName
+     * @param iterations
+     * @param operations
+     * @param fun
+     */
+    template<typename F>
+    void measure(const std::string &caseName, size_t iterations, size_t operations, F fun) {
+        // 预热一次，排除懒编译、内联缓存等首次执行的开销
+        fun();
+        std::vector<double> samples;
+        for (size_t repetition = 0; repetition < kRepetitions; repetition++) {
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < iterations; i++) {
+                fun();
+            }
+            std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+            samples.push_back(std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(iterations * operations));
+        }
+        report(caseName, iterations, operations, samples);
+    }
+
+private:
+    void report(const std::string &caseName, size_t iterations, size_t operations, std::vector<double> &samples);
+    std::string _name;
+};
+
+#define BENCHMARK(name)                                                       \
+    static void name(Benchmark &benchmark);                                   \
+    static bool name##_registered = Benchmark::Register(#name, name);         \
+    static void name(Benchmark &benchmark)
+
+#endif//V8_LEARN_BENCHMARK_H
@@ -0,0 +1,57 @@
+//
+// Created by user on 2026/10/17.
+//
+// process.binding 获取内建模块的开销，bar 模块通过 require 依赖 foo 模块
+
+#include "../test/base/nodeBuildInModule.h"
+#include "benchmark.h"
+#include "v8.h"
+
+/**
+ * 创建设置了 process.binding 的上下文
+ * @param isolate
+ * @return
+ */
+static v8::Local<v8::Context> newContext(v8::Isolate *isolate) {
+    v8::Local<v8::Context> context = v8::Context::New(isolate);
+    v8::Local<v8::Object> process = v8::Object::New(isolate);
+    process->Set(context, v8::String::NewFromUtf8Literal(isolate, "binding"),
+                 v8::Function::New(context, internalBinding).ToLocalChecked())
+            .Check();
+    context->Global()->Set(context, v8::String::NewFromUtf8Literal(isolate, "process"), process).Check();
+    return context;
+}
+
+BENCHMARK(build_in_module_binding) {
+    v8::Isolate::CreateParams create_params;
+    create_params.array_buffer_allocator = v8::ArrayBuffer::Allocator::NewDefaultAllocator();
+    v8::Isolate *isolate = v8::Isolate::New(create_params);
+    {
+        v8::Isolate::Scope scope(isolate);
+        v8::HandleScope handleScope(isolate);
+        const char *loopSource = "(function (n) { var m; for (var i = 0; i < n; i++) m = process.binding('bar'); return m; })";
+        // 新上下文中第一次加载，包含执行注册函数和 require('foo')
+        benchmark.measure("cold", 200, [&]() -> void {
+            v8::HandleScope handleScope(isolate);
+            v8::Local<v8::Context> context = newContext(isolate);
+            v8::Context::Scope contextScope(context);
+            v8::Local<v8::Value> argv[] = {v8::Number::New(isolate, 1)};
+            v8::Local<v8::Function> loop = v8::Script::Compile(context, v8::String::NewFromUtf8(isolate, loopSource).ToLocalChecked())
+                                                   .ToLocalChecked()->Run(context).ToLocalChecked().As<v8::Function>();
+            loop->Call(context, context->Global(), 1, argv).ToLocalChecked();
+        });
+        // 同一个上下文中重复加载，摊销后只剩缓存查找
+        v8::Local<v8::Context> context = newContext(isolate);
+        v8::Context::Scope contextScope(context);
+        v8::Local<v8::Function> loop = v8::Script::Compile(context, v8::String::NewFromUtf8(isolate, loopSource).ToLocalChecked())
+                                               .ToLocalChecked()->Run(context).ToLocalChecked().As<v8::Function>();
+        const size_t operations = 10000;
+        v8::Local<v8::Value> argv[] = {v8::Number::New(isolate, operations)};
+        benchmark.measure("amortized", 100, operations, [&]() -> void {
+            loop->Call(context, context->Global(), 1, argv).ToLocalChecked();
+        });
+    }
+    disposeBuildInModuleTemplates(isolate);
+    isolate->Dispose();
+    delete create_params.array_buffer_allocator;
+}
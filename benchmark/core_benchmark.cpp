@@ -0,0 +1,148 @@
+//
+// Created by user on 2026/10/17.
+//
+// 嵌入 v8 的核心操作的开销
+
+#include "benchmark.h"
+#include "v8.h"
+#include <string>
+
+/**
+ * 基准测试使用的隔离实例，构造时进入，析构时销毁
+ */
+class BenchmarkIsolate {
+public:
+    BenchmarkIsolate() {
+        _create_params.array_buffer_allocator = v8::ArrayBuffer::Allocator::NewDefaultAllocator();
+        _isolate = v8::Isolate::New(_create_params);
+        _isolate->Enter();
+    }
+    ~BenchmarkIsolate() {
+        _isolate->Exit();
+        _isolate->Dispose();
+        delete _create_params.array_buffer_allocator;
+    }
+    v8::Isolate *get() { return _isolate; }
+
+private:
+    v8::Isolate::CreateParams _create_params;
+    v8::Isolate *_isolate;
+};
+
+static void Noop(const v8::FunctionCallbackInfo<v8::Value> &info) {
+    info.GetReturnValue().Set(info[0]);
+}
+
+static v8::Local<v8::Value> Run(v8::Local<v8::Context> context, const char *source) {
+    v8::Isolate *isolate = context->GetIsolate();
+    v8::Local<v8::String> code = v8::String::NewFromUtf8(isolate, source).ToLocalChecked();
+    return v8::Script::Compile(context, code).ToLocalChecked()->Run(context).ToLocalChecked();
+}
+
+BENCHMARK(isolate_new) {
+    benchmark.measure("new_dispose", 20, []() -> void {
+        v8::Isolate::CreateParams create_params;
+        create_params.array_buffer_allocator = v8::ArrayBuffer::Allocator::NewDefaultAllocator();
+        v8::Isolate *isolate = v8::Isolate::New(create_params);
+        isolate->Dispose();
+        delete create_params.array_buffer_allocator;
+    });
+}
+
+BENCHMARK(context_new) {
+    BenchmarkIsolate isolate;
+    v8::HandleScope handleScope(isolate.get());
+    benchmark.measure("default", 200, [&]() -> void {
+        v8::HandleScope handleScope(isolate.get());
+        v8::Context::New(isolate.get());
+    });
+    v8::Local<v8::ObjectTemplate> global = v8::ObjectTemplate::New(isolate.get());
+    for (int i = 0; i < 16; i++) {
+        std::string name = "fun" + std::to_string(i);
+        global->Set(isolate.get(), name.c_str(), v8::FunctionTemplate::New(isolate.get(), Noop));
+        global->Set(isolate.get(), ("property" + std::to_string(i)).c_str(), v8::Number::New(isolate.get(), i));
+    }
+    benchmark.measure("global_template", 200, [&]() -> void {
+        v8::HandleScope handleScope(isolate.get());
+        v8::Context::New(isolate.get(), nullptr, global);
+    });
+    // 上下文回收发生在下一次 GC，避免影响后面的基准测试
+    isolate.get()->ContextDisposedNotification();
+    isolate.get()->LowMemoryNotification();
+}
+
+BENCHMARK(script_compile_run) {
+    BenchmarkIsolate isolate;
+    v8::HandleScope handleScope(isolate.get());
+    v8::Local<v8::Context> context = v8::Context::New(isolate.get());
+    v8::Context::Scope contextScope(context);
+    // 源码相同时命中隔离实例的编译缓存
+    benchmark.measure("cached", 10000, [&]() -> void {
+        v8::HandleScope handleScope(isolate.get());
+        Run(context, "var a = 1; a + 1;");
+    });
+    size_t index = 0;
+    benchmark.measure("uncached", 2000, [&]() -> void {
+        v8::HandleScope handleScope(isolate.get());
+        std::string source = "var a" + std::to_string(index++) + " = 1; function f() { return 1; } f();";
+        Run(context, source.c_str());
+    });
+}
+
+BENCHMARK(function_call) {
+    BenchmarkIsolate isolate;
+    v8::HandleScope handleScope(isolate.get());
+    v8::Local<v8::Context> context = v8::Context::New(isolate.get());
+    v8::Context::Scope contextScope(context);
+    v8::Local<v8::Function> add = Run(context, "(function add(a, b) { return a + b; })").As<v8::Function>();
+    v8::Local<v8::Value> argv[] = {v8::Number::New(isolate.get(), 1), v8::Number::New(isolate.get(), 2)};
+    benchmark.measure("cpp_to_js", 100000, [&]() -> void {
+        v8::HandleScope handleScope(isolate.get());
+        add->Call(context, context->Global(), 2, argv).ToLocalChecked();
+    });
+}
+
+BENCHMARK(native_callback) {
+    BenchmarkIsolate isolate;
+    v8::HandleScope handleScope(isolate.get());
+    v8::Local<v8::Context> context = v8::Context::New(isolate.get());
+    v8::Context::Scope contextScope(context);
+    context->Global()->Set(context, v8::String::NewFromUtf8Literal(isolate.get(), "native"),
+                           v8::Function::New(context, Noop).ToLocalChecked()).Check();
+    v8::Local<v8::Function> loop = Run(context, "(function loop(n) { for (var i = 0; i < n; i++) native(i); })").As<v8::Function>();
+    const size_t operations = 10000;
+    v8::Local<v8::Value> argv[] = {v8::Number::New(isolate.get(), operations)};
+    benchmark.measure("js_to_cpp", 100, operations, [&]() -> void {
+        v8::HandleScope handleScope(isolate.get());
+        loop->Call(context, context->Global(), 1, argv).ToLocalChecked();
+    });
+}
+
+BENCHMARK(handle_scope) {
+    BenchmarkIsolate isolate;
+    v8::HandleScope handleScope(isolate.get());
+    benchmark.measure("open_close", 1000000, [&]() -> void {
+        v8::HandleScope handleScope(isolate.get());
+    });
+    benchmark.measure("open_close_with_handle", 1000000, [&]() -> void {
+        v8::HandleScope handleScope(isolate.get());
+        v8::Integer::New(isolate.get(), 1);
+    });
+}
+
+BENCHMARK(promise_resolver) {
+    BenchmarkIsolate isolate;
+    isolate.get()->SetMicrotasksPolicy(v8::MicrotasksPolicy::kExplicit);
+    v8::HandleScope handleScope(isolate.get());
+    v8::Local<v8::Context> context = v8::Context::New(isolate.get());
+    v8::Context::Scope contextScope(context);
+    v8::Local<v8::Function> then = v8::Function::New(context, Noop).ToLocalChecked();
+    // 创建、注册回调、决议、执行微任务的完整往返
+    benchmark.measure("round_trip", 10000, [&]() -> void {
+        v8::HandleScope handleScope(isolate.get());
+        v8::Local<v8::Promise::Resolver> resolver = v8::Promise::Resolver::New(context).ToLocalChecked();
+        resolver->GetPromise()->Then(context, then).ToLocalChecked();
+        resolver->Resolve(context, v8::Undefined(isolate.get())).Check();
+        isolate.get()->PerformMicrotaskCheckpoint();
+    });
+}
@@ -0,0 +1,27 @@
+//
+// Created by user on 2026/10/17.
+//
+// 不同工作线程数量下 CPU 密集脚本的吞吐量，每次操作的耗时应该随工作线程数量近似线性下降
+
+#include "../test/base/isolateExecutor.h"
+#include "benchmark.h"
+#include <algorithm>
+#include <thread>
+
+BENCHMARK(isolate_executor_throughput) {
+    const size_t jobCount = 64;
+    size_t maxWorkers = std::max(1u, std::thread::hardware_concurrency());
+    for (size_t workers = 1; workers <= maxWorkers; workers *= 2) {
+        IsolateExecutor executor(workers, "function fib(n) { return n < 2 ? n : fib(n - 1) + fib(n - 2); }");
+        benchmark.measure("workers_" + std::to_string(workers), 1, jobCount, [&]() -> void {
+            std::vector<std::future<IsolateExecutor::Result>> futures;
+            futures.reserve(jobCount);
+            for (size_t i = 0; i < jobCount; i++) {
+                futures.push_back(executor.evaluate("fib(22)"));
+            }
+            for (std::future<IsolateExecutor::Result> &future : futures) {
+                future.wait();
+            }
+        });
+    }
+}
@@ -0,0 +1,96 @@
+//
+// Created by user on 2026/10/17.
+//
+// 两个隔离实例之间往返传递大块 ArrayBuffer：复制时逐字节序列化，转移时只传递 BackingStore
+
+#include "../test/base/messageChannel.h"
+#include "benchmark.h"
+#include <thread>
+
+namespace {
+    /**
+     * 一个隔离实例和它的上下文
+     */
+    struct Endpoint {
+        explicit Endpoint(v8::ArrayBuffer::Allocator *allocator) {
+            v8::Isolate::CreateParams create_params;
+            create_params.array_buffer_allocator = allocator;
+            isolate = v8::Isolate::New(create_params);
+            v8::Isolate::Scope isolateScope(isolate);
+            v8::HandleScope handleScope(isolate);
+            context.Reset(isolate, v8::Context::New(isolate));
+        }
+        ~Endpoint() {
+            context.Reset();
+            isolate->Dispose();
+        }
+        v8::Isolate *isolate;
+        v8::Global<v8::Context> context;
+    };
+
+    /**
+     * 发送方在当前线程，接收方在另一个线程收到后原样转移回来
+     * @param benchmark
+     * @param caseName
+     * @param size
+     * @param transfer
+     */
+    void roundTrip(Benchmark &benchmark, const std::string &caseName, size_t size, bool transfer) {
+        const size_t iterations = 16;
+        // 两个隔离实例共享线程安全的分配器，转移的内存可以由任意一方释放
+        std::unique_ptr<v8::ArrayBuffer::Allocator> allocator(v8::ArrayBuffer::Allocator::NewDefaultAllocator());
+        MessageChannel channel(4);
+        Endpoint sender(allocator.get());
+        // 预热一次加上每轮的次数
+        const size_t total = 1 + Benchmark::kRepetitions * iterations;
+        std::thread echo([&]() -> void {
+            Endpoint receiver(allocator.get());
+            v8::Isolate::Scope isolateScope(receiver.isolate);
+            v8::HandleScope handleScope(receiver.isolate);
+            v8::Local<v8::Context> context = receiver.context.Get(receiver.isolate);
+            v8::Context::Scope contextScope(context);
+            MessagePort *port = channel.getPort2();
+            for (size_t i = 0; i < total; i++) {
+                v8::HandleScope scope(receiver.isolate);
+                while (!port->hasMessage()) {
+                    std::this_thread::yield();
+                }
+                v8::Local<v8::ArrayBuffer> buffer = port->receiveMessage(context).ToLocalChecked().As<v8::ArrayBuffer>();
+                std::vector<v8::Local<v8::ArrayBuffer>> transferList;
+                if (transfer) {
+                    transferList.push_back(buffer);
+                }
+                port->postMessage(context, buffer, transferList).Check();
+            }
+        });
+        {
+            v8::Isolate::Scope isolateScope(sender.isolate);
+            v8::HandleScope handleScope(sender.isolate);
+            v8::Local<v8::Context> context = sender.context.Get(sender.isolate);
+            v8::Context::Scope contextScope(context);
+            MessagePort *port = channel.getPort1();
+            v8::Global<v8::ArrayBuffer> buffer(sender.isolate, v8::ArrayBuffer::New(sender.isolate, size));
+            benchmark.measure(caseName, iterations, [&]() -> void {
+                v8::HandleScope scope(sender.isolate);
+                std::vector<v8::Local<v8::ArrayBuffer>> transferList;
+                if (transfer) {
+                    transferList.push_back(buffer.Get(sender.isolate));
+                }
+                port->postMessage(context, buffer.Get(sender.isolate), transferList).Check();
+                while (!port->hasMessage()) {
+                    std::this_thread::yield();
+                }
+                buffer.Reset(sender.isolate, port->receiveMessage(context).ToLocalChecked().As<v8::ArrayBuffer>());
+            });
+        }
+        echo.join();
+    }
+}// namespace
+
+BENCHMARK(message_channel_round_trip) {
+    for (size_t size : {64 * 1024, 16 * 1024 * 1024}) {
+        std::string suffix = std::to_string(size / 1024) + "kb";
+        roundTrip(benchmark, "copy_" + suffix, size, false);
+        roundTrip(benchmark, "transfer_" + suffix, size, true);
+    }
+}
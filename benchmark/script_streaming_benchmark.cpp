@@ -0,0 +1,53 @@
+//
+// Created by user on 2026/10/17.
+//
+// 对比先读完整个文件再编译和边读边流式编译，测量到得到可执行脚本的时间
+
+#include "../test/base/scriptStreamer.h"
+#include "../test/base/sourceFile.h"
+#include "benchmark.h"
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+BENCHMARK(script_streaming_compile) {
+    const size_t iterations = 4;
+    // 预热一次加上每轮的次数，每次使用不同的文件，避免命中隔离实例的编译缓存
+    const size_t fileCount = 1 + Benchmark::kRepetitions * iterations;
+    std::vector<std::string> paths;
+    for (size_t i = 0; i < fileCount * 2; i++) {
+        std::string path = "benchmark_stream_" + std::to_string(i) + ".js";
+        std::ofstream out(path.c_str(), std::ios::binary | std::ios::trunc);
+        out << "// " << i << "\n";
+        for (int line = 0; line < 20000; line++) {
+            out << "function f" << line << "(a, b) { return [a, b].map(function (x) { return x * " << line << "; }); }\n";
+        }
+        paths.push_back(path);
+    }
+    v8::Isolate::CreateParams create_params;
+    create_params.array_buffer_allocator = v8::ArrayBuffer::Allocator::NewDefaultAllocator();
+    v8::Isolate *isolate = v8::Isolate::New(create_params);
+    {
+        v8::Isolate::Scope scope(isolate);
+        v8::HandleScope handleScope(isolate);
+        v8::Local<v8::Context> context = v8::Context::New(isolate);
+        v8::Context::Scope contextScope(context);
+        size_t index = 0;
+        benchmark.measure("read_then_compile", iterations, [&]() -> void {
+            v8::HandleScope handleScope(isolate);
+            std::unique_ptr<MappedFile> file = MappedFile::Open(paths[index++]);
+            std::string source(file->data(), file->size());
+            v8::Local<v8::String> code = v8::String::NewFromUtf8(isolate, source.data(), v8::NewStringType::kNormal, static_cast<int>(source.size())).ToLocalChecked();
+            v8::Script::Compile(context, code).ToLocalChecked();
+        });
+        benchmark.measure("streamed", iterations, [&]() -> void {
+            v8::HandleScope handleScope(isolate);
+            ScriptStreamer::Compile(context, paths[index++]).ToLocalChecked();
+        });
+    }
+    isolate->Dispose();
+    delete create_params.array_buffer_allocator;
+    for (const std::string &path : paths) {
+        std::remove(path.c_str());
+    }
+}
@@ -0,0 +1,83 @@
+//
+// Created by user on 2026/10/17.
+//
+// 对比逐行读取和内存映射加载源码的开销
+
+#include "../test/base/sourceFile.h"
+#include "benchmark.h"
+#include <cstdio>
+#include <fstream>
+
+/**
+ * 原来 Environment::ReadFile 的实现：逐行读取到 256 字节的缓冲区
+ * @param path
+ * @return
+ */
+static std::string legacyReadFile(const std::string &path) {
+    std::ifstream in(path.c_str());
+    if (!in.is_open()) {
+        return "";
+    }
+    std::string source;
+    char buffer[256];
+    while (!in.eof()) {
+        in.getline(buffer, 256);
+        source.append(buffer);
+    }
+    return source;
+}
+
+/**
+ * 生成指定大小的脚本文件
+ * @param path
+ * @param size
+ * @param line
+ */
+static void generateFile(const std::string &path, size_t size, const std::string &line) {
+    std::ofstream out(path.c_str(), std::ios::binary | std::ios::trunc);
+    for (size_t written = 0; written < size; written += line.size()) {
+        out << line;
+    }
+}
+
+static void benchmarkLoad(Benchmark &benchmark, const std::string &prefix, const std::string &line) {
+    v8::Isolate::CreateParams create_params;
+    create_params.array_buffer_allocator = v8::ArrayBuffer::Allocator::NewDefaultAllocator();
+    v8::Isolate *isolate = v8::Isolate::New(create_params);
+    {
+        v8::Isolate::Scope scope(isolate);
+        for (size_t megabytes : {1, 8, 32}) {
+            std::string path = prefix + std::to_string(megabytes) + "mb.js";
+            generateFile(path, megabytes * 1024 * 1024, line);
+            std::string suffix = "/" + std::to_string(megabytes) + "MB";
+            size_t iterations = 256 / megabytes;
+            benchmark.measure("legacy_getline" + suffix, iterations, [&]() -> void {
+                v8::HandleScope handleScope(isolate);
+                std::string source = legacyReadFile(path);
+                v8::String::NewFromUtf8(isolate, source.data(), v8::NewStringType::kNormal, static_cast<int>(source.size())).ToLocalChecked();
+            });
+            benchmark.measure("mmap_copy" + suffix, iterations, [&]() -> void {
+                v8::HandleScope handleScope(isolate);
+                std::unique_ptr<MappedFile> file = MappedFile::Open(path);
+                v8::String::NewFromUtf8(isolate, file->data(), v8::NewStringType::kNormal, static_cast<int>(file->size())).ToLocalChecked();
+            });
+            benchmark.measure("mmap_external" + suffix, iterations, [&]() -> void {
+                v8::HandleScope handleScope(isolate);
+                SourceFile::Load(isolate, path).ToLocalChecked();
+            });
+            // 释放外部字符串，避免映射累积
+            isolate->LowMemoryNotification();
+            std::remove(path.c_str());
+        }
+    }
+    isolate->Dispose();
+    delete create_params.array_buffer_allocator;
+}
+
+BENCHMARK(source_file_load_ascii) {
+    benchmarkLoad(benchmark, "benchmark_ascii_", "var value = [1, 2, 3].map(function (item) { return item * 2; });\n");
+}
+
+BENCHMARK(source_file_load_utf8) {
+    benchmarkLoad(benchmark, "benchmark_utf8_", "var value = '中文字符串'; // 注释\n");
+}
@@ -1,18 +1,74 @@
 #include "gtest/gtest.h"
 #include "v8.h"
 #include "libplatform/libplatform.h"
+#include "test/base/cpuTopology.h"
+#include "test/base/embedderPlatform.h"
+#include "test/base/environment.h"
+#include "test/base/isolatePool.h"
+#include "test/base/lockerProfiler.h"
+#include "test/base/snapshot.h"
+#include <cstdlib>
 
 v8::Platform* g_default_platform = nullptr;
 
 GTEST_API_ int main(int argc, char** argv){
   v8::V8::InitializeICUDefaultLocation(argv[0]);
   v8::V8::InitializeExternalStartupData(argv[0]);
-  std::unique_ptr<v8::Platform> platform = v8::platform::NewDefaultPlatform();
-  g_default_platform = platform.get();
-  v8::V8::InitializePlatform(g_default_platform);
+  // 后台线程数量和绑定的 cpu 通过环境变量 V8_LEARN_PLATFORM_THREADS 和 V8_LEARN_PLATFORM_CPUS（如 "0-3,6"）配置
+  EmbedderPlatform::Options platformOptions;
+  const char* threadsEnv = std::getenv("V8_LEARN_PLATFORM_THREADS");
+  if (threadsEnv != nullptr) {
+    platformOptions.threadCount = std::atoi(threadsEnv);
+  }
+  const char* cpusEnv = std::getenv("V8_LEARN_PLATFORM_CPUS");
+  if (cpusEnv != nullptr) {
+    platformOptions.cpus = EmbedderPlatform::ParseCpuList(cpusEnv);
+  }
+  // 设置环境变量 V8_LEARN_ISOLATE_POOL_NODE 时，隔离实例池的后台线程固定在该 NUMA 节点上，池中隔离实例的堆也分配在该节点上
+  const char* poolNodeEnv = std::getenv("V8_LEARN_ISOLATE_POOL_NODE");
+  ThreadPlacement poolPlacement;
+  if (poolNodeEnv != nullptr) {
+    poolPlacement.numaNode = std::atoi(poolNodeEnv);
+    platformOptions.numaPageAllocator = true;
+  }
+  // 设置环境变量 V8_LEARN_TOPOLOGY 时，启动时输出 cpu 和 NUMA 节点拓扑
+  if (std::getenv("V8_LEARN_TOPOLOGY") != nullptr) {
+    CpuTopology::Get().report(stdout);
+  }
+  std::unique_ptr<EmbedderPlatform> platform = std::make_unique<EmbedderPlatform>(platformOptions);
+  // 执行前台任务需要使用 v8 默认平台
+  g_default_platform = platform->getDefaultPlatform();
+  v8::V8::InitializePlatform(platform.get());
   v8::V8::Initialize();
+  // 从构建步骤生成的快照启动，快照不存在时使用 v8 内置的快照
+  std::string executableDir = Environment::DirName(Environment::NormalizePath(argv[0], Environment::GetWorkingDirectory()));
+  Snapshot::Load(executableDir + "/" + Snapshot::kFileName);
+  // 隔离实例池的大小，通过环境变量 V8_LEARN_ISOLATE_POOL_SIZE 配置，0 表示不使用池
+  const char* poolSizeEnv = std::getenv("V8_LEARN_ISOLATE_POOL_SIZE");
+  size_t poolSize = poolSizeEnv != nullptr ? std::strtoul(poolSizeEnv, nullptr, 10) : 2;
+  std::unique_ptr<IsolatePool> isolatePool;
+  if (poolSize > 0) {
+    isolatePool = std::make_unique<IsolatePool>(poolSize, poolPlacement);
+    Environment::SetIsolatePool(isolatePool.get());
+  }
+  // 设置环境变量 V8_LEARN_HEAP_TELEMETRY 为文件路径时，每个测试结束后追加一行堆和 GC 统计
+  const char* heapTelemetryEnv = std::getenv("V8_LEARN_HEAP_TELEMETRY");
+  FILE* heapTelemetryOutput = heapTelemetryEnv != nullptr ? fopen(heapTelemetryEnv, "a") : nullptr;
+  Environment::SetHeapTelemetryOutput(heapTelemetryOutput);
+  // 设置环境变量 V8_LEARN_LOCKER_PROFILE 为文件路径时，统计 PROFILED_LOCKER 的等待和持有时间，退出时每个隔离实例追加一行
+  const char* lockerProfileEnv = std::getenv("V8_LEARN_LOCKER_PROFILE");
+  if (lockerProfileEnv != nullptr) {
+    LockerProfiler::SetEnabled(true);
+    LockerProfiler::DumpAtExit(lockerProfileEnv);
+  }
   testing::InitGoogleTest(&argc, argv);
   int result = RUN_ALL_TESTS();
+  Environment::SetHeapTelemetryOutput(nullptr);
+  if (heapTelemetryOutput != nullptr) {
+    fclose(heapTelemetryOutput);
+  }
+  Environment::SetIsolatePool(nullptr);
+  isolatePool.reset();
   v8::V8::Dispose();
   v8::V8::ShutdownPlatform();
   return result;
@@ -0,0 +1,58 @@
+#include "./base/arrayBufferAllocator.h"
+#include "./base/environment.h"
+
+TEST(array_buffer_allocator_test, small_size_class) {
+    PooledArrayBufferAllocator allocator;
+    auto *data = static_cast<uint8_t *>(allocator.Allocate(100));
+    ASSERT_TRUE(data != nullptr);
+    EXPECT_EQ(data[99], 0);
+    data[0] = 1;
+    EXPECT_EQ(allocator.getLiveBytes(), 100);
+    allocator.Free(data, 100);
+    EXPECT_EQ(allocator.getLiveBytes(), 0);
+    // 同一分级的分配复用刚释放的内存，并且重新清零
+    auto *reused = static_cast<uint8_t *>(allocator.Allocate(120));
+    EXPECT_TRUE(reused == data);
+    EXPECT_EQ(reused[0], 0);
+    EXPECT_EQ(allocator.getReuseCount(), 1);
+    EXPECT_EQ(allocator.getPeakBytes(), 120);
+    allocator.Free(reused, 120);
+    // 重置后峰值从当前存活的字节数开始
+    allocator.resetPeakBytes();
+    EXPECT_EQ(allocator.getPeakBytes(), 0);
+    data = static_cast<uint8_t *>(allocator.Allocate(16));
+    EXPECT_EQ(allocator.getPeakBytes(), 16);
+    allocator.Free(data, 16);
+}
+
+TEST(array_buffer_allocator_test, large_block) {
+    PooledArrayBufferAllocator allocator;
+    size_t length = 1024 * 1024 + 1;
+    auto *data = static_cast<uint8_t *>(allocator.Allocate(length));
+    ASSERT_TRUE(data != nullptr);
+    data[length - 1] = 1;
+    allocator.Free(data, length);
+    // 页对齐后大小相同的分配复用缓存的映射
+    auto *reused = static_cast<uint8_t *>(allocator.Allocate(length + 10));
+    EXPECT_TRUE(reused == data);
+    EXPECT_EQ(reused[length - 1], 0);
+    allocator.Free(reused, length + 10);
+    EXPECT_EQ(allocator.getLiveBytes(), 0);
+    EXPECT_EQ(allocator.getPeakBytes(), length + 10);
+    EXPECT_EQ(allocator.getAllocationCount(), 2);
+}
+
+TEST_F(Environment, array_buffer_allocator_accounting) {
+    v8::Isolate *isolate = getIsolate();
+    PooledArrayBufferAllocator *allocator = getArrayBufferAllocator();
+    ASSERT_TRUE(allocator != nullptr);
+    size_t before = allocator->getLiveBytes();
+    v8::HandleScope handleScope(isolate);
+    v8::Local<v8::Context> context = v8::Context::New(isolate);
+    v8::Context::Scope context_scope(context);
+    v8::Local<v8::Value> result = v8::Script::Compile(context, v8::String::NewFromUtf8Literal(isolate, "const buffer = new Uint8Array(4096); buffer[4095] = 1; buffer.length;")).ToLocalChecked()->Run(context).ToLocalChecked();
+    EXPECT_EQ(result.As<v8::Number>()->Value(), 4096);
+    // 每个隔离实例的分配器只统计自己的内存
+    EXPECT_GE(allocator->getLiveBytes(), before + 4096);
+    EXPECT_GE(allocator->getPeakBytes(), before + 4096);
+}
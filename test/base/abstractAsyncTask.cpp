@@ -1,29 +1,44 @@
 //
 // Created by CF on 2021/7/26.
 //
-#if defined(LINUX)
-#include "./platform/linuxThreadDelegate.h"
-#elif defined(WIN)
-#include "./platform/winThreadDelegate.h"
-#endif
 #include "./abstractAsyncTask.h"
-#include <functional>
+#include <cstdio>
+#include <cstdlib>
 
-AbstractAsyncTask::AbstractAsyncTask() {
-#if defined(LINUX)
-    this->delegate = new LinuxThreadDelegate(this);
-#elif defined(WIN)
-    this->delegate = new WinThreadDelegate(this);
-#endif
+AbstractAsyncTask::AbstractAsyncTask(ThreadPool *threadPool) : state(std::make_shared<State>()) {
+    this->threadPool = threadPool == nullptr ? ThreadPool::GetDefault() : threadPool;
 }
 
 AbstractAsyncTask::~AbstractAsyncTask() {
-    delete this->delegate;
+    std::lock_guard<std::mutex> lock(this->state->mutex);
+    // 启动后没有 join 就销毁，工作线程可能还在访问任务对象，所有构建类型都不能继续执行
+    if (this->state->started && !this->state->joined) {
+        fprintf(stderr, "AbstractAsyncTask destroyed without join\n");
+        std::abort();
+    }
 }
 void AbstractAsyncTask::join() {
-    this->delegate->joinThread();
+    std::unique_lock<std::mutex> lock(this->state->mutex);
+    State *state = this->state.get();
+    state->condition.wait(lock, [state]() -> bool {
+        return !state->started || state->finished;
+    });
+    state->joined = true;
 }
 
 void AbstractAsyncTask::start() {
-    this->delegate->createThread();
+    {
+        std::lock_guard<std::mutex> lock(this->state->mutex);
+        this->state->started = true;
+        this->state->finished = false;
+        this->state->joined = false;
+    }
+    std::shared_ptr<State> state = this->state;
+    this->threadPool->submit([this, state]() -> void {
+        this->run();
+        std::lock_guard<std::mutex> lock(state->mutex);
+        state->finished = true;
+        // join 返回后任务对象可能立即被销毁，之后只访问共享的状态
+        state->condition.notify_all();
+    });
 }
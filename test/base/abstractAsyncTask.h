@@ -4,24 +4,43 @@
 
 #ifndef V8_LEARN_ABSTRACT_ASYNC_TASK_H
 #define V8_LEARN_ABSTRACT_ASYNC_TASK_H
+#include "./threadPool.h"
+#include <condition_variable>
+#include <memory>
+#include <mutex>
  class AbstractAsyncTask{
-     using threadFun = void (*)();
  public:
-     AbstractAsyncTask();
-     ~AbstractAsyncTask();
+     /**
+      * @param threadPool 执行任务的线程池，为空时使用默认线程池。需要在某个 NUMA 节点上执行时使用 ThreadPool::GetNodePool
+      */
+     explicit AbstractAsyncTask(ThreadPool *threadPool = nullptr);
+     /**
+      * 已经启动的任务必须在析构之前调用 join 等待执行完成，否则直接终止进程。
+      * 基类析构时派生类已经销毁，这时再等待，工作线程上的 run 访问的是已经销毁的对象，所以这里不等待，只检查
+      */
+     virtual ~AbstractAsyncTask();
      virtual void run() = 0;
+     /**
+      * 等待任务执行完成
+      */
      void join();
+     /**
+      * 把任务提交到线程池
+      */
      void start();
-     class Delegate{
-     protected:
-         AbstractAsyncTask* abstractAsyncTask = nullptr;
-     public:
-         explicit Delegate(AbstractAsyncTask* abstractAsyncTask):abstractAsyncTask(abstractAsyncTask){};
-         virtual void createThread() = 0;
-         virtual void joinThread() = 0;
-         virtual ~Delegate() = default;;
-     };
  private:
-     Delegate* delegate;
+     /**
+      * 完成状态，提交到线程池的函数持有一份，run 返回后只访问这里，不再访问任务对象
+      */
+     struct State {
+         std::mutex mutex;
+         std::condition_variable condition;
+         bool started = false;
+         bool finished = false;
+         // 最后一次启动之后是否调用过 join
+         bool joined = false;
+     };
+     ThreadPool* threadPool;
+     std::shared_ptr<State> state;
  };
 #endif// V8_LEARN_ABSTRACT_ASYNC_TASK_H
@@ -0,0 +1,183 @@
+//
+// Created by user on 2026/10/17.
+//
+
+#include "arrayBufferAllocator.h"
+#include <cstdlib>
+#include <cstring>
+
+#if defined(LINUX)
+#include <sys/mman.h>
+#include <unistd.h>
+#elif defined(WIN)
+#include <windows.h>
+#endif
+
+const size_t PooledArrayBufferAllocator::kMinSmallSize;
+const size_t PooledArrayBufferAllocator::kMaxSmallSize;
+const size_t PooledArrayBufferAllocator::kMaxCachedSmallBytes;
+const size_t PooledArrayBufferAllocator::kMaxCachedLargeBytes;
+const size_t PooledArrayBufferAllocator::kSizeClassCount;
+
+PooledArrayBufferAllocator::PooledArrayBufferAllocator(bool skipZeroFill) : _skip_zero_fill(skipZeroFill) {}
+
+PooledArrayBufferAllocator::~PooledArrayBufferAllocator() {
+    for (SizeClass &sizeClass : _size_classes) {
+        while (sizeClass.head != nullptr) {
+            FreeBlock *block = sizeClass.head;
+            sizeClass.head = block->next;
+            free(block);
+        }
+    }
+    for (auto &entry : _large_blocks) {
+        UnmapPages(entry.second, entry.first);
+    }
+}
+
+void *PooledArrayBufferAllocator::Allocate(size_t length) {
+    return allocate(length, true);
+}
+
+void *PooledArrayBufferAllocator::AllocateUninitialized(size_t length) {
+    return allocate(length, !_skip_zero_fill);
+}
+
+void *PooledArrayBufferAllocator::allocate(size_t length, bool zeroFill) {
+    if (length <= kMaxSmallSize) {
+        size_t index = SizeClassIndex(length);
+        size_t blockSize = kMinSmallSize << index;
+        SizeClass &sizeClass = _size_classes[index];
+        FreeBlock *block = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(sizeClass.mutex);
+            if (sizeClass.head != nullptr) {
+                block = sizeClass.head;
+                sizeClass.head = block->next;
+                sizeClass.cachedBytes -= blockSize;
+            }
+        }
+        if (block != nullptr) {
+            _reuse_count++;
+            // 复用的内存包含上一次的数据
+            if (zeroFill) {
+                memset(block, 0, length);
+            }
+        } else {
+            block = static_cast<FreeBlock *>(zeroFill ? calloc(1, blockSize) : malloc(blockSize));
+            if (block == nullptr) {
+                return nullptr;
+            }
+        }
+        recordAllocation(length);
+        return block;
+    }
+
+    size_t mappedSize = PageRoundUp(length);
+    void *address = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(_large_mutex);
+        auto it = _large_blocks.find(mappedSize);
+        if (it != _large_blocks.end()) {
+            address = it->second;
+            _large_blocks.erase(it);
+            _cached_large_bytes -= mappedSize;
+        }
+    }
+    if (address != nullptr) {
+        _reuse_count++;
+        if (zeroFill) {
+            memset(address, 0, length);
+        }
+    } else {
+        // 新映射的页由系统清零
+        address = MapPages(mappedSize);
+        if (address == nullptr) {
+            return nullptr;
+        }
+    }
+    recordAllocation(length);
+    return address;
+}
+
+void PooledArrayBufferAllocator::Free(void *data, size_t length) {
+    if (data == nullptr) {
+        return;
+    }
+    _live_bytes -= length;
+    if (length <= kMaxSmallSize) {
+        size_t index = SizeClassIndex(length);
+        size_t blockSize = kMinSmallSize << index;
+        SizeClass &sizeClass = _size_classes[index];
+        auto *block = static_cast<FreeBlock *>(data);
+        {
+            std::lock_guard<std::mutex> lock(sizeClass.mutex);
+            if (sizeClass.cachedBytes + blockSize <= kMaxCachedSmallBytes) {
+                block->next = sizeClass.head;
+                sizeClass.head = block;
+                sizeClass.cachedBytes += blockSize;
+                return;
+            }
+        }
+        free(block);
+        return;
+    }
+
+    size_t mappedSize = PageRoundUp(length);
+    {
+        std::lock_guard<std::mutex> lock(_large_mutex);
+        if (_cached_large_bytes + mappedSize <= kMaxCachedLargeBytes) {
+            _large_blocks.emplace(mappedSize, data);
+            _cached_large_bytes += mappedSize;
+            return;
+        }
+    }
+    UnmapPages(data, mappedSize);
+}
+
+size_t PooledArrayBufferAllocator::SizeClassIndex(size_t length) {
+    size_t index = 0;
+    size_t blockSize = kMinSmallSize;
+    while (blockSize < length) {
+        blockSize <<= 1;
+        index++;
+    }
+    return index;
+}
+
+size_t PooledArrayBufferAllocator::PageRoundUp(size_t length) {
+#if defined(LINUX)
+    static const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#else
+    static const size_t pageSize = 4096;
+#endif
+    return (length + pageSize - 1) & ~(pageSize - 1);
+}
+
+void *PooledArrayBufferAllocator::MapPages(size_t length) {
+#if defined(LINUX)
+    void *address = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    return address == MAP_FAILED ? nullptr : address;
+#elif defined(WIN)
+    return VirtualAlloc(nullptr, length, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+#else
+    return calloc(1, length);
+#endif
+}
+
+void PooledArrayBufferAllocator::UnmapPages(void *address, size_t length) {
+#if defined(LINUX)
+    munmap(address, length);
+#elif defined(WIN)
+    VirtualFree(address, 0, MEM_RELEASE);
+#else
+    free(address);
+#endif
+}
+
+void PooledArrayBufferAllocator::recordAllocation(size_t length) {
+    _allocation_count++;
+    size_t live = _live_bytes += length;
+    size_t peak = _peak_bytes.load();
+    while (live > peak && !_peak_bytes.compare_exchange_weak(peak, live)) {
+    }
+}
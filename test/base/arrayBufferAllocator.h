@@ -0,0 +1,80 @@
+//
+// Created by user on 2026/10/17.
+//
+
+#ifndef V8_LEARN_ARRAY_BUFFER_ALLOCATOR_H
+#define V8_LEARN_ARRAY_BUFFER_ALLOCATOR_H
+#include "v8.h"
+#include <atomic>
+#include <map>
+#include <mutex>
+
+/**
+ * 带缓存的 ArrayBuffer 分配器，每个隔离实例使用一个，统计该隔离实例的内存占用。
+ * 小块内存按 2 的幂分级，释放后放入对应级别的空闲链表；
+ * 大块内存直接向系统映射页，释放后按页对齐后的大小缓存，下次同样大小的分配直接复用。
+ */
+class PooledArrayBufferAllocator : public v8::ArrayBuffer::Allocator {
+public:
+    // 最小的分级大小
+    static const size_t kMinSmallSize = 16;
+    // 超过该大小的分配走页映射
+    static const size_t kMaxSmallSize = 64 * 1024;
+    // 每个分级空闲链表最多缓存的字节数
+    static const size_t kMaxCachedSmallBytes = 1024 * 1024;
+    // 缓存的大块内存最多占用的字节数
+    static const size_t kMaxCachedLargeBytes = 64 * 1024 * 1024;
+
+    /**
+     * @param skipZeroFill 为 true 时 AllocateUninitialized 不清零复用的内存
+     */
+    explicit PooledArrayBufferAllocator(bool skipZeroFill = true);
+    ~PooledArrayBufferAllocator() override;
+
+    void *Allocate(size_t length) override;
+    void *AllocateUninitialized(size_t length) override;
+    void Free(void *data, size_t length) override;
+
+    // 当前存活的字节数，按 v8 请求的长度统计
+    size_t getLiveBytes() const { return _live_bytes.load(); }
+    // 存活字节数的峰值
+    size_t getPeakBytes() const { return _peak_bytes.load(); }
+    /**
+     * 把峰值重置为当前存活的字节数，隔离实例复用时从这里开始重新统计
+     */
+    void resetPeakBytes() { _peak_bytes.store(_live_bytes.load()); }
+    uint64_t getAllocationCount() const { return _allocation_count.load(); }
+    // 从缓存中复用的次数
+    uint64_t getReuseCount() const { return _reuse_count.load(); }
+
+private:
+    static const size_t kSizeClassCount = 13;
+    struct FreeBlock {
+        FreeBlock *next;
+    };
+    struct SizeClass {
+        std::mutex mutex;
+        FreeBlock *head = nullptr;
+        size_t cachedBytes = 0;
+    };
+
+    void *allocate(size_t length, bool zeroFill);
+    static size_t SizeClassIndex(size_t length);
+    static size_t PageRoundUp(size_t length);
+    static void *MapPages(size_t length);
+    static void UnmapPages(void *address, size_t length);
+    void recordAllocation(size_t length);
+
+    const bool _skip_zero_fill;
+    SizeClass _size_classes[kSizeClassCount];
+    std::mutex _large_mutex;
+    // 页对齐后的大小 -> 缓存的大块内存
+    std::multimap<size_t, void *> _large_blocks;
+    size_t _cached_large_bytes = 0;
+    std::atomic<size_t> _live_bytes{0};
+    std::atomic<size_t> _peak_bytes{0};
+    std::atomic<uint64_t> _allocation_count{0};
+    std::atomic<uint64_t> _reuse_count{0};
+};
+
+#endif//V8_LEARN_ARRAY_BUFFER_ALLOCATOR_H
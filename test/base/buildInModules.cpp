@@ -0,0 +1,85 @@
+//
+// Created by user on 2026/10/17.
+//
+// 内建模块的导出模板和注册函数，模块列表见 BUILD_IN_MODULE_LIST
+
+#include "nodeBuildInModule.h"
+
+/**
+ * 加法函数
+ * @param info
+ */
+static void add(const v8::FunctionCallbackInfo<v8::Value> &info) {
+    double first = info[0].As<v8::Number>()->Value();
+    double second = info[1].As<v8::Number>()->Value();
+    info.GetReturnValue().Set(first + second);
+}
+
+/**
+ * 乘法函数
+ * @param info
+ */
+static void mul(const v8::FunctionCallbackInfo<v8::Value> &info) {
+    double first = info[0].As<v8::Number>()->Value();
+    double second = info[1].As<v8::Number>()->Value();
+    info.GetReturnValue().Set(first * second);
+}
+
+/**
+ * 工具模块的导出
+ * @param isolate
+ * @param exports
+ */
+void fooBuildInModuleTemplate(v8::Isolate *isolate, v8::Local<v8::ObjectTemplate> exports) {
+    // 导出加法函数
+    setLazyMethod(isolate, exports, "add", add);
+    exports->Set(isolate, "result", v8::Number::New(isolate, 1));
+}
+
+/**
+ * 工具模块
+ * @param context
+ * @param module
+ * @param exports
+ * @param require
+ */
+void fooBuildInModule(v8::Local<v8::Context> context,
+                      v8::Local<v8::Object> module,
+                      v8::Local<v8::Object> exports,
+                      v8::Local<v8::Function> require) {
+}
+
+/**
+ * 内建bar模块的导出
+ * @param isolate
+ * @param exports
+ */
+void barBuildInModuleTemplate(v8::Isolate *isolate, v8::Local<v8::ObjectTemplate> exports) {
+    // 乘法函数
+    setLazyMethod(isolate, exports, "mul", mul);
+}
+
+/**
+ * 内建bar模块
+ * @param context
+ * @param module
+ * @param exports
+ * @param require
+ */
+void barBuildInModule(v8::Local<v8::Context> context,
+                      v8::Local<v8::Object> module,
+                      v8::Local<v8::Object> exports,
+                      v8::Local<v8::Function> require) {
+    v8::Isolate *isolate = context->GetIsolate();
+    v8::HandleScope handleScope(isolate);
+    v8::Local<v8::Value> argv[] = {v8::String::NewFromUtf8Literal(isolate, "foo")};
+    // 调用foo模块
+    v8::Local<v8::Value> fooModule;
+    if (!require->Call(context, context->Global(), 1, argv).ToLocal(&fooModule) || !fooModule->IsObject()) {
+        return;
+    }
+    // 把模块foo模块的属性值result设置到bar的属性params上
+    exports->Set(context, v8::String::NewFromUtf8Literal(isolate, "params"),
+                 fooModule.As<v8::Object>()->Get(context, v8::String::NewFromUtf8Literal(isolate, "result")).ToLocalChecked())
+            .Check();
+}
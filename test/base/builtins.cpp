@@ -0,0 +1,61 @@
+//
+// Created by user on 2026/10/17.
+//
+
+#include "builtins.h"
+#include "nodeBuildInModule.h"
+#include <iostream>
+
+v8::Local<v8::ObjectTemplate> Builtins::NewGlobalTemplate(v8::Isolate *isolate) {
+    v8::Local<v8::ObjectTemplate> objectTemplate = v8::ObjectTemplate::New(isolate);
+    objectTemplate->Set(isolate, "property", v8::Number::New(isolate, 1));
+    objectTemplate->Set(isolate, "fun", v8::FunctionTemplate::New(isolate, Fun));
+    return objectTemplate;
+}
+
+void Builtins::Install(v8::Local<v8::Context> context) {
+    v8::Isolate *isolate = context->GetIsolate();
+    v8::HandleScope handleScope(isolate);
+    v8::Local<v8::Object> global = context->Global();
+
+    // process.binding()
+    v8::Local<v8::Object> process = v8::Object::New(isolate);
+    process->Set(context, v8::String::NewFromUtf8Literal(isolate, "binding"),
+                 v8::FunctionTemplate::New(isolate, internalBinding)->GetFunction(context).ToLocalChecked())
+            .Check();
+    global->Set(context, v8::String::NewFromUtf8Literal(isolate, "process"), process).Check();
+
+    // console.log() 和 print()，与 LogExtension 的行为一致
+    v8::Local<v8::Function> log = v8::FunctionTemplate::New(isolate, Log)->GetFunction(context).ToLocalChecked();
+    v8::Local<v8::Object> console = v8::Object::New(isolate);
+    console->Set(context, v8::String::NewFromUtf8Literal(isolate, "log"), log).Check();
+    global->Set(context, v8::String::NewFromUtf8Literal(isolate, "console"), console).Check();
+    global->Set(context, v8::String::NewFromUtf8Literal(isolate, "print"), log).Check();
+}
+
+const intptr_t *Builtins::GetExternalReferences() {
+    static const intptr_t externalReferences[] = {
+            reinterpret_cast<intptr_t>(internalBinding),
+            reinterpret_cast<intptr_t>(Log),
+            reinterpret_cast<intptr_t>(Fun),
+            0};
+    return externalReferences;
+}
+
+void Builtins::Log(const v8::FunctionCallbackInfo<v8::Value> &info) {
+    v8::Isolate *isolate = info.GetIsolate();
+    v8::HandleScope handleScope(isolate);
+    v8::Local<v8::Context> context = isolate->GetCurrentContext();
+    if (info[0]->IsNull() || info[0]->IsFunction()) {
+        return;
+    }
+    if (info[0]->IsObject()) {
+        std::cout << *v8::String::Utf8Value(isolate, v8::JSON::Stringify(context, info[0]).ToLocalChecked()) << std::endl;
+    } else {
+        std::cout << *v8::String::Utf8Value(isolate, info[0]) << std::endl;
+    }
+}
+
+void Builtins::Fun(const v8::FunctionCallbackInfo<v8::Value> &info) {
+    info.GetReturnValue().Set(2);
+}
@@ -0,0 +1,38 @@
+//
+// Created by user on 2026/10/17.
+//
+
+#ifndef V8_LEARN_BUILTINS_H
+#define V8_LEARN_BUILTINS_H
+#include "v8.h"
+
+/**
+ * 上下文预置的全局对象：process.binding、console.log、print 以及全局模板上的 property 和 fun。
+ * 这些对象既可以在运行时安装，也可以被序列化进启动快照。
+ */
+class Builtins {
+public:
+    /**
+     * 创建带有 property 和 fun 的全局对象模板
+     * @param isolate
+     * @return
+     */
+    static v8::Local<v8::ObjectTemplate> NewGlobalTemplate(v8::Isolate *isolate);
+    /**
+     * 在上下文的全局对象上安装 process 和 console
+     * @param context
+     */
+    static void Install(v8::Local<v8::Context> context);
+    /**
+     * 内建对象引用的所有 c++ 函数地址，以 nullptr 结尾。
+     * 创建快照和从快照启动必须使用同一个数组。
+     * @return
+     */
+    static const intptr_t *GetExternalReferences();
+
+private:
+    static void Log(const v8::FunctionCallbackInfo<v8::Value> &info);
+    static void Fun(const v8::FunctionCallbackInfo<v8::Value> &info);
+};
+
+#endif//V8_LEARN_BUILTINS_H
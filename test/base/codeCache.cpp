@@ -0,0 +1,157 @@
+//
+// Created by user on 2026/10/17.
+//
+
+#include "codeCache.h"
+#include <cstdio>
+#include <fstream>
+#include <memory>
+
+#if defined(WIN)
+#include <direct.h>
+#elif defined(LINUX)
+#include <sys/stat.h>
+#endif
+
+CodeCache::CodeCache(std::string directory) : _directory(std::move(directory)) {
+#if defined(WIN)
+    _mkdir(_directory.c_str());
+#elif defined(LINUX)
+    mkdir(_directory.c_str(), 0755);
+#endif
+}
+
+v8::MaybeLocal<v8::Script> CodeCache::compileScript(v8::Local<v8::Context> context, v8::Local<v8::String> source, const v8::ScriptOrigin &origin) {
+    v8::Isolate *isolate = context->GetIsolate();
+    v8::EscapableHandleScope handleScope(isolate);
+    std::string path = getCachePath(isolate, source, false);
+    v8::Local<v8::Script> script;
+    v8::ScriptCompiler::CachedData *cachedData = ReadCache(path);
+    if (cachedData != nullptr) {
+        // Source 接管 cachedData 的所有权
+        v8::ScriptCompiler::Source scriptSource(source, origin, cachedData);
+        if (!v8::ScriptCompiler::Compile(context, &scriptSource, v8::ScriptCompiler::kConsumeCodeCache).ToLocal(&script)) {
+            return v8::MaybeLocal<v8::Script>();
+        }
+        if (!scriptSource.GetCachedData()->rejected) {
+            _hit_count++;
+            return handleScope.Escape(script);
+        }
+        // 缓存被拒绝时 v8 已经从源码重新编译，用新的结果覆盖旧缓存
+        _reject_count++;
+    } else {
+        _miss_count++;
+        v8::ScriptCompiler::Source scriptSource(source, origin);
+        if (!v8::ScriptCompiler::Compile(context, &scriptSource).ToLocal(&script)) {
+            return v8::MaybeLocal<v8::Script>();
+        }
+    }
+    std::unique_ptr<v8::ScriptCompiler::CachedData> created(v8::ScriptCompiler::CreateCodeCache(script->GetUnboundScript()));
+    WriteCache(path, created.get());
+    return handleScope.Escape(script);
+}
+
+v8::MaybeLocal<v8::Module> CodeCache::compileModule(v8::Isolate *isolate, v8::Local<v8::String> source, const v8::ScriptOrigin &origin) {
+    v8::EscapableHandleScope handleScope(isolate);
+    std::string path = getCachePath(isolate, source, true);
+    v8::Local<v8::Module> module;
+    v8::ScriptCompiler::CachedData *cachedData = ReadCache(path);
+    if (cachedData != nullptr) {
+        v8::ScriptCompiler::Source moduleSource(source, origin, cachedData);
+        if (!v8::ScriptCompiler::CompileModule(isolate, &moduleSource, v8::ScriptCompiler::kConsumeCodeCache).ToLocal(&module)) {
+            return v8::MaybeLocal<v8::Module>();
+        }
+        if (!moduleSource.GetCachedData()->rejected) {
+            _hit_count++;
+            return handleScope.Escape(module);
+        }
+        _reject_count++;
+    } else {
+        _miss_count++;
+        v8::ScriptCompiler::Source moduleSource(source, origin);
+        if (!v8::ScriptCompiler::CompileModule(isolate, &moduleSource).ToLocal(&module)) {
+            return v8::MaybeLocal<v8::Module>();
+        }
+    }
+    std::unique_ptr<v8::ScriptCompiler::CachedData> created(v8::ScriptCompiler::CreateCodeCache(module->GetUnboundModuleScript()));
+    WriteCache(path, created.get());
+    return handleScope.Escape(module);
+}
+
+void CodeCache::updateScript(v8::Local<v8::Script> script, v8::Local<v8::String> source) {
+    v8::Isolate *isolate = v8::Isolate::GetCurrent();
+    std::unique_ptr<v8::ScriptCompiler::CachedData> created(v8::ScriptCompiler::CreateCodeCache(script->GetUnboundScript()));
+    WriteCache(getCachePath(isolate, source, false), created.get());
+}
+
+std::string CodeCache::getCachePath(v8::Isolate *isolate, v8::Local<v8::String> source, bool isModule) {
+    char name[64];
+    snprintf(name, sizeof(name), "%016llx-%08x-%s.cache",
+             static_cast<unsigned long long>(Hash(isolate, source)),
+             v8::ScriptCompiler::CachedDataVersionTag(),
+             isModule ? "module" : "script");
+    return _directory + "/" + name;
+}
+
+uint64_t CodeCache::Hash(v8::Isolate *isolate, v8::Local<v8::String> source) {
+    uint64_t hash = 14695981039346656037ULL;
+    auto mix = [&hash](uint16_t unit) -> void {
+        hash ^= unit & 0xFF;
+        hash *= 1099511628211ULL;
+        hash ^= unit >> 8;
+        hash *= 1099511628211ULL;
+    };
+    // 映射文件得到的外部字符串直接读取，不用再复制一次
+    if (source->IsExternalOneByte()) {
+        const v8::String::ExternalOneByteStringResource *resource = source->GetExternalOneByteStringResource();
+        const char *data = resource->data();
+        for (size_t i = 0; i < resource->length(); i++) {
+            mix(static_cast<unsigned char>(data[i]));
+        }
+        return hash;
+    }
+    v8::String::Value value(isolate, source);
+    for (int i = 0; i < value.length(); i++) {
+        mix((*value)[i]);
+    }
+    return hash;
+}
+
+v8::ScriptCompiler::CachedData *CodeCache::ReadCache(const std::string &path) {
+    std::ifstream in(path.c_str(), std::ios::binary | std::ios::ate);
+    if (!in.is_open()) {
+        return nullptr;
+    }
+    std::streamsize size = in.tellg();
+    if (size <= 0) {
+        return nullptr;
+    }
+    in.seekg(0);
+    auto *buffer = new uint8_t[size];
+    if (!in.read(reinterpret_cast<char *>(buffer), size)) {
+        delete[] buffer;
+        return nullptr;
+    }
+    return new v8::ScriptCompiler::CachedData(buffer, static_cast<int>(size), v8::ScriptCompiler::CachedData::BufferOwned);
+}
+
+void CodeCache::WriteCache(const std::string &path, const v8::ScriptCompiler::CachedData *cachedData) {
+    if (cachedData == nullptr) {
+        return;
+    }
+    std::string temp = path + ".tmp";
+    {
+        std::ofstream out(temp.c_str(), std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            return;
+        }
+        out.write(reinterpret_cast<const char *>(cachedData->data), cachedData->length);
+        if (!out.good()) {
+            return;
+        }
+    }
+#if defined(WIN)
+    std::remove(path.c_str());
+#endif
+    std::rename(temp.c_str(), path.c_str());
+}
@@ -0,0 +1,86 @@
+//
+// Created by user on 2026/10/17.
+//
+
+#ifndef V8_LEARN_CODE_CACHE_H
+#define V8_LEARN_CODE_CACHE_H
+#include "v8.h"
+#include <atomic>
+#include <string>
+
+/**
+ * 持久化到磁盘的代码缓存。
+ * 缓存文件以源码哈希、脚本类型和 ScriptCompiler::CachedDataVersionTag()（包含 v8 版本和影响代码生成的 flags）为键，
+ * 命中时通过 kConsumeCodeCache 跳过解析和编译；缓存被 v8 拒绝时正常编译并重新生成缓存。
+ */
+class CodeCache {
+public:
+    /**
+     * @param directory 缓存目录，不存在时自动创建
+     */
+    explicit CodeCache(std::string directory);
+
+    /**
+     * 编译经典脚本
+     * @param context
+     * @param source
+     * @param origin
+     * @return
+     */
+    v8::MaybeLocal<v8::Script> compileScript(v8::Local<v8::Context> context, v8::Local<v8::String> source, const v8::ScriptOrigin &origin);
+    /**
+     * 编译 es 模块
+     * @param isolate
+     * @param source
+     * @param origin
+     * @return
+     */
+    v8::MaybeLocal<v8::Module> compileModule(v8::Isolate *isolate, v8::Local<v8::String> source, const v8::ScriptOrigin &origin);
+    /**
+     * 脚本执行后重新生成缓存，缓存中会包含执行过程中懒编译的函数
+     * @param script
+     * @param source
+     */
+    void updateScript(v8::Local<v8::Script> script, v8::Local<v8::String> source);
+    /**
+     * 缓存文件路径
+     * @param isolate
+     * @param source
+     * @param isModule
+     * @return
+     */
+    std::string getCachePath(v8::Isolate *isolate, v8::Local<v8::String> source, bool isModule);
+
+    uint64_t getHitCount() const { return _hit_count.load(); }
+    uint64_t getMissCount() const { return _miss_count.load(); }
+    uint64_t getRejectCount() const { return _reject_count.load(); }
+
+    /**
+     * 计算字符串的 64 位 FNV-1a 哈希，按 UTF-16 码元计算，单字节和双字节字符串结果一致
+     * @param isolate
+     * @param source
+     * @return
+     */
+    static uint64_t Hash(v8::Isolate *isolate, v8::Local<v8::String> source);
+
+private:
+    /**
+     * 读取缓存文件，不存在时返回 nullptr。返回的 CachedData 拥有数据。
+     * @param path
+     * @return
+     */
+    static v8::ScriptCompiler::CachedData *ReadCache(const std::string &path);
+    /**
+     * 先写临时文件再重命名，避免其他进程读到写了一半的缓存
+     * @param path
+     * @param cachedData
+     */
+    static void WriteCache(const std::string &path, const v8::ScriptCompiler::CachedData *cachedData);
+
+    std::string _directory;
+    std::atomic<uint64_t> _hit_count{0};
+    std::atomic<uint64_t> _miss_count{0};
+    std::atomic<uint64_t> _reject_count{0};
+};
+
+#endif//V8_LEARN_CODE_CACHE_H
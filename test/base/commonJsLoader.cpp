@@ -0,0 +1,327 @@
+//
+// Created by user on 2026/10/17.
+//
+
+#include "commonJsLoader.h"
+#include "embedderData.h"
+#include "nodeBuildInModule.h"
+#include "sourceFile.h"
+
+namespace {
+    /**
+     * 相对路径或者绝对路径的说明符，其他的为包名或者内建模块名
+     * @param specifier
+     * @return
+     */
+    bool IsPathSpecifier(StringView specifier) {
+        return specifier == "." || specifier == ".." || specifier.startsWith("./") || specifier.startsWith("../") ||
+               FilePath::IsAbsolute(specifier);
+    }
+
+    /**
+     * 把两段拼接到缓冲区
+     * @param first
+     * @param second
+     * @param buffer
+     * @return 缓冲区不够时返回空视图
+     */
+    StringView Concat(StringView first, StringView second, char (&buffer)[FilePath::kMaxPath]) {
+        if (first.size() + second.size() >= FilePath::kMaxPath) {
+            return StringView();
+        }
+        memcpy(buffer, first.data(), first.size());
+        memcpy(buffer + first.size(), second.data(), second.size());
+        return StringView(buffer, first.size() + second.size());
+    }
+
+    v8::Local<v8::String> NewString(v8::Isolate *isolate, StringView value) {
+        return v8::String::NewFromUtf8(isolate, value.data(), v8::NewStringType::kNormal, static_cast<int>(value.size())).ToLocalChecked();
+    }
+}// namespace
+
+CommonJsLoader::CommonJsLoader(v8::Local<v8::Context> context, FileSystemCache *fileSystemCache)
+    : _isolate(context->GetIsolate()), _context(context->GetIsolate(), context), _file_system_cache(fileSystemCache) {
+    if (_file_system_cache == nullptr) {
+        _own_file_system_cache = std::make_unique<FileSystemCache>();
+        _file_system_cache = _own_file_system_cache.get();
+    }
+    v8::HandleScope handleScope(_isolate);
+    // 以路径为键，没有原型，模块路径不会和 Object.prototype 上的属性冲突
+    _cache.Reset(_isolate, v8::Object::New(_isolate, v8::Null(_isolate), nullptr, nullptr, 0));
+    ContextEmbedderData::SetPointer(context, ContextEmbedderIndex::kCommonJsLoader, this);
+}
+
+CommonJsLoader::~CommonJsLoader() {
+    v8::HandleScope handleScope(_isolate);
+    ContextEmbedderData::SetPointer(_context.Get(_isolate), ContextEmbedderIndex::kCommonJsLoader, nullptr);
+}
+
+CommonJsLoader *CommonJsLoader::FromContext(v8::Local<v8::Context> context) {
+    return static_cast<CommonJsLoader *>(ContextEmbedderData::GetPointer(context, ContextEmbedderIndex::kCommonJsLoader));
+}
+
+v8::Local<v8::Object> CommonJsLoader::getCache() {
+    return _cache.Get(_isolate);
+}
+
+v8::MaybeLocal<v8::Function> CommonJsLoader::createRequire(const std::string &filename) {
+    v8::EscapableHandleScope handleScope(_isolate);
+    v8::Local<v8::Context> context = _context.Get(_isolate);
+    // 函数的数据为模块所在的目录，require 时相对于该目录解析
+    v8::Local<v8::String> directory = NewString(_isolate, FilePath::DirName(filename));
+    v8::Local<v8::Function> require;
+    v8::Local<v8::Function> resolve;
+    if (!v8::Function::New(context, RequireCallback, directory).ToLocal(&require) ||
+        !v8::Function::New(context, ResolveCallback, directory).ToLocal(&resolve) ||
+        require->Set(context, v8::String::NewFromUtf8Literal(_isolate, "cache"), getCache()).IsNothing() ||
+        require->Set(context, v8::String::NewFromUtf8Literal(_isolate, "resolve"), resolve).IsNothing()) {
+        return v8::MaybeLocal<v8::Function>();
+    }
+    return handleScope.Escape(require);
+}
+
+v8::MaybeLocal<v8::Value> CommonJsLoader::require(StringView specifier, StringView directory) {
+    v8::EscapableHandleScope handleScope(_isolate);
+    v8::Local<v8::Context> context = _context.Get(_isolate);
+    // 内建模块优先
+    if (!IsPathSpecifier(specifier) && findBuildInNodeModule(specifier.data(), specifier.size()) != nullptr) {
+        v8::Local<v8::Function> binding;
+        v8::Local<v8::Value> name = NewString(_isolate, specifier);
+        v8::Local<v8::Value> exports;
+        if (!v8::Function::New(context, internalBinding).ToLocal(&binding) ||
+            !binding->Call(context, v8::Undefined(_isolate), 1, &name).ToLocal(&exports)) {
+            return v8::MaybeLocal<v8::Value>();
+        }
+        return handleScope.Escape(exports);
+    }
+    std::string filename;
+    if (!resolve(specifier, directory, &filename)) {
+        throwNotFound(specifier);
+        return v8::MaybeLocal<v8::Value>();
+    }
+    v8::Local<v8::Value> exports;
+    if (!load(filename).ToLocal(&exports)) {
+        return v8::MaybeLocal<v8::Value>();
+    }
+    return handleScope.Escape(exports);
+}
+
+bool CommonJsLoader::resolve(StringView specifier, StringView directory, std::string *filename) {
+    const std::string *cached = _file_system_cache->findResolved(directory, specifier);
+    if (cached != nullptr) {
+        *filename = *cached;
+        return true;
+    }
+    bool found = false;
+    char buffer[FilePath::kMaxPath];
+    if (IsPathSpecifier(specifier)) {
+        size_t length = FilePath::Normalize(specifier, directory, buffer, sizeof(buffer));
+        if (length != StringView::npos) {
+            StringView path(buffer, length);
+            found = loadAsFile(path, filename) || loadAsDirectory(path, filename);
+        }
+    } else {
+        // 从导入方所在目录逐级向上查找 node_modules
+        char modules[FilePath::kMaxPath];
+        StringView current = directory;
+        while (!found) {
+            if (!current.endsWith("/node_modules")) {
+                StringView modulesDirectory = Concat(current, "/node_modules", modules);
+                size_t length = modulesDirectory.empty() ? StringView::npos : FilePath::Normalize(specifier, modulesDirectory, buffer, sizeof(buffer));
+                if (length != StringView::npos && _file_system_cache->stat(modulesDirectory) == FileSystemCache::Kind::kDirectory) {
+                    StringView path(buffer, length);
+                    found = loadAsFile(path, filename) || loadAsDirectory(path, filename);
+                }
+            }
+            StringView parent = FilePath::DirName(current);
+            if (parent.size() >= current.size()) {
+                break;
+            }
+            current = parent;
+        }
+    }
+    if (found) {
+        _file_system_cache->setResolved(directory, specifier, *filename);
+    }
+    return found;
+}
+
+bool CommonJsLoader::loadAsFile(StringView path, std::string *filename) {
+    static const char *const kExtensions[] = {"", ".js", ".json"};
+    char buffer[FilePath::kMaxPath];
+    for (const char *extension : kExtensions) {
+        StringView candidate = Concat(path, extension, buffer);
+        if (!candidate.empty() && _file_system_cache->stat(candidate) == FileSystemCache::Kind::kFile) {
+            return _file_system_cache->realPath(candidate, filename);
+        }
+    }
+    return false;
+}
+
+bool CommonJsLoader::loadAsDirectory(StringView path, std::string *filename) {
+    if (_file_system_cache->stat(path) != FileSystemCache::Kind::kDirectory) {
+        return false;
+    }
+    char buffer[FilePath::kMaxPath];
+    char index[FilePath::kMaxPath];
+    const std::string &main = packageMain(path);
+    if (!main.empty()) {
+        size_t length = FilePath::Normalize(main, path, buffer, sizeof(buffer));
+        if (length != StringView::npos) {
+            StringView mainPath(buffer, length);
+            StringView mainIndex = Concat(mainPath, "/index", index);
+            if (loadAsFile(mainPath, filename) || (!mainIndex.empty() && loadAsFile(mainIndex, filename))) {
+                return true;
+            }
+        }
+    }
+    StringView pathIndex = Concat(path, "/index", index);
+    return !pathIndex.empty() && loadAsFile(pathIndex, filename);
+}
+
+const std::string &CommonJsLoader::packageMain(StringView path) {
+    const std::string *cached = _file_system_cache->findPackageMain(path);
+    if (cached != nullptr) {
+        return *cached;
+    }
+    std::string main;
+    char buffer[FilePath::kMaxPath];
+    StringView packageJson = Concat(path, "/package.json", buffer);
+    if (!packageJson.empty() && _file_system_cache->stat(packageJson) == FileSystemCache::Kind::kFile) {
+        v8::HandleScope handleScope(_isolate);
+        v8::Local<v8::Context> context = _context.Get(_isolate);
+        // package.json 格式错误时当作没有 main
+        v8::TryCatch tryCatch(_isolate);
+        v8::Local<v8::String> source;
+        v8::Local<v8::Value> json;
+        v8::Local<v8::Value> value;
+        if (SourceFile::Load(_isolate, packageJson.toString()).ToLocal(&source) &&
+            v8::JSON::Parse(context, source).ToLocal(&json) && json->IsObject() &&
+            json.As<v8::Object>()->Get(context, v8::String::NewFromUtf8Literal(_isolate, "main")).ToLocal(&value) &&
+            value->IsString()) {
+            v8::String::Utf8Value utf8(_isolate, value);
+            main.assign(*utf8, utf8.length());
+        }
+    }
+    return _file_system_cache->setPackageMain(path, main);
+}
+
+v8::MaybeLocal<v8::Value> CommonJsLoader::load(const std::string &filename) {
+    v8::EscapableHandleScope handleScope(_isolate);
+    v8::Local<v8::Context> context = _context.Get(_isolate);
+    v8::Local<v8::Object> cache = getCache();
+    v8::Local<v8::String> key = NewString(_isolate, filename);
+    v8::Local<v8::String> exportsKey = v8::String::NewFromUtf8Literal(_isolate, "exports");
+    v8::Local<v8::Value> cached;
+    if (!cache->Get(context, key).ToLocal(&cached)) {
+        return v8::MaybeLocal<v8::Value>();
+    }
+    if (cached->IsObject()) {
+        return handleScope.EscapeMaybe(cached.As<v8::Object>()->Get(context, exportsKey));
+    }
+    v8::Local<v8::Object> module = v8::Object::New(_isolate);
+    if (module->Set(context, v8::String::NewFromUtf8Literal(_isolate, "id"), key).IsNothing() ||
+        module->Set(context, v8::String::NewFromUtf8Literal(_isolate, "filename"), key).IsNothing() ||
+        module->Set(context, v8::String::NewFromUtf8Literal(_isolate, "loaded"), v8::False(_isolate)).IsNothing() ||
+        module->Set(context, exportsKey, v8::Object::New(_isolate)).IsNothing()) {
+        return v8::MaybeLocal<v8::Value>();
+    }
+    // 执行前放入缓存，模块之间循环依赖时返回未完成的 exports 而不是无限递归
+    if (cache->Set(context, key, module).IsNothing()) {
+        return v8::MaybeLocal<v8::Value>();
+    }
+    v8::TryCatch tryCatch(_isolate);
+    if (!evaluate(context, module, filename)) {
+        // 执行失败时移除缓存，下一次 require 重新加载
+        if (!tryCatch.HasTerminated()) {
+            cache->Delete(context, key).Check();
+            tryCatch.ReThrow();
+        }
+        return v8::MaybeLocal<v8::Value>();
+    }
+    if (module->Set(context, v8::String::NewFromUtf8Literal(_isolate, "loaded"), v8::True(_isolate)).IsNothing()) {
+        return v8::MaybeLocal<v8::Value>();
+    }
+    // 模块可能替换了 module.exports
+    return handleScope.EscapeMaybe(module->Get(context, exportsKey));
+}
+
+bool CommonJsLoader::evaluate(v8::Local<v8::Context> context, v8::Local<v8::Object> module, const std::string &filename) {
+    v8::Local<v8::String> source;
+    if (!SourceFile::Load(_isolate, filename).ToLocal(&source)) {
+        throwNotFound(filename);
+        return false;
+    }
+    v8::Local<v8::String> exportsKey = v8::String::NewFromUtf8Literal(_isolate, "exports");
+    if (StringView(filename).endsWith(".json")) {
+        v8::Local<v8::Value> json;
+        return v8::JSON::Parse(context, source).ToLocal(&json) && module->Set(context, exportsKey, json).FromMaybe(false);
+    }
+    v8::Local<v8::String> name = NewString(_isolate, filename);
+    v8::ScriptOrigin origin(_isolate, name);
+    v8::ScriptCompiler::Source compilerSource(source, origin);
+    v8::Local<v8::String> parameters[] = {
+            exportsKey,
+            v8::String::NewFromUtf8Literal(_isolate, "require"),
+            v8::String::NewFromUtf8Literal(_isolate, "module"),
+            v8::String::NewFromUtf8Literal(_isolate, "__filename"),
+            v8::String::NewFromUtf8Literal(_isolate, "__dirname"),
+    };
+    // 源码作为函数体编译，不需要拼接包装代码，行列号也和源文件一致
+    v8::Local<v8::Function> wrapper;
+    if (!v8::ScriptCompiler::CompileFunctionInContext(context, &compilerSource, 5, parameters, 0, nullptr).ToLocal(&wrapper)) {
+        return false;
+    }
+    _compiled_count++;
+    v8::Local<v8::Function> require;
+    v8::Local<v8::Value> exports;
+    if (!createRequire(filename).ToLocal(&require) || !module->Get(context, exportsKey).ToLocal(&exports)) {
+        return false;
+    }
+    v8::Local<v8::Value> arguments[] = {exports, require, module, name, NewString(_isolate, FilePath::DirName(filename))};
+    return !wrapper->Call(context, exports, 5, arguments).IsEmpty();
+}
+
+void CommonJsLoader::throwNotFound(StringView specifier) {
+    v8::Local<v8::Context> context = _context.Get(_isolate);
+    std::string message = "Cannot find module '" + specifier.toString() + "'";
+    v8::Local<v8::Object> error = v8::Exception::Error(NewString(_isolate, message)).As<v8::Object>();
+    error->Set(context, v8::String::NewFromUtf8Literal(_isolate, "code"), v8::String::NewFromUtf8Literal(_isolate, "MODULE_NOT_FOUND")).Check();
+    _isolate->ThrowException(error);
+}
+
+void CommonJsLoader::RequireCallback(const v8::FunctionCallbackInfo<v8::Value> &info) {
+    v8::Isolate *isolate = info.GetIsolate();
+    CommonJsLoader *loader = FromContext(isolate->GetCurrentContext());
+    if (loader == nullptr) {
+        isolate->ThrowException(v8::Exception::Error(v8::String::NewFromUtf8Literal(isolate, "commonjs loader not found")));
+        return;
+    }
+    if (info.Length() < 1 || !info[0]->IsString()) {
+        isolate->ThrowException(v8::Exception::TypeError(v8::String::NewFromUtf8Literal(isolate, "The \"id\" argument must be of type string")));
+        return;
+    }
+    v8::String::Utf8Value specifier(isolate, info[0]);
+    v8::String::Utf8Value directory(isolate, info.Data());
+    v8::Local<v8::Value> exports;
+    if (loader->require(StringView(*specifier, specifier.length()), StringView(*directory, directory.length())).ToLocal(&exports)) {
+        info.GetReturnValue().Set(exports);
+    }
+}
+
+void CommonJsLoader::ResolveCallback(const v8::FunctionCallbackInfo<v8::Value> &info) {
+    v8::Isolate *isolate = info.GetIsolate();
+    CommonJsLoader *loader = FromContext(isolate->GetCurrentContext());
+    if (loader == nullptr || info.Length() < 1 || !info[0]->IsString()) {
+        isolate->ThrowException(v8::Exception::TypeError(v8::String::NewFromUtf8Literal(isolate, "The \"request\" argument must be of type string")));
+        return;
+    }
+    v8::String::Utf8Value specifier(isolate, info[0]);
+    v8::String::Utf8Value directory(isolate, info.Data());
+    std::string filename;
+    if (!loader->resolve(StringView(*specifier, specifier.length()), StringView(*directory, directory.length()), &filename)) {
+        loader->throwNotFound(StringView(*specifier, specifier.length()));
+        return;
+    }
+    info.GetReturnValue().Set(NewString(isolate, filename));
+}
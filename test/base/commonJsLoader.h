@@ -0,0 +1,121 @@
+//
+// Created by user on 2026/10/17.
+//
+
+#ifndef V8_LEARN_COMMON_JS_LOADER_H
+#define V8_LEARN_COMMON_JS_LOADER_H
+#include "fileSystemCache.h"
+#include "v8.h"
+#include <memory>
+#include <string>
+
+/**
+ * CommonJS 的 require。
+ * 模块源码包装成 function (exports, require, module, __filename, __dirname) 编译执行（ScriptCompiler::CompileFunctionInContext），
+ * 执行过的模块对象保存在 require.cache 中，以真实路径为键，删除其中的项可以让下一次 require 重新加载。
+ * 说明符按 node 的规则解析：相对和绝对路径依次尝试文件、补全 .js/.json 扩展名、目录的 package.json main 和 index，
+ * 其他说明符先匹配内建模块，再从导入方所在目录逐级向上查找 node_modules。
+ * 文件系统查询和解析结果由 FileSystemCache 缓存，同一棵依赖树中已经解析过的路径不再重复系统调用。
+ * 加载器保存在上下文的嵌入数据中，生命周期由创建方管理，必须在上下文销毁前析构。
+ */
+class CommonJsLoader {
+public:
+    /**
+     * @param context
+     * @param fileSystemCache 为空时使用加载器自己的缓存
+     */
+    explicit CommonJsLoader(v8::Local<v8::Context> context, FileSystemCache *fileSystemCache = nullptr);
+    ~CommonJsLoader();
+    CommonJsLoader(const CommonJsLoader &) = delete;
+    CommonJsLoader &operator=(const CommonJsLoader &) = delete;
+
+    /**
+     * 获取上下文的加载器，没有时返回 nullptr
+     * @param context
+     * @return
+     */
+    static CommonJsLoader *FromContext(v8::Local<v8::Context> context);
+
+    /**
+     * 创建相对于 filename 所在目录解析的 require 函数，带有 require.cache 和 require.resolve
+     * @param filename 绝对路径
+     * @return
+     */
+    v8::MaybeLocal<v8::Function> createRequire(const std::string &filename);
+    /**
+     * 在目录下加载模块，返回 module.exports。失败时返回空并且隔离实例上有待处理的异常
+     * @param specifier
+     * @param directory
+     * @return
+     */
+    v8::MaybeLocal<v8::Value> require(StringView specifier, StringView directory);
+    /**
+     * 解析说明符为模块文件的真实路径
+     * @param specifier
+     * @param directory 导入方所在目录
+     * @param filename
+     * @return 找不到模块时返回 false
+     */
+    bool resolve(StringView specifier, StringView directory, std::string *filename);
+
+    /**
+     * require.cache 对象
+     * @return
+     */
+    v8::Local<v8::Object> getCache();
+    FileSystemCache *getFileSystemCache() { return _file_system_cache; }
+    uint64_t getCompiledCount() const { return _compiled_count; }
+
+private:
+    static void RequireCallback(const v8::FunctionCallbackInfo<v8::Value> &info);
+    static void ResolveCallback(const v8::FunctionCallbackInfo<v8::Value> &info);
+
+    /**
+     * 加载并执行模块文件，已经在 require.cache 中时直接返回
+     * @param filename 真实路径
+     * @return module.exports
+     */
+    v8::MaybeLocal<v8::Value> load(const std::string &filename);
+    /**
+     * 执行模块包装函数
+     * @param context
+     * @param module
+     * @param filename
+     * @return
+     */
+    bool evaluate(v8::Local<v8::Context> context, v8::Local<v8::Object> module, const std::string &filename);
+    /**
+     * 依次尝试 path、path.js、path.json
+     * @param path
+     * @param filename
+     * @return
+     */
+    bool loadAsFile(StringView path, std::string *filename);
+    /**
+     * 尝试 package.json 的 main 和 index
+     * @param path
+     * @param filename
+     * @return
+     */
+    bool loadAsDirectory(StringView path, std::string *filename);
+    /**
+     * 读取包目录的 package.json main 字段，结果缓存在 FileSystemCache 中
+     * @param path
+     * @return
+     */
+    const std::string &packageMain(StringView path);
+    /**
+     * 抛出找不到模块的异常
+     * @param specifier
+     */
+    void throwNotFound(StringView specifier);
+
+    v8::Isolate *_isolate;
+    v8::Global<v8::Context> _context;
+    v8::Global<v8::Object> _cache;
+    std::unique_ptr<FileSystemCache> _own_file_system_cache;
+    FileSystemCache *_file_system_cache;
+    uint64_t _compiled_count = 0;
+};
+
+#endif//V8_LEARN_COMMON_JS_LOADER_H
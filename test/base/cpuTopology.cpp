@@ -0,0 +1,194 @@
+//
+// Created by user on 2026/10/17.
+//
+
+#include "cpuTopology.h"
+#include "numaPageAllocator.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#if defined(LINUX)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace {
+    /**
+     * 读取 sysfs 文件的第一行，文件不存在时返回空字符串
+     * @param path
+     * @return
+     */
+    std::string ReadLine(const std::string &path) {
+        std::ifstream in(path.c_str());
+        std::string line;
+        std::getline(in, line);
+        return line;
+    }
+
+    void WriteList(FILE *out, const std::vector<int> &values) {
+        fprintf(out, "[");
+        for (size_t i = 0; i < values.size(); i++) {
+            fprintf(out, "%s%d", i == 0 ? "" : ", ", values[i]);
+        }
+        fprintf(out, "]");
+    }
+}// namespace
+
+const CpuTopology &CpuTopology::Get() {
+    static CpuTopology topology = Detect();
+    return topology;
+}
+
+CpuTopology CpuTopology::Detect(const std::string &root) {
+    CpuTopology topology;
+    for (int id : ParseCpuList(ReadLine(root + "/node/online"))) {
+        std::string dir = root + "/node/node" + std::to_string(id);
+        Node node;
+        node.id = id;
+        node.cpus = ParseCpuList(ReadLine(dir + "/cpulist"));
+        std::istringstream distances(ReadLine(dir + "/distance"));
+        int distance;
+        while (distances >> distance) {
+            node.distances.push_back(distance);
+        }
+        topology._nodes.push_back(std::move(node));
+    }
+    if (topology._nodes.empty()) {
+        Node node;
+        node.cpus = ParseCpuList(ReadLine(root + "/cpu/online"));
+        if (node.cpus.empty()) {
+            for (int cpu = 0; cpu < static_cast<int>(std::max(1u, std::thread::hardware_concurrency())); cpu++) {
+                node.cpus.push_back(cpu);
+            }
+        }
+        node.distances.push_back(10);
+        topology._nodes.push_back(std::move(node));
+    }
+    return topology;
+}
+
+std::vector<int> CpuTopology::ParseCpuList(const std::string &cpus) {
+    std::vector<int> result;
+    size_t start = 0;
+    while (start < cpus.size()) {
+        size_t end = cpus.find(',', start);
+        if (end == std::string::npos) {
+            end = cpus.size();
+        }
+        std::string range = cpus.substr(start, end - start);
+        size_t dash = range.find('-');
+        // 跳过空项和 sysfs 文件末尾的换行
+        if (!range.empty() && std::isdigit(static_cast<unsigned char>(range[0]))) {
+            int first = std::atoi(range.c_str());
+            int last = dash == std::string::npos ? first : std::atoi(range.c_str() + dash + 1);
+            for (int cpu = first; cpu <= last; ++cpu) {
+                result.push_back(cpu);
+            }
+        }
+        start = end + 1;
+    }
+    return result;
+}
+
+bool CpuTopology::SetThreadAffinity(const std::vector<int> &cpus) {
+    if (cpus.empty()) {
+        return true;
+    }
+#if defined(LINUX)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : cpus) {
+        if (cpu >= 0 && cpu < CPU_SETSIZE) {
+            CPU_SET(cpu, &set);
+        }
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    return false;
+#endif
+}
+
+std::vector<int> CpuTopology::GetThreadAffinity() {
+    std::vector<int> cpus;
+#if defined(LINUX)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (pthread_getaffinity_np(pthread_self(), sizeof(set), &set) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+            if (CPU_ISSET(cpu, &set)) {
+                cpus.push_back(cpu);
+            }
+        }
+    }
+#endif
+    return cpus;
+}
+
+bool CpuTopology::Apply(const ThreadPlacement &placement) {
+    NumaPageAllocator::SetThreadNode(placement.numaNode);
+    if (!placement.cpus.empty()) {
+        return SetThreadAffinity(placement.cpus);
+    }
+    if (placement.numaNode < 0) {
+        return true;
+    }
+    const Node *node = Get().getNode(placement.numaNode);
+    return node == nullptr || SetThreadAffinity(node->cpus);
+}
+
+const CpuTopology::Node *CpuTopology::getNode(int id) const {
+    for (const Node &node : _nodes) {
+        if (node.id == id) {
+            return &node;
+        }
+    }
+    return nullptr;
+}
+
+int CpuTopology::getNodeOfCpu(int cpu) const {
+    for (const Node &node : _nodes) {
+        if (std::find(node.cpus.begin(), node.cpus.end(), cpu) != node.cpus.end()) {
+            return node.id;
+        }
+    }
+    return -1;
+}
+
+size_t CpuTopology::getCpuCount() const {
+    size_t count = 0;
+    for (const Node &node : _nodes) {
+        count += node.cpus.size();
+    }
+    return count;
+}
+
+std::vector<ThreadPlacement> CpuTopology::getNodePlacements() const {
+    std::vector<ThreadPlacement> placements;
+    for (const Node &node : _nodes) {
+        // 没有 cpu 的节点（只有内存）上不能运行线程
+        if (!node.cpus.empty()) {
+            ThreadPlacement placement;
+            placement.numaNode = node.id;
+            placements.push_back(placement);
+        }
+    }
+    return placements;
+}
+
+void CpuTopology::report(FILE *out) const {
+    fprintf(out, "{\"nodes\": [");
+    for (size_t i = 0; i < _nodes.size(); i++) {
+        fprintf(out, "%s{\"id\": %d, \"cpus\": ", i == 0 ? "" : ", ", _nodes[i].id);
+        WriteList(out, _nodes[i].cpus);
+        fprintf(out, ", \"distances\": ");
+        WriteList(out, _nodes[i].distances);
+        fprintf(out, "}");
+    }
+    fprintf(out, "], \"thread_affinity\": ");
+    WriteList(out, GetThreadAffinity());
+    fprintf(out, ", \"thread_node\": %d}\n", NumaPageAllocator::GetThreadNode());
+    fflush(out);
+}
@@ -0,0 +1,96 @@
+//
+// Created by user on 2026/10/17.
+//
+
+#ifndef V8_LEARN_CPU_TOPOLOGY_H
+#define V8_LEARN_CPU_TOPOLOGY_H
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/**
+ * 线程的放置方式：允许运行的 cpu 和保留内存绑定的 NUMA 节点
+ */
+struct ThreadPlacement {
+    // 允许运行的 cpu，为空时使用 numaNode 节点上的 cpu，两者都为空时不限制
+    std::vector<int> cpus;
+    // 为 -1 时不绑定节点
+    int numaNode = -1;
+};
+
+/**
+ * 本机的 cpu 和 NUMA 节点拓扑，从 /sys/devices/system 读取。
+ * 读取不到节点信息（非 linux 或者内核不支持 NUMA）时，所有在线的 cpu 视为同一个节点 0。
+ */
+class CpuTopology {
+public:
+    struct Node {
+        int id = 0;
+        std::vector<int> cpus;
+        // 到各个节点的距离，下标与 getNodes 的顺序相同，本节点通常是 10
+        std::vector<int> distances;
+    };
+
+    /**
+     * 进程唯一的拓扑，第一次使用时读取
+     * @return
+     */
+    static const CpuTopology &Get();
+    /**
+     * 读取拓扑
+     * @param root sysfs 中 system 目录的路径，测试时可以指向构造的目录
+     * @return
+     */
+    static CpuTopology Detect(const std::string &root = "/sys/devices/system");
+    /**
+     * 解析 "0-3,6" 形式的 cpu 列表，也是 sysfs 中 cpulist 文件的格式
+     * @param cpus
+     * @return
+     */
+    static std::vector<int> ParseCpuList(const std::string &cpus);
+    /**
+     * 把当前线程限制在给定的 cpu 上，只在 linux 下生效
+     * @param cpus 为空时不修改
+     * @return
+     */
+    static bool SetThreadAffinity(const std::vector<int> &cpus);
+    /**
+     * 当前线程允许运行的 cpu
+     * @return
+     */
+    static std::vector<int> GetThreadAffinity();
+    /**
+     * 在当前线程上应用放置方式：设置 cpu 亲和性，并让之后保留的内存绑定到节点（NumaPageAllocator::SetThreadNode）
+     * @param placement
+     * @return 设置亲和性失败时返回 false
+     */
+    static bool Apply(const ThreadPlacement &placement);
+
+    const std::vector<Node> &getNodes() const { return _nodes; }
+    /**
+     * @param id
+     * @return 节点不存在时返回 nullptr
+     */
+    const Node *getNode(int id) const;
+    /**
+     * @param cpu
+     * @return cpu 不属于任何节点时返回 -1
+     */
+    int getNodeOfCpu(int cpu) const;
+    size_t getCpuCount() const;
+    /**
+     * 每个节点一种放置方式，用于把工作线程轮流分散到各个节点
+     * @return
+     */
+    std::vector<ThreadPlacement> getNodePlacements() const;
+    /**
+     * 写出一行 JSON：各节点的 cpu 和距离，以及当前线程的 cpu 亲和性
+     * @param out
+     */
+    void report(FILE *out) const;
+
+private:
+    std::vector<Node> _nodes;
+};
+
+#endif//V8_LEARN_CPU_TOPOLOGY_H
@@ -0,0 +1,178 @@
+//
+// Created by user on 2026/10/17.
+//
+
+#include "dynamicImportLoader.h"
+#include "embedderData.h"
+
+struct DynamicImportLoader::Job {
+    std::string path;
+    // 从归档加载或者合成模块时为空
+    std::unique_ptr<StreamedModule> streamed;
+    // 等待该模块的所有 import() 返回的 promise
+    std::vector<v8::Global<v8::Promise::Resolver>> resolvers;
+};
+
+DynamicImportLoader::DynamicImportLoader(v8::Local<v8::Context> context, ModuleMap *moduleMap, EventLoop *eventLoop,
+                                         SourceReader reader, ThreadPool *threadPool)
+    : _isolate(context->GetIsolate()), _context(context->GetIsolate(), context), _module_map(moduleMap), _event_loop(eventLoop),
+      _reader(std::move(reader)), _thread_pool(threadPool == nullptr ? ThreadPool::GetDefault() : threadPool) {
+    if (_reader == nullptr) {
+        _reader = StreamedModule::DefaultReader();
+    }
+    ContextEmbedderData::SetPointer(context, ContextEmbedderIndex::kDynamicImportLoader, this);
+}
+
+DynamicImportLoader::~DynamicImportLoader() {
+    v8::HandleScope handleScope(_isolate);
+    ContextEmbedderData::SetPointer(_context.Get(_isolate), ContextEmbedderIndex::kDynamicImportLoader, nullptr);
+}
+
+DynamicImportLoader *DynamicImportLoader::FromContext(v8::Local<v8::Context> context) {
+    return static_cast<DynamicImportLoader *>(ContextEmbedderData::GetPointer(context, ContextEmbedderIndex::kDynamicImportLoader));
+}
+
+v8::MaybeLocal<v8::Promise> DynamicImportLoader::ImportModuleDynamically(v8::Local<v8::Context> context, v8::Local<v8::ScriptOrModule> referrer,
+                                                                         v8::Local<v8::String> specifier, v8::Local<v8::FixedArray> import_assertions) {
+    v8::Isolate *isolate = context->GetIsolate();
+    DynamicImportLoader *loader = FromContext(context);
+    if (loader == nullptr) {
+        isolate->ThrowException(v8::Exception::Error(v8::String::NewFromUtf8Literal(isolate, "dynamic import loader not found")));
+        return v8::MaybeLocal<v8::Promise>();
+    }
+    v8::String::Utf8Value value(isolate, specifier);
+    std::string referrerPath;
+    v8::Local<v8::Value> resourceName = referrer->GetResourceName();
+    if (resourceName->IsString()) {
+        v8::String::Utf8Value name(isolate, resourceName);
+        referrerPath = *name;
+    }
+    return loader->import(context, *value, referrerPath);
+}
+
+v8::MaybeLocal<v8::Promise> DynamicImportLoader::import(v8::Local<v8::Context> context, const std::string &specifier, const std::string &referrerPath) {
+    v8::EscapableHandleScope handleScope(_isolate);
+    v8::Local<v8::Promise::Resolver> resolver;
+    if (!v8::Promise::Resolver::New(context).ToLocal(&resolver)) {
+        return v8::MaybeLocal<v8::Promise>();
+    }
+    std::string path = _module_map->resolve(specifier, referrerPath);
+    // 已经加载过的模块：执行过的直接兑现，否则交给事件循环执行，不在回调中执行 js
+    if (_module_map->contains(path)) {
+        _cache_hit_count++;
+        v8::Local<v8::Module> module = _module_map->get(path).ToLocalChecked();
+        if (module->GetStatus() >= v8::Module::kEvaluating) {
+            Settle(context, module, resolver);
+        } else {
+            auto *pending = new v8::Global<v8::Promise::Resolver>(_isolate, resolver);
+            _event_loop->post([this, path, pending]() -> void {
+                std::unique_ptr<v8::Global<v8::Promise::Resolver>> resolver(pending);
+                v8::Local<v8::Context> context = _context.Get(_isolate);
+                v8::Context::Scope contextScope(context);
+                Settle(context, _module_map->get(path).ToLocalChecked(), resolver->Get(_isolate));
+            });
+        }
+        return handleScope.Escape(resolver->GetPromise());
+    }
+    // 正在加载的模块：加入同一次加载
+    auto it = _in_flight.find(path);
+    if (it != _in_flight.end()) {
+        _shared_count++;
+        it->second->resolvers.emplace_back(_isolate, resolver);
+        return handleScope.Escape(resolver->GetPromise());
+    }
+    _load_count++;
+    auto *job = new Job();
+    job->path = path;
+    job->resolvers.emplace_back(_isolate, resolver);
+    _in_flight[path].reset(job);
+    _event_loop->ref();
+    // 归档中的模块已经在内存中，合成模块不需要编译，都不经过线程池，直接在下一次 tick 中由模块表加载
+    ModuleArchive *archive = _module_map->getArchive();
+    if ((archive != nullptr && archive->contains(path)) || ModuleMap::IsSynthetic(path)) {
+        _event_loop->post([this, job]() -> void {
+            finish(job);
+            _event_loop->unref();
+        });
+        return handleScope.Escape(resolver->GetPromise());
+    }
+    job->streamed = std::make_unique<StreamedModule>(_isolate, path, &_reader);
+    _thread_pool->submit([this, job]() -> void {
+        job->streamed->run();
+        _event_loop->post([this, job]() -> void {
+            finish(job);
+            _event_loop->unref();
+        });
+    });
+    return handleScope.Escape(resolver->GetPromise());
+}
+
+void DynamicImportLoader::finish(Job *job) {
+    // 从进行中的表中移出，之后的导入命中模块表
+    std::unique_ptr<Job> owner = std::move(_in_flight[job->path]);
+    _in_flight.erase(job->path);
+    v8::HandleScope handleScope(_isolate);
+    v8::Local<v8::Context> context = _context.Get(_isolate);
+    v8::Context::Scope contextScope(context);
+    v8::TryCatch tryCatch(_isolate);
+    v8::Local<v8::Module> module;
+    if (job->streamed == nullptr) {
+        // 从归档加载或者创建合成模块
+        _module_map->load(job->path).ToLocal(&module);
+    } else if (job->streamed->finish(context).ToLocal(&module) && !_module_map->insert(job->path, module)) {
+        // 编译期间同一个路径已经通过 ModuleMap::load 加载，使用表中的模块，保证同一个路径只有一个模块实例
+        module = _module_map->get(job->path).ToLocalChecked();
+    }
+    if (module.IsEmpty()) {
+        if (tryCatch.HasTerminated()) {
+            return;
+        }
+        // 加载失败不进入模块表，所有等待的 promise 以同一个异常拒绝，之后的导入会重新加载
+        v8::Local<v8::Value> exception = tryCatch.Exception();
+        for (v8::Global<v8::Promise::Resolver> &resolver : job->resolvers) {
+            resolver.Get(_isolate)->Reject(context, exception).Check();
+        }
+        return;
+    }
+    for (v8::Global<v8::Promise::Resolver> &resolver : job->resolvers) {
+        Settle(context, module, resolver.Get(_isolate));
+    }
+}
+
+void DynamicImportLoader::Settle(v8::Local<v8::Context> context, v8::Local<v8::Module> module, v8::Local<v8::Promise::Resolver> resolver) {
+    v8::Isolate *isolate = context->GetIsolate();
+    v8::HandleScope handleScope(isolate);
+    v8::TryCatch tryCatch(isolate);
+    if (module->GetStatus() == v8::Module::kUninstantiated &&
+        !module->InstantiateModule(context, ModuleMap::ResolveCallback).FromMaybe(false)) {
+        if (!tryCatch.HasTerminated()) {
+            resolver->Reject(context, tryCatch.Exception()).Check();
+        }
+        return;
+    }
+    v8::Local<v8::Value> result;
+    if (module->GetStatus() == v8::Module::kInstantiated && !module->Evaluate(context).ToLocal(&result)) {
+        if (!tryCatch.HasTerminated()) {
+            resolver->Reject(context, tryCatch.Exception()).Check();
+        }
+        return;
+    }
+    if (module->GetStatus() == v8::Module::kErrored) {
+        resolver->Reject(context, module->GetException()).Check();
+        return;
+    }
+    v8::Local<v8::Value> moduleNamespace = module->GetModuleNamespace();
+    // 开启顶层 await 时执行结果是 promise，模块执行完成后再以命名空间兑现
+    if (!result.IsEmpty() && result->IsPromise()) {
+        v8::Local<v8::Function> onFulfilled;
+        v8::Local<v8::Promise> evaluated;
+        if (v8::Function::New(context, [](const v8::FunctionCallbackInfo<v8::Value> &info) -> void {
+                info.GetReturnValue().Set(info.Data());
+            }, moduleNamespace).ToLocal(&onFulfilled) &&
+            result.As<v8::Promise>()->Then(context, onFulfilled).ToLocal(&evaluated)) {
+            resolver->Resolve(context, evaluated).Check();
+        }
+        return;
+    }
+    resolver->Resolve(context, moduleNamespace).Check();
+}
@@ -0,0 +1,106 @@
+//
+// Created by user on 2026/10/17.
+//
+
+#ifndef V8_LEARN_DYNAMIC_IMPORT_LOADER_H
+#define V8_LEARN_DYNAMIC_IMPORT_LOADER_H
+#include "eventLoop.h"
+#include "moduleGraphLoader.h"
+#include "moduleMap.h"
+#include "threadPool.h"
+#include "v8.h"
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * 异步的动态导入 import()。
+ * 宿主回调只解析说明符并立即返回一个待定的 promise，模块的读取和编译（ScriptCompiler::StartStreaming）在线程池中进行，
+ * 完成后通过事件循环回到隔离实例所在的线程实例化、执行模块并兑现 promise，回调中不再同步编译和执行。
+ * 同一个模块同时被多次导入时共享一次加载，加载完成的模块保存在模块表中，之后的导入直接命中。
+ * 被导入模块的静态依赖在实例化时通过模块表解析；模块表设置了归档时，归档中的模块不经过线程池直接编译。
+ * 加载器保存在上下文的嵌入数据中，析构前需要运行事件循环直到所有加载完成。
+ */
+class DynamicImportLoader {
+public:
+    using SourceReader = ModuleGraphLoader::SourceReader;
+
+    /**
+     * @param context
+     * @param moduleMap 加载的模块放入该模块表
+     * @param eventLoop 完成回调投递到该事件循环
+     * @param reader 读取模块源码，在工作线程上调用，为空时从文件系统读取
+     * @param threadPool 为空时使用默认线程池
+     */
+    DynamicImportLoader(v8::Local<v8::Context> context, ModuleMap *moduleMap, EventLoop *eventLoop,
+                        SourceReader reader = nullptr, ThreadPool *threadPool = nullptr);
+    ~DynamicImportLoader();
+    DynamicImportLoader(const DynamicImportLoader &) = delete;
+    DynamicImportLoader &operator=(const DynamicImportLoader &) = delete;
+
+    /**
+     * 获取上下文的动态导入加载器，没有时返回 nullptr
+     * @param context
+     * @return
+     */
+    static DynamicImportLoader *FromContext(v8::Local<v8::Context> context);
+    /**
+     * 用于 Isolate::SetHostImportModuleDynamicallyCallback 的回调
+     */
+    static v8::MaybeLocal<v8::Promise> ImportModuleDynamically(v8::Local<v8::Context> context, v8::Local<v8::ScriptOrModule> referrer,
+                                                               v8::Local<v8::String> specifier, v8::Local<v8::FixedArray> import_assertions);
+
+    /**
+     * 导入模块，返回的 promise 以模块的命名空间对象兑现
+     * @param context
+     * @param specifier
+     * @param referrerPath 导入方的路径
+     * @return
+     */
+    v8::MaybeLocal<v8::Promise> import(v8::Local<v8::Context> context, const std::string &specifier, const std::string &referrerPath);
+
+    /**
+     * 在后台开始的加载次数
+     */
+    uint64_t getLoadCount() const { return _load_count; }
+    /**
+     * 加入进行中的加载的导入次数
+     */
+    uint64_t getSharedCount() const { return _shared_count; }
+    /**
+     * 直接命中模块表的导入次数
+     */
+    uint64_t getCacheHitCount() const { return _cache_hit_count; }
+    size_t getInFlightCount() const { return _in_flight.size(); }
+
+private:
+    struct Job;
+
+    /**
+     * 在事件循环线程上完成编译，兑现所有等待该模块的 promise
+     * @param job
+     */
+    void finish(Job *job);
+    /**
+     * 实例化并执行模块，用执行结果兑现 promise
+     * @param context
+     * @param module
+     * @param resolver
+     */
+    static void Settle(v8::Local<v8::Context> context, v8::Local<v8::Module> module, v8::Local<v8::Promise::Resolver> resolver);
+
+    v8::Isolate *_isolate;
+    v8::Global<v8::Context> _context;
+    ModuleMap *_module_map;
+    EventLoop *_event_loop;
+    SourceReader _reader;
+    ThreadPool *_thread_pool;
+    // 正在加载的模块路径到加载任务，只在隔离实例所在的线程上访问
+    std::unordered_map<std::string, std::unique_ptr<Job>> _in_flight;
+    uint64_t _load_count = 0;
+    uint64_t _shared_count = 0;
+    uint64_t _cache_hit_count = 0;
+};
+
+#endif//V8_LEARN_DYNAMIC_IMPORT_LOADER_H
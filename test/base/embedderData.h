@@ -0,0 +1,88 @@
+//
+// Created by user on 2026/10/17.
+//
+
+#ifndef V8_LEARN_EMBEDDER_DATA_H
+#define V8_LEARN_EMBEDDER_DATA_H
+#include "v8.h"
+
+/**
+ * 上下文嵌入数据（Context::SetAlignedPointerInEmbedderData）的下标，统一在这里分配避免冲突。
+ * 下标 0 被 v8 的调试器使用。
+ */
+enum ContextEmbedderIndex : int {
+    // 上下文的模块表 ModuleMap
+    kModuleMap = 1,
+    // 内建模块的导出缓存，名称到导出对象的 Map
+    kBuildInModuleExports = 2,
+    // 传给内建模块注册函数的 require 函数
+    kBuildInModuleRequire = 3,
+    // 上下文的动态导入加载器 DynamicImportLoader
+    kDynamicImportLoader = 4,
+    // 上下文的 CommonJS 加载器 CommonJsLoader
+    kCommonJsLoader = 5,
+    // 下标的数量，新的下标加在前面
+    kContextEmbedderIndexCount,
+};
+
+/**
+ * 隔离实例数据（Isolate::SetData）的下标，v8 只提供 Isolate::GetNumberOfDataSlots 个
+ */
+enum IsolateDataIndex : uint32_t {
+    // 内建模块的导出模板，每个隔离实例创建一次
+    kBuildInModuleTemplates = 0,
+    // 归还到池中时需要移除的回调，见 IsolateCallbacks
+    kIsolateCallbacks = 1,
+};
+
+/**
+ * 读写上下文嵌入数据。
+ * 设置较大的下标时 v8 会扩展嵌入数据数组，中间没有写过的下标是 undefined，不是对齐的指针，
+ * 直接用 GetAlignedPointerFromEmbedderData 读取会触发 v8 的检查。
+ * 所以设置任意下标之前先调用 Initialize，把所有下标一次写好：指针下标为 nullptr，值下标为 undefined。
+ */
+class ContextEmbedderData {
+public:
+    /**
+     * 写入还不存在的下标，已经写过的下标不变，可以重复调用
+     * @param context
+     */
+    static void Initialize(v8::Local<v8::Context> context) {
+        int count = static_cast<int>(context->GetNumberOfEmbedderDataFields());
+        // 下标 0 属于调试器，不写入
+        for (int index = count > 1 ? count : 1; index < kContextEmbedderIndexCount; index++) {
+            if (IsPointerIndex(index)) {
+                context->SetAlignedPointerInEmbedderData(index, nullptr);
+            } else {
+                context->SetEmbedderData(index, v8::Undefined(context->GetIsolate()));
+            }
+        }
+    }
+    /**
+     * 读取指针下标
+     * @param context
+     * @param index
+     * @return 没有初始化时返回 nullptr
+     */
+    static void *GetPointer(v8::Local<v8::Context> context, ContextEmbedderIndex index) {
+        if (static_cast<int>(context->GetNumberOfEmbedderDataFields()) <= index) {
+            return nullptr;
+        }
+        return context->GetAlignedPointerFromEmbedderData(index);
+    }
+    static void SetPointer(v8::Local<v8::Context> context, ContextEmbedderIndex index, void *pointer) {
+        Initialize(context);
+        context->SetAlignedPointerInEmbedderData(index, pointer);
+    }
+    static void SetValue(v8::Local<v8::Context> context, ContextEmbedderIndex index, v8::Local<v8::Value> value) {
+        Initialize(context);
+        context->SetEmbedderData(index, value);
+    }
+
+private:
+    static bool IsPointerIndex(int index) {
+        return index == kModuleMap || index == kDynamicImportLoader || index == kCommonJsLoader;
+    }
+};
+
+#endif//V8_LEARN_EMBEDDER_DATA_H
@@ -0,0 +1,200 @@
+//
+// Created by user on 2026/10/17.
+//
+
+#include "embedderPlatform.h"
+#include "cpuTopology.h"
+#include "libplatform/libplatform.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#if defined(LINUX)
+#include <pthread.h>
+#endif
+
+namespace {
+    double Now() {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+}// namespace
+
+EmbedderPlatform::EmbedderPlatform(const Options &options) : _options(options) {
+    // 默认平台只负责前台任务，自己的工作线程池保持最小
+    _default_platform = v8::platform::NewDefaultPlatform(1);
+#if defined(LINUX)
+    if (_options.numaPageAllocator) {
+        _numa_page_allocator = std::make_unique<NumaPageAllocator>();
+    }
+#endif
+    if (_options.threadCount <= 0) {
+        _options.threadCount = std::max(1, static_cast<int>(std::thread::hardware_concurrency()) - 1);
+    }
+    _options.bestEffortThreadCount = std::max(1, std::min(_options.bestEffortThreadCount, _options.threadCount));
+    for (int i = 0; i < _options.threadCount; ++i) {
+        _workers.emplace_back(&EmbedderPlatform::work, this);
+    }
+}
+
+EmbedderPlatform::~EmbedderPlatform() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+    _condition.notify_all();
+    for (std::thread &worker : _workers) {
+        worker.join();
+    }
+}
+
+std::vector<int> EmbedderPlatform::ParseCpuList(const std::string &cpus) {
+    return CpuTopology::ParseCpuList(cpus);
+}
+
+EmbedderPlatform::QueueStats EmbedderPlatform::getQueueStats(v8::TaskPriority priority) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    QueueStats stats = _stats[static_cast<int>(priority)];
+    stats.depth = _queues[static_cast<int>(priority)].size();
+    return stats;
+}
+
+v8::PageAllocator *EmbedderPlatform::GetPageAllocator() {
+    if (_numa_page_allocator) {
+        return _numa_page_allocator.get();
+    }
+    return _default_platform->GetPageAllocator();
+}
+
+void EmbedderPlatform::OnCriticalMemoryPressure() {
+    _default_platform->OnCriticalMemoryPressure();
+}
+
+int EmbedderPlatform::NumberOfWorkerThreads() {
+    return _options.threadCount;
+}
+
+std::shared_ptr<v8::TaskRunner> EmbedderPlatform::GetForegroundTaskRunner(v8::Isolate *isolate) {
+    return _default_platform->GetForegroundTaskRunner(isolate);
+}
+
+void EmbedderPlatform::CallOnWorkerThread(std::unique_ptr<v8::Task> task) {
+    post(v8::TaskPriority::kUserVisible, std::move(task));
+}
+
+void EmbedderPlatform::CallBlockingTaskOnWorkerThread(std::unique_ptr<v8::Task> task) {
+    post(v8::TaskPriority::kUserBlocking, std::move(task));
+}
+
+void EmbedderPlatform::CallLowPriorityTaskOnWorkerThread(std::unique_ptr<v8::Task> task) {
+    post(v8::TaskPriority::kBestEffort, std::move(task));
+}
+
+void EmbedderPlatform::CallDelayedOnWorkerThread(std::unique_ptr<v8::Task> task, double delay_in_seconds) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _delayed.push_back({std::move(task), Now() + delay_in_seconds});
+        std::push_heap(_delayed.begin(), _delayed.end());
+    }
+    // 新任务可能比之前最早的延时任务更早到期，需要唤醒等待中的线程重新计算等待时间
+    _condition.notify_one();
+}
+
+bool EmbedderPlatform::IdleTasksEnabled(v8::Isolate *isolate) {
+    return _default_platform->IdleTasksEnabled(isolate);
+}
+
+std::unique_ptr<v8::JobHandle> EmbedderPlatform::PostJob(v8::TaskPriority priority, std::unique_ptr<v8::JobTask> job_task) {
+    // 默认的 JobHandle 根据优先级调用 Call*OnWorkerThread，最终进入对应的队列
+    return v8::platform::NewDefaultJobHandle(this, priority, std::move(job_task), NumberOfWorkerThreads());
+}
+
+double EmbedderPlatform::MonotonicallyIncreasingTime() {
+    return _default_platform->MonotonicallyIncreasingTime();
+}
+
+double EmbedderPlatform::CurrentClockTimeMillis() {
+    return _default_platform->CurrentClockTimeMillis();
+}
+
+v8::Platform::StackTracePrinter EmbedderPlatform::GetStackTracePrinter() {
+    return _default_platform->GetStackTracePrinter();
+}
+
+v8::TracingController *EmbedderPlatform::GetTracingController() {
+    return _default_platform->GetTracingController();
+}
+
+void EmbedderPlatform::post(v8::TaskPriority priority, std::unique_ptr<v8::Task> task) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _queues[static_cast<int>(priority)].push_back({std::move(task), Now()});
+    }
+    _condition.notify_one();
+}
+
+void EmbedderPlatform::promoteDelayedTasks(double now) {
+    while (!_delayed.empty() && _delayed.front().deadline <= now) {
+        std::pop_heap(_delayed.begin(), _delayed.end());
+        // 从到期时开始计算排队延迟
+        _queues[static_cast<int>(v8::TaskPriority::kUserVisible)].push_back({std::move(_delayed.back().task), _delayed.back().deadline});
+        _delayed.pop_back();
+    }
+}
+
+int EmbedderPlatform::selectQueue() {
+    if (!_queues[static_cast<int>(v8::TaskPriority::kUserBlocking)].empty()) {
+        return static_cast<int>(v8::TaskPriority::kUserBlocking);
+    }
+    if (!_queues[static_cast<int>(v8::TaskPriority::kUserVisible)].empty()) {
+        return static_cast<int>(v8::TaskPriority::kUserVisible);
+    }
+    if (!_queues[static_cast<int>(v8::TaskPriority::kBestEffort)].empty() && _running_best_effort < _options.bestEffortThreadCount) {
+        return static_cast<int>(v8::TaskPriority::kBestEffort);
+    }
+    return -1;
+}
+
+void EmbedderPlatform::applyAffinity() {
+#if defined(LINUX)
+    pthread_setname_np(pthread_self(), "V8 Worker");
+#endif
+    CpuTopology::SetThreadAffinity(_options.cpus);
+}
+
+void EmbedderPlatform::work() {
+    applyAffinity();
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (!_stopping) {
+        double now = Now();
+        promoteDelayedTasks(now);
+        int index = selectQueue();
+        if (index < 0) {
+            if (_delayed.empty()) {
+                _condition.wait(lock);
+            } else {
+                _condition.wait_for(lock, std::chrono::duration<double>(_delayed.front().deadline - now));
+            }
+            continue;
+        }
+        QueuedTask queued = std::move(_queues[index].front());
+        _queues[index].pop_front();
+        double wait = (now - queued.enqueueTime) * 1000;
+        QueueStats &stats = _stats[index];
+        stats.count++;
+        stats.totalWait += wait;
+        stats.maxWait = std::max(stats.maxWait, wait);
+        bool bestEffort = index == static_cast<int>(v8::TaskPriority::kBestEffort);
+        if (bestEffort) {
+            _running_best_effort++;
+        }
+        lock.unlock();
+        queued.task->Run();
+        queued.task.reset();
+        lock.lock();
+        if (bestEffort) {
+            _running_best_effort--;
+            // 空出的名额可能让等待中的尽力而为任务可以执行
+            _condition.notify_one();
+        }
+    }
+    // 与默认平台一致，退出时丢弃尚未执行的任务
+}
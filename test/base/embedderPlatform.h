@@ -0,0 +1,110 @@
+//
+// Created by user on 2026/10/17.
+//
+
+#ifndef V8_LEARN_EMBEDDER_PLATFORM_H
+#define V8_LEARN_EMBEDDER_PLATFORM_H
+#include "numaPageAllocator.h"
+#include "v8-platform.h"
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * 嵌入方实现的平台。
+ * 前台任务、时钟、追踪仍然交给 v8 默认平台，后台任务（并发标记、并发编译等）由自己的工作线程执行：
+ * 工作线程数量和绑定的 cpu 可以配置，任务按优先级进入不同的队列，并统计每个队列的排队延迟。
+ * 需要执行前台任务时（v8::platform::PumpMessageLoop）必须使用 getDefaultPlatform 返回的默认平台。
+ */
+class EmbedderPlatform : public v8::Platform {
+public:
+    struct Options {
+        // 工作线程数量，为 0 时使用硬件线程数减 1
+        int threadCount = 0;
+        // 同时执行尽力而为任务的线程数量上限，保证总有线程可以执行更高优先级的任务
+        int bestEffortThreadCount = 1;
+        // 工作线程允许运行的 cpu，为空时不限制。只在 linux 下生效
+        std::vector<int> cpus;
+        // 为 true 时使用 NumaPageAllocator 分配 v8 的页，线程通过 NumaPageAllocator::SetThreadNode 选择节点。只在 linux 下生效
+        bool numaPageAllocator = false;
+    };
+    /**
+     * 队列的统计信息，时间单位为毫秒
+     */
+    struct QueueStats {
+        uint64_t count = 0;
+        size_t depth = 0;
+        double totalWait = 0;
+        double maxWait = 0;
+    };
+
+    explicit EmbedderPlatform(const Options &options);
+    ~EmbedderPlatform() override;
+
+    /**
+     * 解析 "0-3,6" 形式的 cpu 列表，同 CpuTopology::ParseCpuList
+     * @param cpus
+     * @return
+     */
+    static std::vector<int> ParseCpuList(const std::string &cpus);
+
+    v8::Platform *getDefaultPlatform() { return _default_platform.get(); }
+    QueueStats getQueueStats(v8::TaskPriority priority);
+    /**
+     * @return 没有开启 numaPageAllocator 时返回 nullptr
+     */
+    NumaPageAllocator *getNumaPageAllocator() { return _numa_page_allocator.get(); }
+
+    v8::PageAllocator *GetPageAllocator() override;
+    void OnCriticalMemoryPressure() override;
+    int NumberOfWorkerThreads() override;
+    std::shared_ptr<v8::TaskRunner> GetForegroundTaskRunner(v8::Isolate *isolate) override;
+    void CallOnWorkerThread(std::unique_ptr<v8::Task> task) override;
+    void CallBlockingTaskOnWorkerThread(std::unique_ptr<v8::Task> task) override;
+    void CallLowPriorityTaskOnWorkerThread(std::unique_ptr<v8::Task> task) override;
+    void CallDelayedOnWorkerThread(std::unique_ptr<v8::Task> task, double delay_in_seconds) override;
+    bool IdleTasksEnabled(v8::Isolate *isolate) override;
+    std::unique_ptr<v8::JobHandle> PostJob(v8::TaskPriority priority, std::unique_ptr<v8::JobTask> job_task) override;
+    double MonotonicallyIncreasingTime() override;
+    double CurrentClockTimeMillis() override;
+    StackTracePrinter GetStackTracePrinter() override;
+    v8::TracingController *GetTracingController() override;
+
+private:
+    struct QueuedTask {
+        std::unique_ptr<v8::Task> task;
+        double enqueueTime;
+    };
+    struct DelayedTask {
+        std::unique_ptr<v8::Task> task;
+        double deadline;
+        bool operator<(const DelayedTask &other) const { return deadline > other.deadline; }
+    };
+    static const int kQueueCount = 3;
+
+    void post(v8::TaskPriority priority, std::unique_ptr<v8::Task> task);
+    void work();
+    void promoteDelayedTasks(double now);
+    int selectQueue();
+    void applyAffinity();
+
+    std::unique_ptr<v8::Platform> _default_platform;
+    std::unique_ptr<NumaPageAllocator> _numa_page_allocator;
+    Options _options;
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    // 按 v8::TaskPriority 下标的队列
+    std::deque<QueuedTask> _queues[kQueueCount];
+    QueueStats _stats[kQueueCount];
+    // 按到期时间排列的最小堆
+    std::vector<DelayedTask> _delayed;
+    int _running_best_effort = 0;
+    bool _stopping = false;
+    std::vector<std::thread> _workers;
+};
+
+#endif//V8_LEARN_EMBEDDER_PLATFORM_H
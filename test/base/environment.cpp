@@ -3,6 +3,28 @@
 //
 
 #include "environment.h"
+#include "filePath.h"
+#include "isolateCallbacks.h"
+#include "nodeBuildInModule.h"
+#include "snapshot.h"
+#include "sourceFile.h"
+
+IsolatePool *Environment::_isolate_pool = nullptr;
+
+void Environment::SetIsolatePool(IsolatePool *isolatePool) {
+    _isolate_pool = isolatePool;
+}
+
+IsolatePool *Environment::GetIsolatePool() {
+    return _isolate_pool;
+}
+
+FILE *Environment::_heap_telemetry_output = nullptr;
+
+void Environment::SetHeapTelemetryOutput(FILE *out) {
+    _heap_telemetry_output = out;
+}
+
 /**
  *  获取工作目录
  * @return
@@ -27,13 +49,7 @@ std::string Environment::GetWorkingDirectory() {
  * @return
  */
 bool  Environment::IsAbsolutePath(const std::string& path) {
-#if defined(WIN)
-    // This is an incorrect approximation, but should
-    // work for all our test-running cases.
-    return path.find(':') != std::string::npos;
-#else
-    return path[0] == '/';
-#endif
+    return FilePath::IsAbsolute(path);
 }
 
 /**
@@ -42,77 +58,74 @@ bool  Environment::IsAbsolutePath(const std::string& path) {
  * @return
  */
 std::string  Environment::DirName(const std::string& path) {
-    if(!IsAbsolutePath(path)){
-        return  "";
-    }
-    unsigned long  long last_slash = path.find_last_of('/');
-    last_slash != std::string::npos;
-    return path.substr(0, last_slash);
+    return FilePath::DirName(path).toString();
 }
 
 /**
- * 平常花路径
+ * 平常花路径，不再拆分成分段数组，只为结果分配一次内存
  * @param path
  * @param dir_name
  * @return
  */
 std::string Environment::NormalizePath(const std::string& path,
                           const std::string& dir_name) {
-    std::string absolute_path;
-    if (IsAbsolutePath(path)) {
-        absolute_path = path;
-    } else {
-        absolute_path = dir_name + '/' + path;
-    }
-    std::replace(absolute_path.begin(), absolute_path.end(), '\\', '/');
-    std::vector<std::string> segments;
-    std::istringstream segment_stream(absolute_path);
-    std::string segment;
-    while (std::getline(segment_stream, segment, '/')) {
-        if (segment == "..") {
-            segments.pop_back();
-        } else if (segment != ".") {
-            segments.push_back(segment);
-        }
-    }
-    // Join path segments.
-    std::ostringstream os;
-    std::copy(segments.begin(), segments.end() - 1,
-              std::ostream_iterator<std::string>(os, "/"));
-    os << *segments.rbegin();
-    return os.str();
+    return FilePath::Normalize(path, dir_name);
 }
 
-std::string Environment::ReadFile (std::string& path){
-    v8::Isolate* isolate = v8::Isolate::GetCurrent();
-    // 读取主模块文件
-    std::ifstream in(path.c_str());
+/**
+ * 读取整个文件，保留换行符
+ * @param path
+ * @return
+ */
+std::string Environment::ReadFile(const std::string &path) {
+    // 映射文件后一次复制到字符串中，不再逐行读取
+    std::unique_ptr<MappedFile> file = MappedFile::Open(path);
     // 如果打开文件失败
-    if (!in.is_open()) {
+    if (file == nullptr) {
         return "";
     }
-    std::string source;
-    char buffer[256];
-    // 如果没有读取到文件结束符位置。
-    while(!in.eof()){
-        in.getline(buffer,256);
-        source.append(buffer);
-    };
-    return source;
+    return std::string(file->data(), file->size());
 }
 
 
 
 void Environment::SetUp() {
-  v8::Isolate::CreateParams create_params;
-  _array_buffer_allocator = v8::ArrayBuffer::Allocator::NewDefaultAllocator();
-  create_params.array_buffer_allocator = _array_buffer_allocator;
-  _isolate = v8::Isolate::New(create_params);
+  if (_isolate_pool != nullptr) {
+    // 隔离实例由池预先创建，分配器也归池所有
+    _isolate = _isolate_pool->acquire();
+    _array_buffer_allocator = _isolate_pool->getArrayBufferAllocator(_isolate);
+  } else {
+    v8::Isolate::CreateParams create_params;
+    // 从自定义快照启动
+    Snapshot::InitCreateParams(create_params);
+    _array_buffer_allocator = new PooledArrayBufferAllocator();
+    create_params.array_buffer_allocator = _array_buffer_allocator;
+    _isolate = v8::Isolate::New(create_params);
+  }
   _isolate->Enter();
+  if (_heap_telemetry_output != nullptr) {
+    _heap_telemetry = std::make_unique<HeapTelemetry>(_isolate);
+  }
 }
 
 void Environment::TearDown() {
+  if (_heap_telemetry != nullptr) {
+    const ::testing::TestInfo *testInfo = ::testing::UnitTest::GetInstance()->current_test_info();
+    std::string name = std::string(testInfo->test_suite_name()) + "." + testInfo->name();
+    std::string extra = "\"array_buffer\": {\"live\": " + std::to_string(_array_buffer_allocator->getLiveBytes()) +
+                        ", \"peak\": " + std::to_string(_array_buffer_allocator->getPeakBytes()) + "}";
+    _heap_telemetry->writeJsonLine(_heap_telemetry_output, name, extra);
+    // 移除 GC 回调，隔离实例可能归还到池中
+    _heap_telemetry.reset();
+  }
   _isolate->Exit();
+  if (_isolate_pool != nullptr) {
+    // 池在后台重置后复用，测试注册的消息监听、GC 回调和微任务完成回调需要通过 IsolateCallbacks 注册
+    _isolate_pool->release(_isolate, true);
+    return;
+  }
+  IsolateCallbacks::Dispose(_isolate);
+  disposeBuildInModuleTemplates(_isolate);
   _isolate->Dispose();
   delete _array_buffer_allocator;
 }
\ No newline at end of file
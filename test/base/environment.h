@@ -6,6 +6,9 @@
 #define V8_EXTENSION_ENVIRONMENT_H
 #include "v8.h"
 #include "gtest/gtest.h"
+#include "arrayBufferAllocator.h"
+#include "heapTelemetry.h"
+#include "isolatePool.h"
 #include <algorithm>
 #include <string>
 #include<fstream>
@@ -25,7 +28,12 @@ extern v8::Platform *g_default_platform;
 class Environment : public ::testing::Test {
 private:
     v8::Isolate *_isolate;
-    v8::ArrayBuffer::Allocator *_array_buffer_allocator;
+    PooledArrayBufferAllocator *_array_buffer_allocator;
+    std::unique_ptr<HeapTelemetry> _heap_telemetry;
+    // 设置后所有测试的隔离实例从池中取出
+    static IsolatePool *_isolate_pool;
+    // 设置后每个测试结束时写出一行堆和 GC 统计
+    static FILE *_heap_telemetry_output;
 
 protected:
     void SetUp() override;
@@ -35,6 +43,24 @@ public:
     v8::Isolate *getIsolate() {
         return _isolate;
     }
+    /**
+     * 获取当前隔离实例的 ArrayBuffer 分配器
+     * @return
+     */
+    PooledArrayBufferAllocator *getArrayBufferAllocator() {
+        return _array_buffer_allocator;
+    }
+    /**
+     * 设置隔离实例池，传入 nullptr 时每个测试自行创建隔离实例
+     * @param isolatePool
+     */
+    static void SetIsolatePool(IsolatePool *isolatePool);
+    static IsolatePool *GetIsolatePool();
+    /**
+     * 设置堆和 GC 统计的输出，传入 nullptr 时不统计
+     * @param out
+     */
+    static void SetHeapTelemetryOutput(FILE *out);
     /**
      * 获取路径上得目录名称
      * @param path
@@ -61,11 +87,11 @@ public:
      */
     static std::string GetWorkingDirectory();
     /**
-     * 读取文件
+     * 读取文件。需要 v8 字符串时使用 SourceFile::Load，可以避免复制
      * @param path
      * @return
      */
-    static std::string ReadFile (std::string& path);
+    static std::string ReadFile(const std::string &path);
 };
 
 #endif//V8_EXTENSION_ENVIRONMENT_H
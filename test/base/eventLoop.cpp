@@ -0,0 +1,218 @@
+//
+// Created by user on 2026/10/17.
+//
+
+#include "eventLoop.h"
+#include "lockerProfiler.h"
+#include "libplatform/libplatform.h"
+#if defined(LINUX)
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#endif
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+EventLoop::EventLoop(v8::Isolate *isolate, v8::Platform *platform)
+    : _isolate(isolate), _platform(platform) {
+    // 每次 tick 只执行一次微任务检查点，而不是每次调用返回时都执行
+    _previous_policy = isolate->GetMicrotasksPolicy();
+    isolate->SetMicrotasksPolicy(v8::MicrotasksPolicy::kExplicit);
+#if defined(LINUX)
+    _epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    _event_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = _event_fd;
+    epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, _event_fd, &event);
+#endif
+}
+
+EventLoop::~EventLoop() {
+#if defined(LINUX)
+    close(_event_fd);
+    close(_epoll_fd);
+#endif
+    _isolate->SetMicrotasksPolicy(_previous_policy);
+}
+
+void EventLoop::post(Callback callback) {
+    _pending.push(std::move(callback));
+    // 事件循环已经被通知过、还没有开始处理时不需要重复唤醒，它会在这次处理中取到这个回调
+    if (!_notified.exchange(true, std::memory_order_acq_rel)) {
+        wakeup();
+    }
+}
+
+void EventLoop::ref() {
+    _ref_count++;
+}
+
+void EventLoop::unref() {
+    if (--_ref_count == 0) {
+        wakeup();
+    }
+}
+
+void EventLoop::postDelayedTask(std::unique_ptr<v8::Task> task, double delayInSeconds) {
+    _timers.push_back({std::move(task), _platform->MonotonicallyIncreasingTime() + delayInSeconds});
+    std::push_heap(_timers.begin(), _timers.end());
+}
+
+#if defined(LINUX)
+bool EventLoop::watch(int fd, uint32_t events, WatchCallback callback) {
+    epoll_event event{};
+    event.events = events;
+    event.data.fd = fd;
+    if (epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, fd, &event) != 0) {
+        return false;
+    }
+    _watchers[fd] = std::move(callback);
+    return true;
+}
+
+void EventLoop::unwatch(int fd) {
+    if (_watchers.erase(fd) > 0) {
+        epoll_ctl(_epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+    }
+}
+#endif
+
+void EventLoop::run() {
+    while (isAlive()) {
+        runOnce(kMaxWaitMilliseconds);
+    }
+    // 最后一次 tick 执行剩余的前台任务和微任务
+    runOnce(0);
+}
+
+bool EventLoop::runOnce(int timeoutMilliseconds) {
+    wait(_pending.empty() ? timerTimeout(timeoutMilliseconds) : 0);
+    // 先清除通知标记再取回调：之后提交的回调会重新唤醒，之前提交的回调对这里可见
+    _notified.exchange(false, std::memory_order_acq_rel);
+    _tick_count++;
+    bool worked = false;
+    // 整个 tick 只加锁一次
+    PROFILED_LOCKER(locker, _isolate);
+    v8::Isolate::Scope isolateScope(_isolate);
+    v8::HandleScope handleScope(_isolate);
+#if defined(LINUX)
+    worked = !_ready.empty();
+    for (const epoll_event &event : _ready) {
+        auto it = _watchers.find(event.data.fd);
+        // 回调中可能取消了其他文件描述符的监听
+        if (it != _watchers.end()) {
+            WatchCallback callback = it->second;
+            callback(event.events);
+        }
+    }
+    _ready.clear();
+#endif
+    Callback callback;
+    size_t count = 0;
+    while (count < kMaxBatchSize) {
+        MpscQueue<Callback>::PopResult result = _pending.pop(callback);
+        if (result == MpscQueue<Callback>::PopResult::kEmpty) {
+            break;
+        }
+        // 生产者已经交换了队列头、还没有链接，它的唤醒可能已经被合并到本次通知中，
+        // 这里不能当作队列为空去等待，重新检查直到取到这个回调
+        if (result == MpscQueue<Callback>::PopResult::kBusy) {
+            std::this_thread::yield();
+            continue;
+        }
+        count++;
+        worked = true;
+        callback();
+    }
+    if (runTimers()) {
+        worked = true;
+    }
+    // 执行平台投递的前台任务，包括已经到期的延时任务
+    while (v8::platform::PumpMessageLoop(_platform, _isolate)) {
+        worked = true;
+    }
+    _isolate->PerformMicrotaskCheckpoint();
+    return worked;
+}
+
+bool EventLoop::runTimers() {
+    double now = _platform->MonotonicallyIncreasingTime();
+    // 先取出本次到期的任务再执行，任务中投递的零延时任务留到下一次 tick
+    std::vector<std::unique_ptr<v8::Task>> expired;
+    while (!_timers.empty() && _timers.front().deadline <= now) {
+        std::pop_heap(_timers.begin(), _timers.end());
+        expired.push_back(std::move(_timers.back().task));
+        _timers.pop_back();
+    }
+    for (std::unique_ptr<v8::Task> &task : expired) {
+        task->Run();
+    }
+    return !expired.empty();
+}
+
+int EventLoop::timerTimeout(int timeoutMilliseconds) {
+    if (_timers.empty()) {
+        return timeoutMilliseconds;
+    }
+    double remaining = (_timers.front().deadline - _platform->MonotonicallyIncreasingTime()) * 1000;
+    if (remaining <= 0) {
+        return 0;
+    }
+    return std::min(timeoutMilliseconds, static_cast<int>(std::ceil(remaining)));
+}
+
+bool EventLoop::isAlive() {
+    if (_ref_count.load() > 0 || !_timers.empty()) {
+        return true;
+    }
+#if defined(LINUX)
+    if (!_watchers.empty()) {
+        return true;
+    }
+#endif
+    // 正在入队还没有完成链接的回调也算，否则 run 可能在取到它之前返回
+    return !_pending.empty();
+}
+
+#if defined(LINUX)
+void EventLoop::wakeup() {
+    _wakeup_count++;
+    uint64_t value = 1;
+    ssize_t result = write(_event_fd, &value, sizeof(value));
+    (void) result;
+}
+
+void EventLoop::wait(int timeoutMilliseconds) {
+    epoll_event events[64];
+    int count = epoll_wait(_epoll_fd, events, 64, timeoutMilliseconds);
+    for (int i = 0; i < count; ++i) {
+        if (events[i].data.fd == _event_fd) {
+            uint64_t value;
+            ssize_t result = read(_event_fd, &value, sizeof(value));
+            (void) result;
+        } else {
+            _ready.push_back(events[i]);
+        }
+    }
+}
+#else
+void EventLoop::wakeup() {
+    _wakeup_count++;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _wakeup = true;
+    }
+    _condition.notify_one();
+}
+
+void EventLoop::wait(int timeoutMilliseconds) {
+    std::unique_lock<std::mutex> lock(_mutex);
+    _condition.wait_for(lock, std::chrono::milliseconds(timeoutMilliseconds), [this]() -> bool {
+        return _wakeup;
+    });
+    _wakeup = false;
+}
+#endif
@@ -0,0 +1,144 @@
+//
+// Created by user on 2026/10/17.
+//
+
+#ifndef V8_LEARN_EVENT_LOOP_H
+#define V8_LEARN_EVENT_LOOP_H
+#include "mpscQueue.h"
+#include "v8-platform.h"
+#include "v8.h"
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#if defined(LINUX)
+#include <sys/epoll.h>
+#endif
+
+/**
+ * 单线程事件循环，每个隔离实例一个，只在拥有该隔离实例的线程上运行。
+ * 工作线程不再自己加锁执行 js，而是通过 post 把完成回调交给事件循环，
+ * 事件循环在一次 tick 中依次：执行完成回调、执行到期的定时任务、执行平台的前台任务和到期的延时任务、执行一次微任务检查点。
+ * 平台上的延时任务（包括 v8 自己投递的 GC 等任务）不会阻止 run 返回，需要等待的延时任务通过 postDelayedTask 投递。
+ * 完成回调放在无锁的多生产者单消费者队列中，工作线程提交时不加锁，也不和事件循环线程竞争；
+ * 一次 tick 在同一个 Locker 和句柄作用域下批量执行最多 kMaxBatchSize 个回调。
+ * linux 下使用 epoll 等待，通过 eventfd 唤醒，也可以监听其他文件描述符。
+ */
+class EventLoop {
+public:
+    using Callback = std::function<void()>;
+    using WatchCallback = std::function<void(uint32_t events)>;
+    // 没有可执行的任务时最长等待时间，保证延时任务能按时执行
+    static const int kMaxWaitMilliseconds = 10;
+    // 一次 tick 最多执行的完成回调数量，剩余的留到下一次 tick，避免前台任务和微任务被饿死
+    static const size_t kMaxBatchSize = 1024;
+
+    /**
+     * @param isolate
+     * @param platform 必须是 v8::platform::NewDefaultPlatform 创建的平台，用于执行前台任务
+     */
+    EventLoop(v8::Isolate *isolate, v8::Platform *platform);
+    ~EventLoop();
+    EventLoop(const EventLoop &) = delete;
+    EventLoop &operator=(const EventLoop &) = delete;
+
+    /**
+     * 线程安全：提交完成回调，回调在事件循环线程上执行，执行时已经进入隔离实例并打开了句柄作用域
+     * @param callback
+     */
+    void post(Callback callback);
+    /**
+     * 线程安全：增加一个未完成的操作，存在未完成的操作时 run 不会返回
+     */
+    void ref();
+    /**
+     * 线程安全：完成一个操作
+     */
+    void unref();
+    /**
+     * 投递延时任务，到期后在事件循环线程上执行，执行时已经进入隔离实例并打开了句柄作用域。
+     * 任务执行之前 run 不会返回。只能在事件循环线程上调用，其他线程通过 post 转交
+     * @param task
+     * @param delayInSeconds
+     */
+    void postDelayedTask(std::unique_ptr<v8::Task> task, double delayInSeconds);
+#if defined(LINUX)
+    /**
+     * 监听文件描述符，事件就绪时在事件循环线程上回调。监听期间事件循环不会退出。
+     * @param fd
+     * @param events epoll 事件
+     * @param callback
+     * @return
+     */
+    bool watch(int fd, uint32_t events, WatchCallback callback);
+    void unwatch(int fd);
+#endif
+    /**
+     * 运行事件循环，直到没有未完成的操作和待执行的回调
+     */
+    void run();
+    /**
+     * 执行一次 tick
+     * @param timeoutMilliseconds 没有待执行的回调时最长等待的时间
+     * @return 是否执行了回调或者任务
+     */
+    bool runOnce(int timeoutMilliseconds);
+
+    v8::Isolate *getIsolate() { return _isolate; }
+    uint64_t getTickCount() const { return _tick_count; }
+    /**
+     * 实际写入唤醒通知的次数，连续提交的回调只唤醒一次
+     * @return
+     */
+    uint64_t getWakeupCount() const { return _wakeup_count.load(); }
+
+private:
+    struct DelayedTask {
+        std::unique_ptr<v8::Task> task;
+        double deadline;
+        bool operator<(const DelayedTask &other) const { return deadline > other.deadline; }
+    };
+
+    bool isAlive();
+    /**
+     * 执行已经到期的定时任务
+     * @return 是否执行了任务
+     */
+    bool runTimers();
+    /**
+     * 根据最早到期的定时任务缩短等待时间
+     * @param timeoutMilliseconds
+     * @return
+     */
+    int timerTimeout(int timeoutMilliseconds);
+    void wakeup();
+    void wait(int timeoutMilliseconds);
+
+    v8::Isolate *_isolate;
+    v8::Platform *_platform;
+    std::atomic<int> _ref_count{0};
+    MpscQueue<Callback> _pending;
+    // 已经发出唤醒通知、事件循环还没有开始处理时为 true，期间提交的回调不再重复唤醒
+    std::atomic<bool> _notified{false};
+    std::atomic<uint64_t> _wakeup_count{0};
+    uint64_t _tick_count = 0;
+    // 按到期时间排列的最小堆，只在事件循环线程上访问
+    std::vector<DelayedTask> _timers;
+    v8::MicrotasksPolicy _previous_policy;
+#if defined(LINUX)
+    int _epoll_fd = -1;
+    int _event_fd = -1;
+    std::unordered_map<int, WatchCallback> _watchers;
+    // 本次 tick 就绪的文件描述符
+    std::vector<epoll_event> _ready;
+#else
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    bool _wakeup = false;
+#endif
+};
+
+#endif//V8_LEARN_EVENT_LOOP_H
@@ -0,0 +1,95 @@
+//
+// Created by user on 2026/10/17.
+//
+
+#include "filePath.h"
+
+const size_t StringView::npos;
+const size_t FilePath::kMaxPath;
+
+bool FilePath::IsAbsolute(StringView path) {
+#if defined(WIN)
+    // This is an incorrect approximation, but should
+    // work for all our test-running cases.
+    for (size_t i = 0; i < path.size(); i++) {
+        if (path[i] == ':') {
+            return true;
+        }
+    }
+    return false;
+#else
+    return !path.empty() && path[0] == '/';
+#endif
+}
+
+StringView FilePath::DirName(StringView path) {
+    if (!IsAbsolute(path)) {
+        return StringView();
+    }
+    size_t lastSlash = path.rfind('/');
+    return lastSlash == StringView::npos ? path : path.substr(0, lastSlash);
+}
+
+size_t FilePath::Normalize(StringView path, StringView directory, char *out, size_t capacity) {
+    // 相对路径看作 directory + '/' + path，按下标读取，不拼接出中间字符串
+    bool absolute = IsAbsolute(path);
+    size_t prefix = absolute ? 0 : directory.size() + 1;
+    size_t total = prefix + path.size();
+    auto at = [&](size_t i) -> char {
+        char c = i >= prefix ? path[i - prefix] : (i < directory.size() ? directory[i] : '/');
+        return c == '\\' ? '/' : c;
+    };
+    bool rooted = total > 0 && at(0) == '/';
+    // 根目录的 "/" 之后才开始写分段，".." 不会越过根目录
+    size_t floor = rooted ? 1 : 0;
+    if (capacity < floor) {
+        return StringView::npos;
+    }
+    size_t length = 0;
+    if (rooted) {
+        out[length++] = '/';
+    }
+    size_t i = 0;
+    while (i < total) {
+        while (i < total && at(i) == '/') {
+            i++;
+        }
+        size_t start = i;
+        while (i < total && at(i) != '/') {
+            i++;
+        }
+        size_t segmentLength = i - start;
+        if (segmentLength == 0 || (segmentLength == 1 && at(start) == '.')) {
+            continue;
+        }
+        if (segmentLength == 2 && at(start) == '.' && at(start + 1) == '.') {
+            // 回退到上一个分隔符
+            while (length > floor && out[length - 1] != '/') {
+                length--;
+            }
+            if (length > floor) {
+                length--;
+            }
+            continue;
+        }
+        bool separator = length > floor;
+        if (length + separator + segmentLength > capacity) {
+            return StringView::npos;
+        }
+        if (separator) {
+            out[length++] = '/';
+        }
+        for (size_t k = start; k < i; k++) {
+            out[length++] = at(k);
+        }
+    }
+    return length;
+}
+
+std::string FilePath::Normalize(StringView path, StringView directory) {
+    // 结果不会比输入长，直接写入结果字符串
+    std::string result(directory.size() + path.size() + 1, '\0');
+    size_t length = Normalize(path, directory, &result[0], result.size());
+    result.resize(length == StringView::npos ? 0 : length);
+    return result;
+}
@@ -0,0 +1,112 @@
+//
+// Created by user on 2026/10/17.
+//
+
+#ifndef V8_LEARN_FILE_PATH_H
+#define V8_LEARN_FILE_PATH_H
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+/**
+ * 不持有内存的只读字符串视图，项目使用 C++14，没有 std::string_view。
+ * 只实现路径处理需要的操作，视图引用的内存由调用方保证有效。
+ */
+class StringView {
+public:
+    static const size_t npos = static_cast<size_t>(-1);
+
+    StringView() = default;
+    StringView(const char *data, size_t size) : _data(data), _size(size) {}
+    StringView(const char *data) : _data(data), _size(strlen(data)) {}
+    StringView(const std::string &value) : _data(value.data()), _size(value.size()) {}
+
+    const char *data() const { return _data; }
+    size_t size() const { return _size; }
+    bool empty() const { return _size == 0; }
+    char operator[](size_t index) const { return _data[index]; }
+    char back() const { return _data[_size - 1]; }
+
+    StringView substr(size_t pos, size_t count = npos) const {
+        if (pos > _size) {
+            pos = _size;
+        }
+        return StringView(_data + pos, count < _size - pos ? count : _size - pos);
+    }
+    size_t rfind(char c) const {
+        for (size_t i = _size; i > 0; i--) {
+            if (_data[i - 1] == c) {
+                return i - 1;
+            }
+        }
+        return npos;
+    }
+    bool startsWith(StringView prefix) const {
+        return _size >= prefix._size && memcmp(_data, prefix._data, prefix._size) == 0;
+    }
+    bool endsWith(StringView suffix) const {
+        return _size >= suffix._size && memcmp(_data + _size - suffix._size, suffix._data, suffix._size) == 0;
+    }
+    bool operator==(StringView other) const {
+        return _size == other._size && memcmp(_data, other._data, _size) == 0;
+    }
+    bool operator!=(StringView other) const { return !(*this == other); }
+    std::string toString() const { return std::string(_data, _size); }
+    /**
+     * 64 位 FNV-1a 哈希，用于以视图为键查找，不需要先构造 std::string
+     * @param seed 组合多个视图的哈希时传入前一个的结果
+     * @return
+     */
+    uint64_t hash(uint64_t seed = 14695981039346656037ULL) const {
+        for (size_t i = 0; i < _size; i++) {
+            seed ^= static_cast<unsigned char>(_data[i]);
+            seed *= 1099511628211ULL;
+        }
+        return seed;
+    }
+
+private:
+    const char *_data = "";
+    size_t _size = 0;
+};
+
+/**
+ * 不分配内存的路径处理，结果写入调用方提供的缓冲区（通常在栈上）或者返回原路径的子视图
+ */
+class FilePath {
+public:
+    // 栈上路径缓冲区的大小
+    static const size_t kMaxPath = 4096;
+
+    /**
+     * 判断是否为绝对路径
+     * @param path
+     * @return
+     */
+    static bool IsAbsolute(StringView path);
+    /**
+     * 获取路径上的目录名称，返回 path 的子视图。不是绝对路径时返回空
+     * @param path
+     * @return
+     */
+    static StringView DirName(StringView path);
+    /**
+     * 规范化路径：相对路径拼接到 directory 后，统一分隔符为 "/"，去掉 "."、".." 和重复的分隔符
+     * @param path
+     * @param directory path 是相对路径时使用
+     * @param out 输出缓冲区
+     * @param capacity 缓冲区大小
+     * @return 写入的长度，缓冲区不够时返回 StringView::npos
+     */
+    static size_t Normalize(StringView path, StringView directory, char *out, size_t capacity);
+    /**
+     * 规范化路径，只为结果分配一次内存
+     * @param path
+     * @param directory
+     * @return
+     */
+    static std::string Normalize(StringView path, StringView directory);
+};
+
+#endif//V8_LEARN_FILE_PATH_H
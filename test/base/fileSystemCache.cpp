@@ -0,0 +1,124 @@
+//
+// Created by user on 2026/10/17.
+//
+
+#include "fileSystemCache.h"
+#include <cstdlib>
+
+#if defined(LINUX)
+#include <climits>
+#include <sys/stat.h>
+#elif defined(WIN)
+#include <windows.h>
+#endif
+
+namespace {
+    /**
+     * 把视图复制到栈上的缓冲区，得到系统调用需要的以 '\0' 结尾的字符串
+     * @param path
+     * @param buffer
+     * @return 路径过长时返回 false
+     */
+    bool ToCString(StringView path, char (&buffer)[FilePath::kMaxPath]) {
+        if (path.size() >= FilePath::kMaxPath) {
+            return false;
+        }
+        memcpy(buffer, path.data(), path.size());
+        buffer[path.size()] = '\0';
+        return true;
+    }
+}// namespace
+
+FileSystemCache::Kind FileSystemCache::stat(StringView path) {
+    Kind *cached = _stats.find(path, StringView());
+    if (cached != nullptr) {
+        _hit_count++;
+        return *cached;
+    }
+    _stat_count++;
+    Kind kind = Kind::kNotFound;
+    char buffer[FilePath::kMaxPath];
+    if (ToCString(path, buffer)) {
+#if defined(LINUX)
+        struct stat st {};
+        if (::stat(buffer, &st) == 0) {
+            kind = S_ISDIR(st.st_mode) ? Kind::kDirectory : Kind::kFile;
+        }
+#elif defined(WIN)
+        DWORD attributes = GetFileAttributesA(buffer);
+        if (attributes != INVALID_FILE_ATTRIBUTES) {
+            kind = (attributes & FILE_ATTRIBUTE_DIRECTORY) ? Kind::kDirectory : Kind::kFile;
+        }
+#endif
+    }
+    _stats.insert(path, StringView(), kind);
+    return kind;
+}
+
+bool FileSystemCache::realPath(StringView path, std::string *out) {
+    std::string *cached = _real_paths.find(path, StringView());
+    if (cached != nullptr) {
+        _hit_count++;
+        if (cached->empty()) {
+            return false;
+        }
+        *out = *cached;
+        return true;
+    }
+    _real_path_count++;
+    std::string result;
+    char buffer[FilePath::kMaxPath];
+    if (ToCString(path, buffer)) {
+#if defined(LINUX)
+        char resolved[PATH_MAX];
+        if (::realpath(buffer, resolved) != nullptr) {
+            result = resolved;
+        }
+#elif defined(WIN)
+        char resolved[MAX_PATH];
+        DWORD length = GetFullPathNameA(buffer, MAX_PATH, resolved, nullptr);
+        if (length > 0 && length < MAX_PATH) {
+            result.assign(resolved, length);
+        }
+#else
+        result = path.toString();
+#endif
+    }
+    _real_paths.insert(path, StringView(), result);
+    if (result.empty()) {
+        return false;
+    }
+    *out = std::move(result);
+    return true;
+}
+
+const std::string *FileSystemCache::findResolved(StringView directory, StringView specifier) {
+    const std::string *cached = _resolved.find(directory, specifier);
+    if (cached != nullptr) {
+        _hit_count++;
+    }
+    return cached;
+}
+
+void FileSystemCache::setResolved(StringView directory, StringView specifier, const std::string &filename) {
+    _resolved.insert(directory, specifier, filename);
+}
+
+const std::string *FileSystemCache::findPackageMain(StringView directory) {
+    const std::string *cached = _package_mains.find(directory, StringView());
+    if (cached != nullptr) {
+        _hit_count++;
+    }
+    return cached;
+}
+
+const std::string &FileSystemCache::setPackageMain(StringView directory, const std::string &main) {
+    return _package_mains.insert(directory, StringView(), main);
+}
+
+void FileSystemCache::clear() {
+    _stats.clear();
+    _real_paths.clear();
+    _resolved.clear();
+    _package_mains.clear();
+}
@@ -0,0 +1,109 @@
+//
+// Created by user on 2026/10/17.
+//
+
+#ifndef V8_LEARN_FILE_SYSTEM_CACHE_H
+#define V8_LEARN_FILE_SYSTEM_CACHE_H
+#include "filePath.h"
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+/**
+ * 文件系统查询的缓存，用于模块解析。
+ * 缓存 stat、realpath 的结果，以及 (目录, 说明符) 到解析结果、包目录到 package.json main 的映射，
+ * 同一个路径只做一次系统调用。以路径视图的哈希为键查找，命中时不构造 std::string。
+ * 缓存不会感知文件的变化，文件变化后需要 clear。不是线程安全的，每个隔离实例线程使用自己的缓存。
+ */
+class FileSystemCache {
+public:
+    enum class Kind : uint8_t {
+        kNotFound,
+        kFile,
+        kDirectory,
+    };
+
+    /**
+     * 查询路径的类型
+     * @param path
+     * @return
+     */
+    Kind stat(StringView path);
+    /**
+     * 解析符号链接得到真实路径
+     * @param path
+     * @param out
+     * @return 路径不存在时返回 false
+     */
+    bool realPath(StringView path, std::string *out);
+    /**
+     * 查找说明符在目录下的解析结果，没有时返回 nullptr
+     * @param directory
+     * @param specifier
+     * @return
+     */
+    const std::string *findResolved(StringView directory, StringView specifier);
+    void setResolved(StringView directory, StringView specifier, const std::string &filename);
+    /**
+     * 查找包目录的 package.json main 字段，没有缓存时返回 nullptr，没有 main 时返回空字符串
+     * @param directory
+     * @return
+     */
+    const std::string *findPackageMain(StringView directory);
+    const std::string &setPackageMain(StringView directory, const std::string &main);
+    void clear();
+
+    uint64_t getStatCount() const { return _stat_count; }
+    uint64_t getRealPathCount() const { return _real_path_count; }
+    uint64_t getHitCount() const { return _hit_count; }
+
+private:
+    /**
+     * 以一个或两个路径视图为键的表
+     */
+    template<typename T>
+    class PathTable {
+    public:
+        T *find(StringView first, StringView second) {
+            auto range = _entries.equal_range(Hash(first, second));
+            for (auto it = range.first; it != range.second; ++it) {
+                const std::string &key = it->second.first;
+                if (key.size() == first.size() + 1 + second.size() &&
+                    StringView(key.data(), first.size()) == first &&
+                    StringView(key.data() + first.size() + 1, second.size()) == second) {
+                    return &it->second.second;
+                }
+            }
+            return nullptr;
+        }
+        T &insert(StringView first, StringView second, T value) {
+            T *existing = find(first, second);
+            if (existing != nullptr) {
+                *existing = std::move(value);
+                return *existing;
+            }
+            std::string key;
+            key.reserve(first.size() + 1 + second.size());
+            key.append(first.data(), first.size()).append(1, '\0').append(second.data(), second.size());
+            return _entries.emplace(Hash(first, second), std::make_pair(std::move(key), std::move(value)))->second.second;
+        }
+        void clear() { _entries.clear(); }
+
+    private:
+        static uint64_t Hash(StringView first, StringView second) {
+            return second.hash(StringView("", 1).hash(first.hash()));
+        }
+        std::unordered_multimap<uint64_t, std::pair<std::string, T>> _entries;
+    };
+
+    PathTable<Kind> _stats;
+    // 真实路径，路径不存在时为空字符串
+    PathTable<std::string> _real_paths;
+    PathTable<std::string> _resolved;
+    PathTable<std::string> _package_mains;
+    uint64_t _stat_count = 0;
+    uint64_t _real_path_count = 0;
+    uint64_t _hit_count = 0;
+};
+
+#endif//V8_LEARN_FILE_SYSTEM_CACHE_H
@@ -0,0 +1,103 @@
+//
+// Created by user on 2026/10/17.
+//
+
+#include "heapTelemetry.h"
+#include "isolateCallbacks.h"
+
+const char *const HeapTelemetry::kGCTypeNames[kGCTypeCount] = {"scavenge", "mark_sweep_compact", "incremental_marking",
+                                                                "process_weak_callbacks"};
+
+namespace {
+    // 按常量名映射，不按位的下标映射，顺序与 kGCTypeNames 相同
+    const int kTypes[] = {v8::kGCTypeScavenge, v8::kGCTypeMarkSweepCompact, v8::kGCTypeIncrementalMarking,
+                          v8::kGCTypeProcessWeakCallbacks};
+}// namespace
+
+HeapTelemetry::HeapTelemetry(v8::Isolate *isolate) : _isolate(isolate) {
+    v8::HeapStatistics heap;
+    isolate->GetHeapStatistics(&heap);
+    _start_peak_malloced_memory = heap.peak_malloced_memory();
+    IsolateCallbacks::AddGCPrologueCallback(isolate, OnPrologue, this);
+    IsolateCallbacks::AddGCEpilogueCallback(isolate, OnEpilogue, this);
+}
+
+HeapTelemetry::~HeapTelemetry() {
+    IsolateCallbacks::RemoveGCPrologueCallback(_isolate, OnPrologue, this);
+    IsolateCallbacks::RemoveGCEpilogueCallback(_isolate, OnEpilogue, this);
+}
+
+int HeapTelemetry::TypeIndex(v8::GCType type) {
+    for (int i = 0; i < kGCTypeCount; i++) {
+        if (type & kTypes[i]) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+void HeapTelemetry::OnPrologue(v8::Isolate *isolate, v8::GCType type, v8::GCCallbackFlags flags, void *data) {
+    auto *telemetry = static_cast<HeapTelemetry *>(data);
+    int index = TypeIndex(type);
+    if (index >= 0) {
+        telemetry->_start[index] = std::chrono::steady_clock::now();
+    }
+}
+
+void HeapTelemetry::OnEpilogue(v8::Isolate *isolate, v8::GCType type, v8::GCCallbackFlags flags, void *data) {
+    auto *telemetry = static_cast<HeapTelemetry *>(data);
+    int index = TypeIndex(type);
+    if (index < 0) {
+        return;
+    }
+    double pause = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - telemetry->_start[index]).count();
+    telemetry->_count[index]++;
+    telemetry->_pause[index] += pause;
+    if (pause > telemetry->_max_pause) {
+        telemetry->_max_pause = pause;
+    }
+}
+
+void HeapTelemetry::writeJsonLine(FILE *out, const std::string &name, const std::string &extra) {
+    fprintf(out, "{\"name\": \"");
+    for (char c : name) {
+        if (c == '"' || c == '\\') {
+            fputc('\\', out);
+        }
+        fputc(c, out);
+    }
+    fprintf(out, "\", \"gc\": {");
+    double totalPause = 0;
+    for (int i = 0; i < kGCTypeCount; i++) {
+        totalPause += _pause[i];
+        fprintf(out, "\"%s\": {\"count\": %llu, \"pause_ms\": %.3f}, ", kGCTypeNames[i],
+                static_cast<unsigned long long>(_count[i]), _pause[i]);
+    }
+    fprintf(out, "\"total_pause_ms\": %.3f, \"max_pause_ms\": %.3f}", totalPause, _max_pause);
+
+    v8::HeapStatistics heap;
+    _isolate->GetHeapStatistics(&heap);
+    fprintf(out, ", \"heap\": {\"total_heap_size\": %zu, \"total_physical_size\": %zu, \"used_heap_size\": %zu, "
+                 "\"heap_size_limit\": %zu, \"malloced_memory\": %zu, \"peak_malloced_memory_growth\": %zu, \"external_memory\": %zu, "
+                 "\"total_global_handles_size\": %zu, \"used_global_handles_size\": %zu, "
+                 "\"number_of_native_contexts\": %zu, \"number_of_detached_contexts\": %zu}",
+            heap.total_heap_size(), heap.total_physical_size(), heap.used_heap_size(),
+            heap.heap_size_limit(), heap.malloced_memory(), heap.peak_malloced_memory() - _start_peak_malloced_memory, heap.external_memory(),
+            heap.total_global_handles_size(), heap.used_global_handles_size(),
+            heap.number_of_native_contexts(), heap.number_of_detached_contexts());
+
+    fprintf(out, ", \"spaces\": {");
+    for (size_t i = 0; i < _isolate->NumberOfHeapSpaces(); i++) {
+        v8::HeapSpaceStatistics space;
+        _isolate->GetHeapSpaceStatistics(&space, i);
+        fprintf(out, "%s\"%s\": {\"size\": %zu, \"used\": %zu, \"available\": %zu, \"physical\": %zu}", i == 0 ? "" : ", ",
+                space.space_name(), space.space_size(), space.space_used_size(), space.space_available_size(),
+                space.physical_space_size());
+    }
+    fprintf(out, "}");
+    if (!extra.empty()) {
+        fprintf(out, ", %s", extra.c_str());
+    }
+    fprintf(out, "}\n");
+    fflush(out);
+}
@@ -0,0 +1,54 @@
+//
+// Created by user on 2026/10/17.
+//
+
+#ifndef V8_LEARN_HEAP_TELEMETRY_H
+#define V8_LEARN_HEAP_TELEMETRY_H
+#include "v8.h"
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+/**
+ * 隔离实例的堆和 GC 统计。
+ * 构造时注册 GC 前后回调记录每种 GC 的次数和停顿时间，析构时移除回调；
+ * writeJsonLine 把 GC 统计、堆统计和各个空间的统计写成一行 JSON。
+ */
+class HeapTelemetry {
+public:
+    explicit HeapTelemetry(v8::Isolate *isolate);
+    ~HeapTelemetry();
+    HeapTelemetry(const HeapTelemetry &) = delete;
+    HeapTelemetry &operator=(const HeapTelemetry &) = delete;
+
+    /**
+     * 写出一行 JSON
+     * @param out
+     * @param name 记录的名称，通常是测试名称
+     * @param extra 追加到对象末尾的字段，格式为 "\"key\": value"，为空时不追加
+     */
+    void writeJsonLine(FILE *out, const std::string &name, const std::string &extra = "");
+
+private:
+    // 每种 v8::GCType 一个统计槽位，顺序与 kGCTypeNames 相同
+    static const int kGCTypeCount = 4;
+    static const char *const kGCTypeNames[kGCTypeCount];
+    /**
+     * @param type
+     * @return 未知的类型返回 -1
+     */
+    static int TypeIndex(v8::GCType type);
+    static void OnPrologue(v8::Isolate *isolate, v8::GCType type, v8::GCCallbackFlags flags, void *data);
+    static void OnEpilogue(v8::Isolate *isolate, v8::GCType type, v8::GCCallbackFlags flags, void *data);
+
+    v8::Isolate *_isolate;
+    // 构造时的 peak_malloced_memory，v8 不能重置峰值，只输出统计期间的增长
+    size_t _start_peak_malloced_memory = 0;
+    std::chrono::steady_clock::time_point _start[kGCTypeCount];
+    uint64_t _count[kGCTypeCount] = {};
+    // 单位为毫秒
+    double _pause[kGCTypeCount] = {};
+    double _max_pause = 0;
+};
+
+#endif//V8_LEARN_HEAP_TELEMETRY_H
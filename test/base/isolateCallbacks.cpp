@@ -0,0 +1,114 @@
+//
+// Created by user on 2026/10/17.
+//
+
+#include "isolateCallbacks.h"
+#include "embedderData.h"
+#include <algorithm>
+
+IsolateCallbacks *IsolateCallbacks::Get(v8::Isolate *isolate, bool create) {
+    auto *callbacks = static_cast<IsolateCallbacks *>(isolate->GetData(IsolateDataIndex::kIsolateCallbacks));
+    if (callbacks == nullptr && create) {
+        callbacks = new IsolateCallbacks();
+        isolate->SetData(IsolateDataIndex::kIsolateCallbacks, callbacks);
+    }
+    return callbacks;
+}
+
+template<typename Callback>
+bool IsolateCallbacks::Erase(Entries<Callback> &entries, Callback callback, void *data) {
+    auto it = std::find(entries.begin(), entries.end(), std::make_pair(callback, data));
+    if (it == entries.end()) {
+        return false;
+    }
+    entries.erase(it);
+    return true;
+}
+
+void IsolateCallbacks::AddMessageListener(v8::Isolate *isolate, v8::MessageCallback callback, int messageLevels) {
+    isolate->AddMessageListenerWithErrorLevel(callback, messageLevels);
+    Get(isolate, true)->_message_listeners.push_back(callback);
+}
+
+void IsolateCallbacks::RemoveMessageListener(v8::Isolate *isolate, v8::MessageCallback callback) {
+    isolate->RemoveMessageListeners(callback);
+    IsolateCallbacks *callbacks = Get(isolate, false);
+    if (callbacks != nullptr) {
+        std::vector<v8::MessageCallback> &listeners = callbacks->_message_listeners;
+        listeners.erase(std::remove(listeners.begin(), listeners.end(), callback), listeners.end());
+    }
+}
+
+void IsolateCallbacks::AddGCPrologueCallback(v8::Isolate *isolate, v8::Isolate::GCCallbackWithData callback, void *data) {
+    isolate->AddGCPrologueCallback(callback, data);
+    Get(isolate, true)->_gc_prologue_callbacks.emplace_back(callback, data);
+}
+
+void IsolateCallbacks::RemoveGCPrologueCallback(v8::Isolate *isolate, v8::Isolate::GCCallbackWithData callback, void *data) {
+    // v8 移除没有注册的 GC 回调时会崩溃，已经被 Reset 移除的不再移除
+    IsolateCallbacks *callbacks = Get(isolate, false);
+    if (callbacks != nullptr && Erase(callbacks->_gc_prologue_callbacks, callback, data)) {
+        isolate->RemoveGCPrologueCallback(callback, data);
+    }
+}
+
+void IsolateCallbacks::AddGCEpilogueCallback(v8::Isolate *isolate, v8::Isolate::GCCallbackWithData callback, void *data) {
+    isolate->AddGCEpilogueCallback(callback, data);
+    Get(isolate, true)->_gc_epilogue_callbacks.emplace_back(callback, data);
+}
+
+void IsolateCallbacks::RemoveGCEpilogueCallback(v8::Isolate *isolate, v8::Isolate::GCCallbackWithData callback, void *data) {
+    IsolateCallbacks *callbacks = Get(isolate, false);
+    if (callbacks != nullptr && Erase(callbacks->_gc_epilogue_callbacks, callback, data)) {
+        isolate->RemoveGCEpilogueCallback(callback, data);
+    }
+}
+
+void IsolateCallbacks::AddMicrotasksCompletedCallback(v8::Isolate *isolate, v8::MicrotasksCompletedCallbackWithData callback, void *data) {
+    isolate->AddMicrotasksCompletedCallback(callback, data);
+    Get(isolate, true)->_microtasks_completed_callbacks.emplace_back(callback, data);
+}
+
+void IsolateCallbacks::RemoveMicrotasksCompletedCallback(v8::Isolate *isolate, v8::MicrotasksCompletedCallbackWithData callback, void *data) {
+    IsolateCallbacks *callbacks = Get(isolate, false);
+    if (callbacks != nullptr && Erase(callbacks->_microtasks_completed_callbacks, callback, data)) {
+        isolate->RemoveMicrotasksCompletedCallback(callback, data);
+    }
+}
+
+size_t IsolateCallbacks::Count(v8::Isolate *isolate) {
+    IsolateCallbacks *callbacks = Get(isolate, false);
+    if (callbacks == nullptr) {
+        return 0;
+    }
+    return callbacks->_message_listeners.size() + callbacks->_gc_prologue_callbacks.size() +
+           callbacks->_gc_epilogue_callbacks.size() + callbacks->_microtasks_completed_callbacks.size();
+}
+
+void IsolateCallbacks::Reset(v8::Isolate *isolate) {
+    IsolateCallbacks *callbacks = Get(isolate, false);
+    if (callbacks == nullptr) {
+        return;
+    }
+    for (v8::MessageCallback callback : callbacks->_message_listeners) {
+        isolate->RemoveMessageListeners(callback);
+    }
+    for (auto &entry : callbacks->_gc_prologue_callbacks) {
+        isolate->RemoveGCPrologueCallback(entry.first, entry.second);
+    }
+    for (auto &entry : callbacks->_gc_epilogue_callbacks) {
+        isolate->RemoveGCEpilogueCallback(entry.first, entry.second);
+    }
+    for (auto &entry : callbacks->_microtasks_completed_callbacks) {
+        isolate->RemoveMicrotasksCompletedCallback(entry.first, entry.second);
+    }
+    callbacks->_message_listeners.clear();
+    callbacks->_gc_prologue_callbacks.clear();
+    callbacks->_gc_epilogue_callbacks.clear();
+    callbacks->_microtasks_completed_callbacks.clear();
+}
+
+void IsolateCallbacks::Dispose(v8::Isolate *isolate) {
+    delete Get(isolate, false);
+    isolate->SetData(IsolateDataIndex::kIsolateCallbacks, nullptr);
+}
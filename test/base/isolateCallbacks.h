@@ -0,0 +1,74 @@
+//
+// Created by user on 2026/10/17.
+//
+
+#ifndef V8_LEARN_ISOLATE_CALLBACKS_H
+#define V8_LEARN_ISOLATE_CALLBACKS_H
+#include "v8.h"
+#include <utility>
+#include <vector>
+
+/**
+ * 记录隔离实例上注册的回调。
+ * v8 只能按回调函数移除消息监听、GC 回调和微任务完成回调，没有一次清除的接口，
+ * 通过这里注册的回调在隔离实例归还到池中时由 Reset 全部移除（IsolatePool::resetIsolate）。
+ * 记录保存在隔离实例数据 kIsolateCallbacks 中，只能在隔离实例所在的线程上使用。
+ */
+class IsolateCallbacks {
+public:
+    static void AddMessageListener(v8::Isolate *isolate, v8::MessageCallback callback,
+                                   int messageLevels = v8::Isolate::kMessageError);
+    /**
+     * 移除该回调注册的所有消息监听，与 Isolate::RemoveMessageListeners 相同
+     * @param isolate
+     * @param callback
+     */
+    static void RemoveMessageListener(v8::Isolate *isolate, v8::MessageCallback callback);
+    static void AddGCPrologueCallback(v8::Isolate *isolate, v8::Isolate::GCCallbackWithData callback, void *data);
+    static void RemoveGCPrologueCallback(v8::Isolate *isolate, v8::Isolate::GCCallbackWithData callback, void *data);
+    static void AddGCEpilogueCallback(v8::Isolate *isolate, v8::Isolate::GCCallbackWithData callback, void *data);
+    static void RemoveGCEpilogueCallback(v8::Isolate *isolate, v8::Isolate::GCCallbackWithData callback, void *data);
+    static void AddMicrotasksCompletedCallback(v8::Isolate *isolate, v8::MicrotasksCompletedCallbackWithData callback, void *data);
+    static void RemoveMicrotasksCompletedCallback(v8::Isolate *isolate, v8::MicrotasksCompletedCallbackWithData callback, void *data);
+
+    /**
+     * 当前仍然注册着的回调数量
+     * @param isolate
+     * @return
+     */
+    static size_t Count(v8::Isolate *isolate);
+    /**
+     * 移除所有记录的回调，调用方需要持有该隔离实例的锁
+     * @param isolate
+     */
+    static void Reset(v8::Isolate *isolate);
+    /**
+     * 释放记录，在 Isolate::Dispose 之前调用，回调随隔离实例一起销毁。没有注册过回调时什么也不做
+     * @param isolate
+     */
+    static void Dispose(v8::Isolate *isolate);
+
+private:
+    template<typename Callback>
+    using Entries = std::vector<std::pair<Callback, void *>>;
+
+    /**
+     * @param isolate
+     * @param create 为 true 时不存在则创建
+     * @return
+     */
+    static IsolateCallbacks *Get(v8::Isolate *isolate, bool create);
+    /**
+     * 从记录中删除一项
+     * @return 记录中没有该项时返回 false，此时不能再从 v8 中移除
+     */
+    template<typename Callback>
+    static bool Erase(Entries<Callback> &entries, Callback callback, void *data);
+
+    std::vector<v8::MessageCallback> _message_listeners;
+    Entries<v8::Isolate::GCCallbackWithData> _gc_prologue_callbacks;
+    Entries<v8::Isolate::GCCallbackWithData> _gc_epilogue_callbacks;
+    Entries<v8::MicrotasksCompletedCallbackWithData> _microtasks_completed_callbacks;
+};
+
+#endif//V8_LEARN_ISOLATE_CALLBACKS_H
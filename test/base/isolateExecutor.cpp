@@ -0,0 +1,227 @@
+//
+// Created by user on 2026/10/17.
+//
+
+#include "isolateExecutor.h"
+#include "arrayBufferAllocator.h"
+#include "libplatform/libplatform.h"
+#include "nodeBuildInModule.h"
+#include "snapshot.h"
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+
+IsolateExecutor::IsolateExecutor(size_t workerCount, std::string setupSource, v8::Platform *platform)
+    : _setup_source(std::move(setupSource)), _platform(platform) {
+    if (workerCount == 0) {
+        workerCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    for (size_t i = 0; i < workerCount; i++) {
+        _workers.emplace_back(new Worker());
+    }
+    for (size_t i = 0; i < workerCount; i++) {
+        _workers[i]->thread = std::thread(&IsolateExecutor::work, this, i);
+    }
+}
+
+IsolateExecutor::~IsolateExecutor() {
+    for (std::unique_ptr<Worker> &worker : _workers) {
+        {
+            std::lock_guard<std::mutex> lock(worker->mutex);
+            worker->stopping = true;
+        }
+        worker->condition.notify_one();
+    }
+    for (std::unique_ptr<Worker> &worker : _workers) {
+        worker->thread.join();
+    }
+}
+
+std::future<IsolateExecutor::Result> IsolateExecutor::evaluate(std::string source) {
+    std::unique_ptr<Job> job(new Job());
+    job->source = std::move(source);
+    return submit(std::move(job));
+}
+
+std::future<IsolateExecutor::Result> IsolateExecutor::call(std::string function, std::vector<uint8_t> arguments) {
+    std::unique_ptr<Job> job(new Job());
+    job->function = std::move(function);
+    job->arguments = std::move(arguments);
+    return submit(std::move(job));
+}
+
+size_t IsolateExecutor::getPendingCount() const {
+    size_t pending = 0;
+    for (const std::unique_ptr<Worker> &worker : _workers) {
+        pending += worker->pending.load();
+    }
+    return pending;
+}
+
+std::future<IsolateExecutor::Result> IsolateExecutor::submit(std::unique_ptr<Job> job) {
+    std::future<Result> future = job->promise.get_future();
+    // 从轮转的起点开始找排队任务最少的工作线程，负载读取不加锁，只是近似值
+    size_t start = _next.fetch_add(1) % _workers.size();
+    size_t selected = start;
+    size_t least = std::numeric_limits<size_t>::max();
+    for (size_t i = 0; i < _workers.size(); i++) {
+        size_t index = (start + i) % _workers.size();
+        size_t pending = _workers[index]->pending.load(std::memory_order_relaxed);
+        if (pending < least) {
+            least = pending;
+            selected = index;
+            if (pending == 0) {
+                break;
+            }
+        }
+    }
+    Worker *worker = _workers[selected].get();
+    worker->pending++;
+    {
+        std::lock_guard<std::mutex> lock(worker->mutex);
+        worker->jobs.push_back(std::move(job));
+    }
+    worker->condition.notify_one();
+    return future;
+}
+
+void IsolateExecutor::work(size_t index) {
+    Worker *worker = _workers[index].get();
+    // 隔离实例在工作线程上创建、使用和销毁，从不跨线程，所以不需要 Locker
+    v8::Isolate::CreateParams create_params;
+    Snapshot::InitCreateParams(create_params);
+    std::unique_ptr<PooledArrayBufferAllocator> allocator(new PooledArrayBufferAllocator());
+    create_params.array_buffer_allocator = allocator.get();
+    v8::Isolate *isolate = v8::Isolate::New(create_params);
+    {
+        v8::Isolate::Scope isolateScope(isolate);
+        v8::HandleScope handleScope(isolate);
+        v8::Local<v8::Context> context = v8::Context::New(isolate);
+        v8::Context::Scope contextScope(context);
+        // 预热脚本失败时该工作线程上的所有任务都以同一个错误失败
+        std::string setupError;
+        if (!_setup_source.empty()) {
+            v8::TryCatch tryCatch(isolate);
+            v8::Local<v8::String> source;
+            v8::Local<v8::Script> script;
+            if (!v8::String::NewFromUtf8(isolate, _setup_source.data(), v8::NewStringType::kNormal, static_cast<int>(_setup_source.size())).ToLocal(&source) ||
+                !v8::Script::Compile(context, source).ToLocal(&script) || script->Run(context).IsEmpty()) {
+                v8::String::Utf8Value message(isolate, tryCatch.Exception());
+                setupError = *message == nullptr ? "setup failed" : *message;
+            }
+        }
+        while (true) {
+            std::unique_ptr<Job> job;
+            {
+                std::unique_lock<std::mutex> lock(worker->mutex);
+                worker->condition.wait(lock, [worker]() -> bool { return worker->stopping || !worker->jobs.empty(); });
+                if (worker->jobs.empty()) {
+                    break;
+                }
+                job = std::move(worker->jobs.front());
+                worker->jobs.pop_front();
+            }
+            Result result;
+            if (setupError.empty()) {
+                result = Run(context, job.get());
+            } else {
+                result.error = setupError;
+            }
+            result.worker = index;
+            if (_platform != nullptr) {
+                while (v8::platform::PumpMessageLoop(_platform, isolate)) {
+                }
+            }
+            worker->executed++;
+            worker->pending--;
+            job->promise.set_value(std::move(result));
+        }
+    }
+    disposeBuildInModuleTemplates(isolate);
+    isolate->Dispose();
+}
+
+IsolateExecutor::Result IsolateExecutor::Run(v8::Local<v8::Context> context, Job *job) {
+    v8::Isolate *isolate = context->GetIsolate();
+    v8::HandleScope handleScope(isolate);
+    v8::TryCatch tryCatch(isolate);
+    Result result;
+    v8::Local<v8::Value> value;
+    if (job->function.empty()) {
+        v8::Local<v8::String> source;
+        v8::Local<v8::Script> script;
+        if (v8::String::NewFromUtf8(isolate, job->source.data(), v8::NewStringType::kNormal, static_cast<int>(job->source.size())).ToLocal(&source) &&
+            v8::Script::Compile(context, source).ToLocal(&script)) {
+            script->Run(context).ToLocal(&value);
+        }
+    } else {
+        v8::Local<v8::String> name;
+        v8::Local<v8::Value> function;
+        std::vector<v8::Local<v8::Value>> argv;
+        v8::Local<v8::Value> arguments;
+        if (!job->arguments.empty() && Deserialize(context, job->arguments).ToLocal(&arguments) && arguments->IsArray()) {
+            v8::Local<v8::Array> array = arguments.As<v8::Array>();
+            for (uint32_t i = 0; i < array->Length(); i++) {
+                argv.push_back(array->Get(context, i).ToLocalChecked());
+            }
+        }
+        if (!tryCatch.HasCaught() &&
+            v8::String::NewFromUtf8(isolate, job->function.c_str()).ToLocal(&name) &&
+            context->Global()->Get(context, name).ToLocal(&function)) {
+            if (function->IsFunction()) {
+                function.As<v8::Function>()->Call(context, context->Global(), static_cast<int>(argv.size()), argv.data()).ToLocal(&value);
+            } else {
+                std::string message = job->function + " is not a function";
+                isolate->ThrowException(v8::Exception::TypeError(v8::String::NewFromUtf8(isolate, message.c_str()).ToLocalChecked()));
+            }
+        }
+    }
+    // 返回 promise 时执行微任务，只等待同步就能完成的 promise
+    if (!value.IsEmpty() && value->IsPromise()) {
+        isolate->PerformMicrotaskCheckpoint();
+        v8::Local<v8::Promise> promise = value.As<v8::Promise>();
+        if (promise->State() == v8::Promise::kFulfilled) {
+            value = promise->Result();
+        } else if (promise->State() == v8::Promise::kRejected) {
+            isolate->ThrowException(promise->Result());
+            value.Clear();
+        } else {
+            isolate->ThrowException(v8::Exception::Error(v8::String::NewFromUtf8Literal(isolate, "promise is still pending")));
+            value.Clear();
+        }
+    }
+    if (!value.IsEmpty() && Serialize(context, value, &result.value)) {
+        result.success = true;
+        return result;
+    }
+    if (tryCatch.HasCaught()) {
+        v8::String::Utf8Value message(isolate, tryCatch.Exception());
+        result.error = *message == nullptr ? "unknown error" : *message;
+    } else {
+        result.error = "execution terminated";
+    }
+    return result;
+}
+
+bool IsolateExecutor::Serialize(v8::Local<v8::Context> context, v8::Local<v8::Value> value, std::vector<uint8_t> *out) {
+    v8::ValueSerializer serializer(context->GetIsolate());
+    serializer.WriteHeader();
+    if (!serializer.WriteValue(context, value).FromMaybe(false)) {
+        return false;
+    }
+    std::pair<uint8_t *, size_t> buffer = serializer.Release();
+    out->assign(buffer.first, buffer.first + buffer.second);
+    // 默认的序列化代理使用 realloc 分配缓冲区
+    free(buffer.first);
+    return true;
+}
+
+v8::MaybeLocal<v8::Value> IsolateExecutor::Deserialize(v8::Local<v8::Context> context, const std::vector<uint8_t> &data) {
+    v8::EscapableHandleScope handleScope(context->GetIsolate());
+    v8::ValueDeserializer deserializer(context->GetIsolate(), data.data(), data.size());
+    v8::Local<v8::Value> value;
+    if (!deserializer.ReadHeader(context).FromMaybe(false) || !deserializer.ReadValue(context).ToLocal(&value)) {
+        return v8::MaybeLocal<v8::Value>();
+    }
+    return handleScope.Escape(value);
+}
@@ -0,0 +1,132 @@
+//
+// Created by user on 2026/10/17.
+//
+
+#ifndef V8_LEARN_ISOLATE_EXECUTOR_H
+#define V8_LEARN_ISOLATE_EXECUTOR_H
+#include "v8.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * 多隔离实例的脚本执行器。
+ * 每个工作线程独占一个隔离实例和一个预热好的上下文，隔离实例只在自己的线程上使用，不需要 Locker，
+ * CPU 密集的 js 吞吐量随工作线程数量增长，而不是被一个隔离实例的锁限制在单核上。
+ * 任务提交给排队任务最少的工作线程，参数和结果都是 ValueSerializer 序列化后的数据，不依赖提交方的隔离实例。
+ * 同一个工作线程上的任务共享上下文，任务之间可以通过全局变量互相影响，预热脚本定义的函数对所有任务可见。
+ */
+class IsolateExecutor {
+public:
+    /**
+     * 任务的执行结果
+     */
+    struct Result {
+        bool success = false;
+        // 成功时为序列化的返回值，返回 promise 时为兑现的值
+        std::vector<uint8_t> value;
+        // 失败时为异常的字符串形式
+        std::string error;
+        // 执行任务的工作线程下标
+        size_t worker = 0;
+    };
+
+    /**
+     * @param workerCount 工作线程数量，为 0 时使用硬件线程数
+     * @param setupSource 每个上下文创建后执行一次的预热脚本，通常用于定义 call 调用的函数
+     * @param platform 用于执行隔离实例的前台任务，为空时不执行
+     */
+    explicit IsolateExecutor(size_t workerCount = 0, std::string setupSource = "", v8::Platform *platform = nullptr);
+    /**
+     * 执行完所有已经提交的任务后退出工作线程
+     */
+    ~IsolateExecutor();
+    IsolateExecutor(const IsolateExecutor &) = delete;
+    IsolateExecutor &operator=(const IsolateExecutor &) = delete;
+
+    /**
+     * 把 source 作为经典脚本执行
+     * @param source
+     * @return
+     */
+    std::future<Result> evaluate(std::string source);
+    /**
+     * 调用全局函数
+     * @param function 全局函数的名称
+     * @param arguments 序列化的参数数组，为空时不传参数，见 Serialize
+     * @return
+     */
+    std::future<Result> call(std::string function, std::vector<uint8_t> arguments = {});
+
+    /**
+     * 在当前上下文中序列化值，用于构造 call 的参数
+     * @param context
+     * @param value
+     * @param out
+     * @return
+     */
+    static bool Serialize(v8::Local<v8::Context> context, v8::Local<v8::Value> value, std::vector<uint8_t> *out);
+    /**
+     * 在当前上下文中反序列化结果
+     * @param context
+     * @param data
+     * @return
+     */
+    static v8::MaybeLocal<v8::Value> Deserialize(v8::Local<v8::Context> context, const std::vector<uint8_t> &data);
+
+    size_t getWorkerCount() const { return _workers.size(); }
+    /**
+     * 工作线程已经执行的任务数量
+     * @param worker
+     * @return
+     */
+    uint64_t getExecutedCount(size_t worker) const { return _workers[worker]->executed.load(); }
+    /**
+     * 所有工作线程排队和执行中的任务数量
+     * @return
+     */
+    size_t getPendingCount() const;
+
+private:
+    struct Job {
+        // 为空时执行 source，否则调用名为 function 的全局函数
+        std::string function;
+        std::string source;
+        std::vector<uint8_t> arguments;
+        std::promise<Result> promise;
+    };
+    struct Worker {
+        std::mutex mutex;
+        std::condition_variable condition;
+        std::deque<std::unique_ptr<Job>> jobs;
+        // 排队和执行中的任务数量，用于选择负载最少的工作线程
+        std::atomic<size_t> pending{0};
+        std::atomic<uint64_t> executed{0};
+        bool stopping = false;
+        std::thread thread;
+    };
+
+    std::future<Result> submit(std::unique_ptr<Job> job);
+    void work(size_t index);
+    /**
+     * 在工作线程的上下文中执行任务
+     * @param context
+     * @param job
+     * @return
+     */
+    static Result Run(v8::Local<v8::Context> context, Job *job);
+
+    const std::string _setup_source;
+    v8::Platform *_platform;
+    std::vector<std::unique_ptr<Worker>> _workers;
+    // 负载相同时轮流选择，避免总是选中第一个工作线程
+    std::atomic<size_t> _next{0};
+};
+
+#endif//V8_LEARN_ISOLATE_EXECUTOR_H
@@ -0,0 +1,179 @@
+//
+// Created by user on 2026/10/17.
+//
+
+#include "isolatePool.h"
+#include "isolateCallbacks.h"
+#include "nodeBuildInModule.h"
+#include "numaPageAllocator.h"
+#include "snapshot.h"
+
+IsolatePool::IsolatePool(size_t size, ThreadPlacement placement) : _size(size), _placement(std::move(placement)) {
+    _refill_thread = std::thread(&IsolatePool::refill, this);
+}
+
+IsolatePool::~IsolatePool() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+    _condition.notify_all();
+    _refill_thread.join();
+    // 后台线程已经退出，剩余的隔离实例全部在当前线程销毁
+    for (std::deque<v8::Isolate *> *queue : {&_idle, &_recycled, &_retired}) {
+        while (!queue->empty()) {
+            v8::Isolate *isolate = queue->front();
+            queue->pop_front();
+            disposeIsolate(isolate);
+        }
+    }
+}
+
+v8::Isolate *IsolatePool::acquire() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!_idle.empty()) {
+            v8::Isolate *isolate = _idle.front();
+            _idle.pop_front();
+            _hit_count++;
+            // 复用的隔离实例从取出时开始统计峰值
+            _allocators[isolate]->resetPeakBytes();
+            // 唤醒后台线程补充空闲隔离实例
+            _condition.notify_one();
+            return isolate;
+        }
+    }
+    _miss_count++;
+    return createIsolate();
+}
+
+void IsolatePool::release(v8::Isolate *isolate, bool reusable) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (reusable) {
+            _recycled.push_back(isolate);
+        } else {
+            _retired.push_back(isolate);
+        }
+    }
+    _condition.notify_one();
+}
+
+PooledArrayBufferAllocator *IsolatePool::getArrayBufferAllocator(v8::Isolate *isolate) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _allocators.find(isolate);
+    return it == _allocators.end() ? nullptr : it->second;
+}
+
+size_t IsolatePool::getIdleCount() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _idle.size();
+}
+
+v8::Isolate *IsolatePool::createIsolate() {
+    v8::Isolate::CreateParams create_params;
+    Snapshot::InitCreateParams(create_params);
+    auto *allocator = new PooledArrayBufferAllocator();
+    create_params.array_buffer_allocator = allocator;
+    // 堆的地址空间在创建时保留，创建期间把当前线程切换到池的节点
+    int node = NumaPageAllocator::GetThreadNode();
+    if (_placement.numaNode >= 0) {
+        NumaPageAllocator::SetThreadNode(_placement.numaNode);
+    }
+    v8::Isolate *isolate = v8::Isolate::New(create_params);
+    NumaPageAllocator::SetThreadNode(node);
+    std::lock_guard<std::mutex> lock(_mutex);
+    _allocators[isolate] = allocator;
+    return isolate;
+}
+
+void IsolatePool::disposeIsolate(v8::Isolate *isolate) {
+    IsolateCallbacks::Dispose(isolate);
+    disposeBuildInModuleTemplates(isolate);
+    isolate->Dispose();
+    PooledArrayBufferAllocator *allocator = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto it = _allocators.find(isolate);
+        if (it != _allocators.end()) {
+            allocator = it->second;
+            _allocators.erase(it);
+        }
+    }
+    delete allocator;
+}
+
+/**
+ * 把隔离实例恢复到刚创建时的状态：清除上一次使用设置的回调和策略，并回收遗留的上下文。
+ * 消息监听、GC 回调和微任务完成回调只能按函数移除，只有通过 IsolateCallbacks 注册的才会被移除；
+ * 内建模块的导出模板与上下文无关，保留给下一次使用
+ * @param isolate
+ */
+void IsolatePool::resetIsolate(v8::Isolate *isolate) {
+    // 重置发生在后台线程上，需要加锁
+    v8::Locker locker(isolate);
+    v8::Isolate::Scope scope(isolate);
+    isolate->CancelTerminateExecution();
+    isolate->SetMicrotasksPolicy(v8::MicrotasksPolicy::kAuto);
+    isolate->SetHostImportModuleDynamicallyCallback(
+            static_cast<v8::HostImportModuleDynamicallyWithImportAssertionsCallback>(nullptr));
+    isolate->SetHostInitializeImportMetaObjectCallback(nullptr);
+    isolate->SetAbortOnUncaughtExceptionCallback(nullptr);
+    isolate->SetPromiseRejectCallback(nullptr);
+    isolate->SetPromiseHook(nullptr);
+    isolate->SetPrepareStackTraceCallback(nullptr);
+    isolate->SetCaptureStackTraceForUncaughtExceptions(false);
+    isolate->SetFatalErrorHandler(nullptr);
+    isolate->SetOOMErrorHandler(nullptr);
+    isolate->SetAtomicsWaitCallback(nullptr, nullptr);
+    IsolateCallbacks::Reset(isolate);
+    isolate->ContextDisposedNotification();
+    isolate->LowMemoryNotification();
+}
+
+void IsolatePool::refill() {
+    CpuTopology::Apply(_placement);
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (true) {
+        _condition.wait(lock, [this]() -> bool {
+            return _stopping || !_retired.empty() || !_recycled.empty() || _idle.size() < _size;
+        });
+        if (_stopping) {
+            return;
+        }
+        // 先销毁，释放内存
+        if (!_retired.empty()) {
+            v8::Isolate *isolate = _retired.front();
+            _retired.pop_front();
+            lock.unlock();
+            disposeIsolate(isolate);
+            lock.lock();
+            continue;
+        }
+        // 再复用归还的隔离实例，有待复用的隔离实例时不会走到下面的创建。
+        // 放在队首优先取出，超出池大小时销毁队尾最久未使用的空闲隔离实例
+        if (!_recycled.empty()) {
+            v8::Isolate *isolate = _recycled.front();
+            _recycled.pop_front();
+            lock.unlock();
+            resetIsolate(isolate);
+            lock.lock();
+            if (_size > 0) {
+                _idle.push_front(isolate);
+                _recycle_count++;
+                if (_idle.size() > _size) {
+                    _retired.push_back(_idle.back());
+                    _idle.pop_back();
+                }
+            } else {
+                _retired.push_back(isolate);
+            }
+            continue;
+        }
+        // 最后补充新的隔离实例
+        lock.unlock();
+        v8::Isolate *isolate = createIsolate();
+        lock.lock();
+        _idle.push_back(isolate);
+    }
+}
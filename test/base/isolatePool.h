@@ -0,0 +1,88 @@
+//
+// Created by user on 2026/10/17.
+//
+
+#ifndef V8_LEARN_ISOLATE_POOL_H
+#define V8_LEARN_ISOLATE_POOL_H
+#include "arrayBufferAllocator.h"
+#include "cpuTopology.h"
+#include "v8.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+/**
+ * 预热的隔离实例池。
+ * 后台线程提前创建好隔离实例，使用方通过 acquire 取出，用完后通过 release 归还。
+ * 归还的隔离实例在后台线程上重置或者销毁，创建和销毁的开销都不在调用方的线程上。
+ * 重置后的隔离实例优先于新建的取出，空闲隔离实例的数量不超过 size。
+ */
+class IsolatePool {
+public:
+    /**
+     * @param size 池中保持的空闲隔离实例数量
+     * @param placement 后台线程的放置方式。设置了节点时，所有隔离实例（包括未命中时在调用方线程上同步创建的）
+     *                  都在该节点上保留堆内存，需要 EmbedderPlatform 开启 numaPageAllocator
+     */
+    explicit IsolatePool(size_t size, ThreadPlacement placement = ThreadPlacement());
+    ~IsolatePool();
+    IsolatePool(const IsolatePool &) = delete;
+    IsolatePool &operator=(const IsolatePool &) = delete;
+
+    /**
+     * 取出一个隔离实例，池为空时同步创建（记为一次未命中）
+     * @return
+     */
+    v8::Isolate *acquire();
+    /**
+     * 归还隔离实例，调用方需要先退出该隔离实例。
+     * @param isolate
+     * @param reusable 为 true 时隔离实例被重置后放回池中复用，否则在后台销毁。
+     *                 消息监听、GC 回调和微任务完成回调需要通过 IsolateCallbacks 注册，其他回调由重置清除。
+     */
+    void release(v8::Isolate *isolate, bool reusable = false);
+    /**
+     * 获取隔离实例使用的 ArrayBuffer 分配器，每个隔离实例独占一个，用于统计该隔离实例的内存
+     * @param isolate
+     * @return
+     */
+    PooledArrayBufferAllocator *getArrayBufferAllocator(v8::Isolate *isolate);
+
+    size_t getSize() const { return _size; }
+    const ThreadPlacement &getPlacement() const { return _placement; }
+    size_t getIdleCount();
+    uint64_t getHitCount() const { return _hit_count.load(); }
+    uint64_t getMissCount() const { return _miss_count.load(); }
+    uint64_t getRecycleCount() const { return _recycle_count.load(); }
+
+private:
+    v8::Isolate *createIsolate();
+    void disposeIsolate(v8::Isolate *isolate);
+    static void resetIsolate(v8::Isolate *isolate);
+    /**
+     * 后台线程：补充空闲隔离实例，处理归还的隔离实例
+     */
+    void refill();
+
+    const size_t _size;
+    const ThreadPlacement _placement;
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    // 已经预热好的空闲隔离实例
+    std::deque<v8::Isolate *> _idle;
+    // 等待重置后复用的隔离实例
+    std::deque<v8::Isolate *> _recycled;
+    // 等待销毁的隔离实例
+    std::deque<v8::Isolate *> _retired;
+    std::unordered_map<v8::Isolate *, PooledArrayBufferAllocator *> _allocators;
+    bool _stopping = false;
+    std::atomic<uint64_t> _hit_count{0};
+    std::atomic<uint64_t> _miss_count{0};
+    std::atomic<uint64_t> _recycle_count{0};
+    std::thread _refill_thread;
+};
+
+#endif//V8_LEARN_ISOLATE_POOL_H
@@ -0,0 +1,145 @@
+//
+// Created by user on 2026/10/17.
+//
+
+#include "jsonModuleCache.h"
+#include <cstdlib>
+#include <cstring>
+
+/**
+ * 源码的字节和哈希。
+ * 映射文件得到的外部单字节字符串直接引用映射的内存，其他字符串复制一次：
+ * 单字节字符串按 Latin-1 复制，双字节字符串转成 UTF-8，不再展开成 UTF-16
+ */
+class JsonModuleCache::SourceBytes {
+public:
+    SourceBytes(v8::Isolate *isolate, v8::Local<v8::String> source) {
+        if (source->IsExternalOneByte()) {
+            const v8::String::ExternalOneByteStringResource *resource = source->GetExternalOneByteStringResource();
+            _data = resource->data();
+            _length = resource->length();
+        } else if (source->IsOneByte()) {
+            _copy.resize(source->Length());
+            source->WriteOneByte(isolate, reinterpret_cast<uint8_t *>(&_copy[0]), 0, -1, v8::String::NO_NULL_TERMINATION);
+        } else {
+            _one_byte = false;
+            _copy.resize(source->Utf8Length(isolate));
+            source->WriteUtf8(isolate, &_copy[0], static_cast<int>(_copy.size()), nullptr, v8::String::NO_NULL_TERMINATION);
+        }
+        if (_data == nullptr) {
+            _data = _copy.data();
+            _length = _copy.size();
+        }
+        // 64 位 FNV-1a
+        _hash = 14695981039346656037ULL;
+        for (size_t i = 0; i < _length; i++) {
+            _hash ^= static_cast<unsigned char>(_data[i]);
+            _hash *= 1099511628211ULL;
+        }
+    }
+
+    bool equals(const Entry &entry) const {
+        return entry.oneByte == _one_byte && entry.source.size() == _length && memcmp(entry.source.data(), _data, _length) == 0;
+    }
+
+    bool isOneByte() const { return _one_byte; }
+    const char *data() const { return _data; }
+    size_t length() const { return _length; }
+    uint64_t hash() const { return _hash; }
+
+private:
+    bool _one_byte = true;
+    const char *_data = nullptr;
+    size_t _length = 0;
+    uint64_t _hash = 0;
+    std::string _copy;
+};
+
+v8::MaybeLocal<v8::Value> JsonModuleCache::parse(v8::Local<v8::Context> context, v8::Local<v8::String> source) {
+    v8::Isolate *isolate = context->GetIsolate();
+    v8::EscapableHandleScope handleScope(isolate);
+    SourceBytes bytes(isolate, source);
+    std::shared_ptr<const Entry> entry = find(bytes);
+    if (entry == nullptr) {
+        v8::Local<v8::Value> value;
+        if (!parseAndStore(context, source, bytes).ToLocal(&value)) {
+            return v8::MaybeLocal<v8::Value>();
+        }
+        return handleScope.Escape(value);
+    }
+    _hit_count++;
+    // 反序列化在锁外进行，entry 持有数据，其他线程替换缓存不影响这里
+    v8::ValueDeserializer deserializer(isolate, entry->data.data(), entry->data.size());
+    v8::Local<v8::Value> value;
+    if (!deserializer.ReadHeader(context).FromMaybe(false) || !deserializer.ReadValue(context).ToLocal(&value)) {
+        return v8::MaybeLocal<v8::Value>();
+    }
+    return handleScope.Escape(value);
+}
+
+bool JsonModuleCache::prepare(v8::Local<v8::Context> context, v8::Local<v8::String> source) {
+    v8::Isolate *isolate = context->GetIsolate();
+    v8::HandleScope handleScope(isolate);
+    SourceBytes bytes(isolate, source);
+    if (find(bytes) != nullptr) {
+        return true;
+    }
+    return !parseAndStore(context, source, bytes).IsEmpty();
+}
+
+bool JsonModuleCache::contains(v8::Isolate *isolate, v8::Local<v8::String> source) {
+    return find(SourceBytes(isolate, source)) != nullptr;
+}
+
+size_t JsonModuleCache::getSize() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _entries.size();
+}
+
+std::shared_ptr<const JsonModuleCache::Entry> JsonModuleCache::find(const SourceBytes &bytes) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto range = _entries.equal_range(bytes.hash());
+    for (auto it = range.first; it != range.second; ++it) {
+        // 哈希相同不代表内容相同，命中前比较全部内容
+        if (bytes.equals(*it->second)) {
+            return it->second;
+        }
+    }
+    return nullptr;
+}
+
+v8::MaybeLocal<v8::Value> JsonModuleCache::parseAndStore(v8::Local<v8::Context> context, v8::Local<v8::String> source, const SourceBytes &bytes) {
+    v8::Isolate *isolate = context->GetIsolate();
+    v8::EscapableHandleScope handleScope(isolate);
+    v8::Local<v8::Value> value;
+    if (!v8::JSON::Parse(context, source).ToLocal(&value)) {
+        return v8::MaybeLocal<v8::Value>();
+    }
+    _parse_count++;
+    // JSON 的结果只有普通对象、数组和原始值，序列化不会失败
+    v8::ValueSerializer serializer(isolate);
+    serializer.WriteHeader();
+    if (!serializer.WriteValue(context, value).FromMaybe(false)) {
+        return v8::MaybeLocal<v8::Value>();
+    }
+    std::pair<uint8_t *, size_t> buffer = serializer.Release();
+    auto entry = std::make_shared<Entry>();
+    entry->oneByte = bytes.isOneByte();
+    entry->source.assign(bytes.data(), bytes.length());
+    entry->data.assign(buffer.first, buffer.first + buffer.second);
+    // 默认的序列化代理使用 realloc 分配缓冲区
+    free(buffer.first);
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        // 其他线程可能同时解析了同样的内容，替换已有的项
+        auto range = _entries.equal_range(bytes.hash());
+        for (auto it = range.first; it != range.second; ++it) {
+            if (bytes.equals(*it->second)) {
+                it->second = std::move(entry);
+                return handleScope.Escape(value);
+            }
+        }
+        _entries.emplace(bytes.hash(), std::move(entry));
+    }
+    return handleScope.Escape(value);
+}
@@ -0,0 +1,77 @@
+//
+// Created by user on 2026/10/17.
+//
+
+#ifndef V8_LEARN_JSON_MODULE_CACHE_H
+#define V8_LEARN_JSON_MODULE_CACHE_H
+#include "v8.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * JSON 模块的解析缓存。
+ * 以源码的字节为键（按哈希查找，命中后再比较全部内容），保存 JSON::Parse 结果经过 ValueSerializer 序列化后的数据。
+ * 同样内容的 JSON 只解析一次，之后在任意隔离实例、任意上下文中反序列化得到新的对象，
+ * 不同模块之间不会共享同一个可变对象，对象也不会跨上下文泄漏原型。
+ * 线程安全，可以在后台线程的隔离实例上通过 prepare 提前解析。
+ */
+class JsonModuleCache {
+public:
+    /**
+     * 解析 JSON 源码，缓存中已经有同样内容时直接反序列化
+     * @param context 结果对象所属的上下文
+     * @param source
+     * @return 解析失败时返回空，异常留在隔离实例上
+     */
+    v8::MaybeLocal<v8::Value> parse(v8::Local<v8::Context> context, v8::Local<v8::String> source);
+    /**
+     * 只解析并缓存，不返回结果。用于在后台隔离实例上提前解析
+     * @param context
+     * @param source
+     * @return 解析失败时返回 false
+     */
+    bool prepare(v8::Local<v8::Context> context, v8::Local<v8::String> source);
+    /**
+     * 判断同样内容的 JSON 是否已经缓存
+     * @param isolate
+     * @param source
+     * @return
+     */
+    bool contains(v8::Isolate *isolate, v8::Local<v8::String> source);
+
+    size_t getSize();
+    uint64_t getParseCount() const { return _parse_count.load(); }
+    uint64_t getHitCount() const { return _hit_count.load(); }
+
+private:
+    class SourceBytes;
+    struct Entry {
+        // 源码是单字节（Latin-1）还是 UTF-8，同样的字节在两种编码下是不同的内容
+        bool oneByte;
+        std::string source;
+        std::vector<uint8_t> data;
+    };
+
+    std::shared_ptr<const Entry> find(const SourceBytes &bytes);
+    /**
+     * 解析并序列化，写入缓存
+     * @param context
+     * @param source
+     * @param bytes source 的字节
+     * @return
+     */
+    v8::MaybeLocal<v8::Value> parseAndStore(v8::Local<v8::Context> context, v8::Local<v8::String> source, const SourceBytes &bytes);
+
+    std::mutex _mutex;
+    // 哈希冲突时同一个键下有多项
+    std::unordered_multimap<uint64_t, std::shared_ptr<const Entry>> _entries;
+    std::atomic<uint64_t> _parse_count{0};
+    std::atomic<uint64_t> _hit_count{0};
+};
+
+#endif//V8_LEARN_JSON_MODULE_CACHE_H
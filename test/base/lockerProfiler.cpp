@@ -0,0 +1,178 @@
+//
+// Created by user on 2026/10/17.
+//
+
+#include "lockerProfiler.h"
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+std::atomic<bool> LockerProfiler::_enabled{false};
+
+namespace {
+    uint64_t ElapsedNanoseconds(std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end) {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+    }
+
+    // DumpAtExit 设置的输出文件路径
+    std::string g_dump_path;
+
+    void DumpToFile() {
+        FILE *out = fopen(g_dump_path.c_str(), "a");
+        if (out == nullptr) {
+            return;
+        }
+        LockerProfiler::Get()->dump(out);
+        fclose(out);
+    }
+}// namespace
+
+int LockerProfiler::Histogram::Bucket(uint64_t nanoseconds) {
+    int bucket = 0;
+    while (nanoseconds != 0 && bucket < kBucketCount - 1) {
+        nanoseconds >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+void LockerProfiler::Histogram::record(uint64_t nanoseconds) {
+    buckets[Bucket(nanoseconds)]++;
+    count++;
+    totalNanoseconds += nanoseconds;
+    maxNanoseconds = std::max(maxNanoseconds, nanoseconds);
+}
+
+uint64_t LockerProfiler::Histogram::percentile(double percentile) const {
+    if (count == 0) {
+        return 0;
+    }
+    uint64_t target = static_cast<uint64_t>(count * percentile / 100.0);
+    uint64_t seen = 0;
+    for (int i = 0; i < kBucketCount; i++) {
+        seen += buckets[i];
+        if (seen > target || seen == count) {
+            // 桶的上界不超过实际的最大值
+            return i == 0 ? 0 : std::min(maxNanoseconds, (uint64_t{1} << i) - 1);
+        }
+    }
+    return maxNanoseconds;
+}
+
+LockerProfiler *LockerProfiler::Get() {
+    // 不析构，退出时的 DumpAtExit 和其他静态对象的析构中都可以安全使用
+    static LockerProfiler *profiler = new LockerProfiler();
+    return profiler;
+}
+
+void LockerProfiler::DumpAtExit(const std::string &path) {
+    static bool registered = false;
+    g_dump_path = path;
+    if (!registered) {
+        registered = true;
+        std::atexit(DumpToFile);
+    }
+}
+
+void LockerProfiler::record(v8::Isolate *isolate, const char *file, int line, const char *function, uint64_t waitNanoseconds, uint64_t holdNanoseconds) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    IsolateStats &stats = _isolates[isolate];
+    stats.wait.record(waitNanoseconds);
+    stats.hold.record(holdNanoseconds);
+    SiteStats &site = stats.sites[std::make_pair(file, line)];
+    site.file = file;
+    site.line = line;
+    site.function = function;
+    site.wait.record(waitNanoseconds);
+    site.hold.record(holdNanoseconds);
+}
+
+bool LockerProfiler::getStats(v8::Isolate *isolate, IsolateStats *out) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _isolates.find(isolate);
+    if (it == _isolates.end()) {
+        return false;
+    }
+    *out = it->second;
+    return true;
+}
+
+void LockerProfiler::forget(v8::Isolate *isolate) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _isolates.erase(isolate);
+}
+
+void LockerProfiler::reset() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _isolates.clear();
+}
+
+void LockerProfiler::WriteHistogram(FILE *out, const Histogram &histogram) {
+    fprintf(out, "{\"count\": %llu, \"total_ns\": %llu, \"max_ns\": %llu, \"p50_ns\": %llu, \"p99_ns\": %llu, \"buckets\": [",
+            static_cast<unsigned long long>(histogram.count), static_cast<unsigned long long>(histogram.totalNanoseconds),
+            static_cast<unsigned long long>(histogram.maxNanoseconds), static_cast<unsigned long long>(histogram.percentile(50)),
+            static_cast<unsigned long long>(histogram.percentile(99)));
+    // 省略末尾的空桶
+    int last = kBucketCount - 1;
+    while (last > 0 && histogram.buckets[last] == 0) {
+        last--;
+    }
+    for (int i = 0; i <= last; i++) {
+        fprintf(out, "%s%llu", i == 0 ? "" : ", ", static_cast<unsigned long long>(histogram.buckets[i]));
+    }
+    fprintf(out, "]}");
+}
+
+void LockerProfiler::dump(FILE *out) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (const auto &entry : _isolates) {
+        const IsolateStats &stats = entry.second;
+        fprintf(out, "{\"isolate\": \"%p\", \"wait\": ", static_cast<void *>(entry.first));
+        WriteHistogram(out, stats.wait);
+        fprintf(out, ", \"hold\": ");
+        WriteHistogram(out, stats.hold);
+        std::vector<const SiteStats *> sites;
+        for (const auto &site : stats.sites) {
+            sites.push_back(&site.second);
+        }
+        std::sort(sites.begin(), sites.end(), [](const SiteStats *first, const SiteStats *second) -> bool {
+            return first->wait.totalNanoseconds > second->wait.totalNanoseconds;
+        });
+        fprintf(out, ", \"sites\": [");
+        for (size_t i = 0; i < sites.size(); i++) {
+            fprintf(out, "%s{\"file\": \"%s\", \"line\": %d, \"function\": \"%s\", \"wait\": ", i == 0 ? "" : ", ",
+                    sites[i]->file, sites[i]->line, sites[i]->function);
+            WriteHistogram(out, sites[i]->wait);
+            fprintf(out, ", \"hold\": ");
+            WriteHistogram(out, sites[i]->hold);
+            fprintf(out, "}");
+        }
+        fprintf(out, "]}\n");
+    }
+    fflush(out);
+}
+
+ProfiledLocker::ProfiledLocker(v8::Isolate *isolate, const char *file, int line, const char *function)
+    : _isolate(isolate), _file(file), _line(line), _function(function) {
+    // 当前线程已经持有锁时是嵌套加锁，不会等待
+    _profiled = LockerProfiler::IsEnabled() && !v8::Locker::IsLocked(isolate);
+    if (!_profiled) {
+        new (_locker) v8::Locker(isolate);
+        return;
+    }
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    new (_locker) v8::Locker(isolate);
+    _acquired = std::chrono::steady_clock::now();
+    _wait_nanoseconds = ElapsedNanoseconds(start, _acquired);
+}
+
+ProfiledLocker::~ProfiledLocker() {
+    if (!_profiled) {
+        reinterpret_cast<v8::Locker *>(_locker)->~Locker();
+        return;
+    }
+    std::chrono::steady_clock::time_point released = std::chrono::steady_clock::now();
+    reinterpret_cast<v8::Locker *>(_locker)->~Locker();
+    LockerProfiler::Get()->record(_isolate, _file, _line, _function, _wait_nanoseconds, ElapsedNanoseconds(_acquired, released));
+}
@@ -0,0 +1,140 @@
+//
+// Created by user on 2026/10/17.
+//
+
+#ifndef V8_LEARN_LOCKER_PROFILER_H
+#define V8_LEARN_LOCKER_PROFILER_H
+#include "v8.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+/**
+ * v8::Locker 的竞争统计。
+ * 按隔离实例汇总每次加锁的等待时间和持有时间，并按加锁的调用位置（文件、行号、函数）分别汇总，
+ * 时间以纳秒为单位记录在 log2 分桶的直方图中。统计默认关闭，关闭时 ProfiledLocker 与 v8::Locker 完全相同。
+ */
+class LockerProfiler {
+public:
+    // 第 k 个桶记录 [2^(k-1), 2^k) 纳秒，第 0 个桶记录 0 纳秒，最后一个桶包含所有更长的时间
+    static const int kBucketCount = 40;
+
+    struct Histogram {
+        uint64_t buckets[kBucketCount] = {};
+        uint64_t count = 0;
+        uint64_t totalNanoseconds = 0;
+        uint64_t maxNanoseconds = 0;
+
+        void record(uint64_t nanoseconds);
+        /**
+         * 百分位数的近似值，返回所在桶的上界
+         * @param percentile 0 到 100
+         * @return
+         */
+        uint64_t percentile(double percentile) const;
+        static int Bucket(uint64_t nanoseconds);
+    };
+
+    /**
+     * 一个加锁位置的统计
+     */
+    struct SiteStats {
+        const char *file = nullptr;
+        int line = 0;
+        const char *function = nullptr;
+        Histogram wait;
+        Histogram hold;
+    };
+
+    /**
+     * 一个隔离实例的统计
+     */
+    struct IsolateStats {
+        Histogram wait;
+        Histogram hold;
+        // 以文件名指针和行号为键，__FILE__ 是字符串字面量，同一个位置的指针不变
+        std::map<std::pair<const char *, int>, SiteStats> sites;
+    };
+
+    /**
+     * 进程唯一的统计实例
+     * @return
+     */
+    static LockerProfiler *Get();
+    static void SetEnabled(bool enabled) { _enabled.store(enabled, std::memory_order_relaxed); }
+    static bool IsEnabled() { return _enabled.load(std::memory_order_relaxed); }
+    /**
+     * 进程退出时把统计追加写入文件
+     * @param path
+     */
+    static void DumpAtExit(const std::string &path);
+
+    /**
+     * 记录一次加锁，在释放 v8 锁之后调用，统计本身的开销不计入持有时间
+     * @param isolate
+     * @param file
+     * @param line
+     * @param function
+     * @param waitNanoseconds
+     * @param holdNanoseconds
+     */
+    void record(v8::Isolate *isolate, const char *file, int line, const char *function, uint64_t waitNanoseconds, uint64_t holdNanoseconds);
+    /**
+     * 复制隔离实例的统计
+     * @param isolate
+     * @param out
+     * @return 没有记录时返回 false
+     */
+    bool getStats(v8::Isolate *isolate, IsolateStats *out);
+    /**
+     * 每个隔离实例写出一行 JSON，调用位置按总等待时间从长到短排列
+     * @param out
+     */
+    void dump(FILE *out);
+    /**
+     * 清除隔离实例的统计，隔离实例销毁后地址可能被新的隔离实例复用
+     * @param isolate
+     */
+    void forget(v8::Isolate *isolate);
+    void reset();
+
+private:
+    static void WriteHistogram(FILE *out, const Histogram &histogram);
+
+    static std::atomic<bool> _enabled;
+    std::mutex _mutex;
+    std::unordered_map<v8::Isolate *, IsolateStats> _isolates;
+};
+
+/**
+ * 记录等待时间和持有时间的 v8::Locker。
+ * 同一个线程嵌套加锁时不统计内层的加锁。通过 PROFILED_LOCKER 宏使用，自动带上调用位置
+ */
+class ProfiledLocker {
+public:
+    ProfiledLocker(v8::Isolate *isolate, const char *file, int line, const char *function);
+    ~ProfiledLocker();
+    ProfiledLocker(const ProfiledLocker &) = delete;
+    ProfiledLocker &operator=(const ProfiledLocker &) = delete;
+
+private:
+    v8::Isolate *_isolate;
+    const char *_file;
+    int _line;
+    const char *_function;
+    bool _profiled;
+    uint64_t _wait_nanoseconds = 0;
+    std::chrono::steady_clock::time_point _acquired;
+    // 在析构函数中先释放锁再记录统计，所以 v8::Locker 放在自己管理的存储中，不需要堆分配
+    alignas(v8::Locker) unsigned char _locker[sizeof(v8::Locker)];
+};
+
+#define PROFILED_LOCKER(name, isolate) ProfiledLocker name(isolate, __FILE__, __LINE__, __func__)
+
+#endif//V8_LEARN_LOCKER_PROFILER_H
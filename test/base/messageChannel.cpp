@@ -0,0 +1,128 @@
+//
+// Created by user on 2026/10/17.
+//
+
+#include "messageChannel.h"
+#include <algorithm>
+
+namespace {
+    /**
+     * 序列化代理，把 SharedArrayBuffer 记录到消息中，序列化数据里只写下标
+     */
+    class SerializerDelegate : public v8::ValueSerializer::Delegate {
+    public:
+        SerializerDelegate(v8::Isolate *isolate, Message *message) : _isolate(isolate), _message(message) {}
+
+        void ThrowDataCloneError(v8::Local<v8::String> message) override {
+            _isolate->ThrowException(v8::Exception::Error(message));
+        }
+
+        v8::Maybe<uint32_t> GetSharedArrayBufferId(v8::Isolate *isolate, v8::Local<v8::SharedArrayBuffer> sharedArrayBuffer) override {
+            std::shared_ptr<v8::BackingStore> backingStore = sharedArrayBuffer->GetBackingStore();
+            std::vector<std::shared_ptr<v8::BackingStore>> &shared = _message->sharedArrayBuffers;
+            // 同一个 SharedArrayBuffer 在消息中出现多次时只记录一次
+            auto it = std::find(shared.begin(), shared.end(), backingStore);
+            if (it != shared.end()) {
+                return v8::Just(static_cast<uint32_t>(it - shared.begin()));
+            }
+            shared.push_back(std::move(backingStore));
+            return v8::Just(static_cast<uint32_t>(shared.size() - 1));
+        }
+
+    private:
+        v8::Isolate *_isolate;
+        Message *_message;
+    };
+
+    /**
+     * 反序列化代理，用消息中的 BackingStore 创建 SharedArrayBuffer
+     */
+    class DeserializerDelegate : public v8::ValueDeserializer::Delegate {
+    public:
+        explicit DeserializerDelegate(Message *message) : _message(message) {}
+
+        v8::MaybeLocal<v8::SharedArrayBuffer> GetSharedArrayBufferFromId(v8::Isolate *isolate, uint32_t id) override {
+            if (id >= _message->sharedArrayBuffers.size()) {
+                isolate->ThrowException(v8::Exception::Error(v8::String::NewFromUtf8Literal(isolate, "invalid SharedArrayBuffer id")));
+                return v8::MaybeLocal<v8::SharedArrayBuffer>();
+            }
+            return v8::SharedArrayBuffer::New(isolate, _message->sharedArrayBuffers[id]);
+        }
+
+    private:
+        Message *_message;
+    };
+}// namespace
+
+v8::Maybe<bool> MessagePort::postMessage(v8::Local<v8::Context> context, v8::Local<v8::Value> value,
+                                         const std::vector<v8::Local<v8::ArrayBuffer>> &transferList) {
+    v8::Isolate *isolate = context->GetIsolate();
+    v8::HandleScope handleScope(isolate);
+    // 只有当前线程写入对端队列，这里不满之后的 push 一定成功，不会出现已经分离却发不出去的情况
+    if (_outgoing->full()) {
+        return v8::Just(false);
+    }
+    for (size_t i = 0; i < transferList.size(); i++) {
+        v8::Local<v8::ArrayBuffer> arrayBuffer = transferList[i];
+        bool duplicate = std::find(transferList.begin(), transferList.begin() + i, arrayBuffer) != transferList.begin() + i;
+        if (duplicate || !arrayBuffer->IsDetachable()) {
+            isolate->ThrowException(v8::Exception::Error(v8::String::NewFromUtf8Literal(isolate, "ArrayBuffer is not transferable")));
+            return v8::Nothing<bool>();
+        }
+    }
+    Message message;
+    SerializerDelegate delegate(isolate, &message);
+    v8::ValueSerializer serializer(isolate, &delegate);
+    for (size_t i = 0; i < transferList.size(); i++) {
+        serializer.TransferArrayBuffer(static_cast<uint32_t>(i), transferList[i]);
+    }
+    serializer.WriteHeader();
+    if (!serializer.WriteValue(context, value).FromMaybe(false)) {
+        return v8::Nothing<bool>();
+    }
+    std::pair<uint8_t *, size_t> buffer = serializer.Release();
+    message.data.reset(buffer.first);
+    message.size = buffer.second;
+    uint64_t zeroCopyBytes = 0;
+    // 序列化成功后才分离，接收方通过 BackingStore 拿到同一块内存
+    for (const v8::Local<v8::ArrayBuffer> &arrayBuffer : transferList) {
+        message.arrayBuffers.push_back(arrayBuffer->GetBackingStore());
+        zeroCopyBytes += arrayBuffer->ByteLength();
+        arrayBuffer->Detach();
+    }
+    for (const std::shared_ptr<v8::BackingStore> &backingStore : message.sharedArrayBuffers) {
+        zeroCopyBytes += backingStore->ByteLength();
+    }
+    _outgoing->push(message);
+    _sent_count++;
+    _zero_copy_bytes += zeroCopyBytes;
+    return v8::Just(true);
+}
+
+v8::MaybeLocal<v8::Value> MessagePort::receiveMessage(v8::Local<v8::Context> context) {
+    v8::Isolate *isolate = context->GetIsolate();
+    v8::EscapableHandleScope handleScope(isolate);
+    Message message;
+    if (!_incoming->pop(message)) {
+        return v8::MaybeLocal<v8::Value>();
+    }
+    _received_count++;
+    DeserializerDelegate delegate(&message);
+    v8::ValueDeserializer deserializer(isolate, message.data.get(), message.size, &delegate);
+    // 转移的 ArrayBuffer 在读取数据之前登记，序列化数据中只有转移下标
+    for (size_t i = 0; i < message.arrayBuffers.size(); i++) {
+        deserializer.TransferArrayBuffer(static_cast<uint32_t>(i), v8::ArrayBuffer::New(isolate, message.arrayBuffers[i]));
+    }
+    v8::Local<v8::Value> value;
+    if (!deserializer.ReadHeader(context).FromMaybe(false) || !deserializer.ReadValue(context).ToLocal(&value)) {
+        return v8::MaybeLocal<v8::Value>();
+    }
+    return handleScope.Escape(value);
+}
+
+MessageChannel::MessageChannel(size_t capacity) {
+    auto first = std::make_shared<SpscQueue<Message>>(capacity);
+    auto second = std::make_shared<SpscQueue<Message>>(capacity);
+    _port1.reset(new MessagePort(first, second));
+    _port2.reset(new MessagePort(second, first));
+}
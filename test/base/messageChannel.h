@@ -0,0 +1,101 @@
+//
+// Created by user on 2026/10/17.
+//
+
+#ifndef V8_LEARN_MESSAGE_CHANNEL_H
+#define V8_LEARN_MESSAGE_CHANNEL_H
+#include "spscQueue.h"
+#include "v8.h"
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+/**
+ * 隔离实例之间传递的消息。
+ * data 是 ValueSerializer 的输出，ArrayBuffer 和 SharedArrayBuffer 的内容不在 data 中，
+ * 而是以 BackingStore 的形式随消息传递，接收方直接在同一块内存上创建对象。
+ */
+struct Message {
+    struct FreeDeleter {
+        void operator()(uint8_t *data) const { free(data); }
+    };
+    // 序列化器用 realloc 分配的缓冲区，直接接管，不再复制一次
+    std::unique_ptr<uint8_t, FreeDeleter> data;
+    size_t size = 0;
+    // 转移的 ArrayBuffer，发送方的对象已经被分离
+    std::vector<std::shared_ptr<v8::BackingStore>> arrayBuffers;
+    // 共享的 SharedArrayBuffer，两边的对象指向同一块内存
+    std::vector<std::shared_ptr<v8::BackingStore>> sharedArrayBuffers;
+};
+
+/**
+ * 消息通道的一端。
+ * 每个方向是一个单生产者单消费者的无锁队列，一个端口只能在一个线程（它所属的隔离实例的线程）上使用：
+ * postMessage 写入对端的接收队列，receiveMessage 读取自己的接收队列。
+ * 转移的 ArrayBuffer 的内存由发送方隔离实例的 ArrayBuffer::Allocator 分配，接收方释放时也通过它释放，
+ * 所以发送方的分配器必须线程安全，并且比所有收到的缓冲区活得更久。
+ */
+class MessagePort {
+public:
+    MessagePort(std::shared_ptr<SpscQueue<Message>> incoming, std::shared_ptr<SpscQueue<Message>> outgoing)
+        : _incoming(std::move(incoming)), _outgoing(std::move(outgoing)) {}
+    MessagePort(const MessagePort &) = delete;
+    MessagePort &operator=(const MessagePort &) = delete;
+
+    /**
+     * 发送消息
+     * @param context
+     * @param value
+     * @param transferList 转移而不是复制的 ArrayBuffer，发送后在当前隔离实例中被分离
+     * @return 序列化失败时返回 Nothing 并抛出 DataCloneError，对端队列满时返回 false，此时不分离任何缓冲区
+     */
+    v8::Maybe<bool> postMessage(v8::Local<v8::Context> context, v8::Local<v8::Value> value,
+                                const std::vector<v8::Local<v8::ArrayBuffer>> &transferList = {});
+    /**
+     * 判断是否有等待接收的消息
+     * @return
+     */
+    bool hasMessage() const { return _incoming->size() > 0; }
+    /**
+     * 接收一条消息
+     * @param context 反序列化出的对象所属的上下文
+     * @return 没有消息时返回空且不抛出异常，反序列化失败时返回空并抛出异常
+     */
+    v8::MaybeLocal<v8::Value> receiveMessage(v8::Local<v8::Context> context);
+
+    uint64_t getSentCount() const { return _sent_count.load(); }
+    uint64_t getReceivedCount() const { return _received_count.load(); }
+    /**
+     * 通过转移和共享传递的字节数，这些字节没有经过序列化
+     * @return
+     */
+    uint64_t getZeroCopyBytes() const { return _zero_copy_bytes.load(); }
+
+private:
+    std::shared_ptr<SpscQueue<Message>> _incoming;
+    std::shared_ptr<SpscQueue<Message>> _outgoing;
+    std::atomic<uint64_t> _sent_count{0};
+    std::atomic<uint64_t> _received_count{0};
+    std::atomic<uint64_t> _zero_copy_bytes{0};
+};
+
+/**
+ * 一对互相连接的消息端口，与 js 的 MessageChannel 类似，两个端口分别交给两个隔离实例的线程使用
+ */
+class MessageChannel {
+public:
+    /**
+     * @param capacity 每个方向最多缓存的消息数量
+     */
+    explicit MessageChannel(size_t capacity = 1024);
+
+    MessagePort *getPort1() { return _port1.get(); }
+    MessagePort *getPort2() { return _port2.get(); }
+
+private:
+    std::unique_ptr<MessagePort> _port1;
+    std::unique_ptr<MessagePort> _port2;
+};
+
+#endif//V8_LEARN_MESSAGE_CHANNEL_H
@@ -0,0 +1,328 @@
+//
+// Created by user on 2026/10/17.
+//
+
+#include "moduleArchive.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+const char ModuleArchive::kMagic[8] = {'V', '8', 'L', 'A', 'R', 'C', 'H', '\0'};
+
+namespace {
+    /**
+     * 引用归档映射内存的单字节外部字符串
+     */
+    class ArchiveOneByteResource : public v8::String::ExternalOneByteStringResource {
+    public:
+        ArchiveOneByteResource(std::shared_ptr<MappedFile> file, const char *data, size_t length)
+            : _file(std::move(file)), _data(data), _length(length) {}
+        const char *data() const override { return _data; }
+        size_t length() const override { return _length; }
+
+    private:
+        std::shared_ptr<MappedFile> _file;
+        const char *_data;
+        size_t _length;
+    };
+
+    /**
+     * 引用归档映射内存的双字节外部字符串
+     */
+    class ArchiveTwoByteResource : public v8::String::ExternalStringResource {
+    public:
+        ArchiveTwoByteResource(std::shared_ptr<MappedFile> file, const uint16_t *data, size_t length)
+            : _file(std::move(file)), _data(data), _length(length) {}
+        const uint16_t *data() const override { return _data; }
+        size_t length() const override { return _length; }
+
+    private:
+        std::shared_ptr<MappedFile> _file;
+        const uint16_t *_data;
+        size_t _length;
+    };
+
+    size_t AlignUp(size_t value) {
+        return (value + 7) & ~static_cast<size_t>(7);
+    }
+
+    /**
+     * 去掉 UTF-8 的 BOM
+     * @param source
+     * @return
+     */
+    size_t BomLength(const std::string &source) {
+        return source.size() >= 3 && memcmp(source.data(), "\xEF\xBB\xBF", 3) == 0 ? 3 : 0;
+    }
+}// namespace
+
+bool ModuleArchive::Builder::add(const std::string &path, const std::string &source) {
+    size_t offset = BomLength(source);
+    const char *data = source.data() + offset;
+    size_t length = source.size() - offset;
+    if (!SourceFile::IsAscii(data, length)) {
+        std::vector<uint16_t> utf16;
+        if (!SourceFile::DecodeUtf8(reinterpret_cast<const uint8_t *>(data), length, &utf16)) {
+            return false;
+        }
+    }
+    _sources[path] = source;
+    return true;
+}
+
+bool ModuleArchive::Builder::write(const std::string &file, v8::Isolate *isolate) {
+    struct Item {
+        const std::string *path;
+        // 单字节或者 UTF-16 编码的源码
+        std::string data;
+        uint32_t length;
+        uint32_t flags;
+        std::string cache;
+    };
+    std::vector<Item> items;
+    items.reserve(_sources.size());
+    for (const auto &pair : _sources) {
+        Item item;
+        item.path = &pair.first;
+        size_t offset = BomLength(pair.second);
+        const char *data = pair.second.data() + offset;
+        size_t length = pair.second.size() - offset;
+        if (SourceFile::IsAscii(data, length)) {
+            item.data.assign(data, length);
+            item.length = static_cast<uint32_t>(length);
+            item.flags = 0;
+        } else {
+            std::vector<uint16_t> utf16;
+            SourceFile::DecodeUtf8(reinterpret_cast<const uint8_t *>(data), length, &utf16);
+            item.data.assign(reinterpret_cast<const char *>(utf16.data()), utf16.size() * sizeof(uint16_t));
+            item.length = static_cast<uint32_t>(utf16.size());
+            item.flags = Entry::kTwoByte;
+        }
+        if (isolate != nullptr) {
+            v8::HandleScope handleScope(isolate);
+            // 语法错误的模块只保存源码，运行时编译时再报告错误
+            v8::TryCatch tryCatch(isolate);
+            v8::Local<v8::String> source;
+            v8::MaybeLocal<v8::String> maybeSource = (item.flags & Entry::kTwoByte)
+                    ? v8::String::NewFromTwoByte(isolate, reinterpret_cast<const uint16_t *>(item.data.data()), v8::NewStringType::kNormal, static_cast<int>(item.length))
+                    : v8::String::NewFromOneByte(isolate, reinterpret_cast<const uint8_t *>(item.data.data()), v8::NewStringType::kNormal, static_cast<int>(item.length));
+            v8::Local<v8::String> name;
+            v8::Local<v8::Module> module;
+            if (maybeSource.ToLocal(&source) && v8::String::NewFromUtf8(isolate, pair.first.c_str()).ToLocal(&name)) {
+                v8::ScriptOrigin origin(isolate, name, 0, 0, false, -1, v8::Local<v8::Value>(), false, false, true);
+                v8::ScriptCompiler::Source moduleSource(source, origin);
+                if (v8::ScriptCompiler::CompileModule(isolate, &moduleSource).ToLocal(&module)) {
+                    std::unique_ptr<v8::ScriptCompiler::CachedData> cachedData(v8::ScriptCompiler::CreateCodeCache(module->GetUnboundModuleScript()));
+                    if (cachedData != nullptr) {
+                        item.cache.assign(reinterpret_cast<const char *>(cachedData->data), cachedData->length);
+                    }
+                }
+            }
+        }
+        items.push_back(std::move(item));
+    }
+
+    // 先排好布局再一次写出
+    Header header{};
+    memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.count = static_cast<uint32_t>(items.size());
+    header.cacheTag = isolate != nullptr ? v8::ScriptCompiler::CachedDataVersionTag() : 0;
+    std::vector<Entry> entries(items.size());
+    size_t offset = sizeof(Header) + sizeof(Entry) * items.size();
+    for (size_t i = 0; i < items.size(); i++) {
+        Entry &entry = entries[i];
+        entry = Entry{};
+        offset = AlignUp(offset);
+        entry.pathOffset = static_cast<uint32_t>(offset);
+        entry.pathLength = static_cast<uint32_t>(items[i].path->size());
+        offset = AlignUp(offset + entry.pathLength);
+        entry.sourceOffset = static_cast<uint32_t>(offset);
+        entry.sourceLength = items[i].length;
+        entry.flags = items[i].flags;
+        offset = AlignUp(offset + items[i].data.size());
+        // 代码缓存按 8 字节对齐，v8 不需要再复制一份
+        entry.cacheOffset = items[i].cache.empty() ? 0 : static_cast<uint32_t>(offset);
+        entry.cacheLength = static_cast<uint32_t>(items[i].cache.size());
+        offset += items[i].cache.size();
+    }
+    if (offset > UINT32_MAX) {
+        return false;
+    }
+
+    std::string buffer(offset, '\0');
+    memcpy(&buffer[0], &header, sizeof(header));
+    if (!entries.empty()) {
+        memcpy(&buffer[sizeof(Header)], entries.data(), sizeof(Entry) * entries.size());
+    }
+    for (size_t i = 0; i < items.size(); i++) {
+        memcpy(&buffer[entries[i].pathOffset], items[i].path->data(), entries[i].pathLength);
+        memcpy(&buffer[entries[i].sourceOffset], items[i].data.data(), items[i].data.size());
+        if (entries[i].cacheLength > 0) {
+            memcpy(&buffer[entries[i].cacheOffset], items[i].cache.data(), entries[i].cacheLength);
+        }
+    }
+    // 先写临时文件再重命名，避免正在运行的进程映射到写了一半的归档
+    std::string temp = file + ".tmp";
+    {
+        std::ofstream out(temp.c_str(), std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            return false;
+        }
+        out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        if (!out.good()) {
+            return false;
+        }
+    }
+#if defined(WIN)
+    std::remove(file.c_str());
+#endif
+    return std::rename(temp.c_str(), file.c_str()) == 0;
+}
+
+std::unique_ptr<ModuleArchive> ModuleArchive::Open(const std::string &file, std::string mountPoint) {
+    std::unique_ptr<MappedFile> mapped = MappedFile::Open(file);
+    if (mapped == nullptr) {
+        return nullptr;
+    }
+    std::unique_ptr<ModuleArchive> archive(new ModuleArchive(std::move(mapped), std::move(mountPoint)));
+    if (!archive->validate()) {
+        return nullptr;
+    }
+    return archive;
+}
+
+ModuleArchive::ModuleArchive(std::shared_ptr<MappedFile> file, std::string mountPoint)
+    : _file(std::move(file)), _mount_point(std::move(mountPoint)) {
+    // 归档内的路径以 "/" 开头，挂载点去掉末尾的分隔符
+    if (!_mount_point.empty() && _mount_point.back() == '/') {
+        _mount_point.pop_back();
+    }
+}
+
+bool ModuleArchive::validate() {
+    const char *data = _file->data();
+    uint64_t size = _file->size();
+    if (size < sizeof(Header)) {
+        return false;
+    }
+    _header = reinterpret_cast<const Header *>(data);
+    if (memcmp(_header->magic, kMagic, sizeof(kMagic)) != 0 || _header->version != kVersion) {
+        return false;
+    }
+    if (sizeof(Header) + static_cast<uint64_t>(_header->count) * sizeof(Entry) > size) {
+        return false;
+    }
+    _entries = reinterpret_cast<const Entry *>(data + sizeof(Header));
+    _count = _header->count;
+    for (uint32_t i = 0; i < _count; i++) {
+        const Entry &entry = _entries[i];
+        uint64_t sourceBytes = static_cast<uint64_t>(entry.sourceLength) * ((entry.flags & Entry::kTwoByte) ? 2 : 1);
+        if (static_cast<uint64_t>(entry.pathOffset) + entry.pathLength > size ||
+            static_cast<uint64_t>(entry.sourceOffset) + sourceBytes > size ||
+            static_cast<uint64_t>(entry.cacheOffset) + entry.cacheLength > size) {
+            return false;
+        }
+        if ((entry.flags & Entry::kTwoByte) && entry.sourceOffset % 2 != 0) {
+            return false;
+        }
+        // 二分查找要求索引严格有序
+        if (i > 0) {
+            const Entry &previous = _entries[i - 1];
+            int order = memcmp(data + previous.pathOffset, data + entry.pathOffset, std::min(previous.pathLength, entry.pathLength));
+            if (order > 0 || (order == 0 && previous.pathLength >= entry.pathLength)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+const ModuleArchive::Entry *ModuleArchive::find(const std::string &path) const {
+    size_t prefix = _mount_point.size();
+    if (path.size() <= prefix || path.compare(0, prefix, _mount_point) != 0 || path[prefix] != '/') {
+        return nullptr;
+    }
+    const char *key = path.data() + prefix;
+    size_t keyLength = path.size() - prefix;
+    const char *data = _file->data();
+    uint32_t low = 0;
+    uint32_t high = _count;
+    while (low < high) {
+        uint32_t middle = low + (high - low) / 2;
+        const Entry &entry = _entries[middle];
+        int order = memcmp(data + entry.pathOffset, key, std::min<size_t>(entry.pathLength, keyLength));
+        if (order == 0) {
+            if (entry.pathLength == keyLength) {
+                return &entry;
+            }
+            order = entry.pathLength < keyLength ? -1 : 1;
+        }
+        if (order < 0) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return nullptr;
+}
+
+v8::MaybeLocal<v8::String> ModuleArchive::loadSource(v8::Isolate *isolate, const std::string &path) {
+    const Entry *entry = find(path);
+    if (entry == nullptr) {
+        return v8::MaybeLocal<v8::String>();
+    }
+    const char *data = _file->data() + entry->sourceOffset;
+    v8::Local<v8::String> result;
+    if (entry->flags & Entry::kTwoByte) {
+        auto *resource = new ArchiveTwoByteResource(_file, reinterpret_cast<const uint16_t *>(data), entry->sourceLength);
+        if (!v8::String::NewExternalTwoByte(isolate, resource).ToLocal(&result)) {
+            delete resource;
+            return v8::MaybeLocal<v8::String>();
+        }
+        return result;
+    }
+    auto *resource = new ArchiveOneByteResource(_file, data, entry->sourceLength);
+    if (!v8::String::NewExternalOneByte(isolate, resource).ToLocal(&result)) {
+        delete resource;
+        return v8::MaybeLocal<v8::String>();
+    }
+    return result;
+}
+
+v8::MaybeLocal<v8::Module> ModuleArchive::compileModule(v8::Isolate *isolate, const std::string &path) {
+    v8::EscapableHandleScope handleScope(isolate);
+    const Entry *entry = find(path);
+    v8::Local<v8::String> source;
+    v8::Local<v8::String> name;
+    if (entry == nullptr || !loadSource(isolate, path).ToLocal(&source) ||
+        !v8::String::NewFromUtf8(isolate, path.c_str()).ToLocal(&name)) {
+        return v8::MaybeLocal<v8::Module>();
+    }
+    v8::ScriptOrigin origin(isolate, name, 0, 0, false, -1, v8::Local<v8::Value>(), false, false, true);
+    v8::Local<v8::Module> module;
+    // 版本或者 flags 不一致的代码缓存一定会被拒绝，直接从源码编译
+    if (entry->cacheLength > 0 && _header->cacheTag == v8::ScriptCompiler::CachedDataVersionTag()) {
+        // 代码缓存直接引用映射的内存，不转移所有权
+        auto *cachedData = new v8::ScriptCompiler::CachedData(reinterpret_cast<const uint8_t *>(_file->data() + entry->cacheOffset),
+                                                              static_cast<int>(entry->cacheLength),
+                                                              v8::ScriptCompiler::CachedData::BufferNotOwned);
+        v8::ScriptCompiler::Source moduleSource(source, origin, cachedData);
+        if (!v8::ScriptCompiler::CompileModule(isolate, &moduleSource, v8::ScriptCompiler::kConsumeCodeCache).ToLocal(&module)) {
+            return v8::MaybeLocal<v8::Module>();
+        }
+        if (moduleSource.GetCachedData()->rejected) {
+            _cache_reject_count++;
+        } else {
+            _cache_hit_count++;
+        }
+        return handleScope.Escape(module);
+    }
+    v8::ScriptCompiler::Source moduleSource(source, origin);
+    if (!v8::ScriptCompiler::CompileModule(isolate, &moduleSource).ToLocal(&module)) {
+        return v8::MaybeLocal<v8::Module>();
+    }
+    return handleScope.Escape(module);
+}
@@ -0,0 +1,143 @@
+//
+// Created by user on 2026/10/17.
+//
+
+#ifndef V8_LEARN_MODULE_ARCHIVE_H
+#define V8_LEARN_MODULE_ARCHIVE_H
+#include "sourceFile.h"
+#include "v8.h"
+#include <atomic>
+#include <map>
+#include <memory>
+#include <string>
+
+/**
+ * 单文件模块归档。
+ * 多个模块的源码和预编译的代码缓存打包成一个文件，运行时整体映射到内存：
+ * 按路径排序的索引用二分查找，源码直接作为外部字符串交给 v8，代码缓存直接交给 kConsumeCodeCache，
+ * 加载单个模块不再有 open/read 等系统调用，也不会复制源码。
+ *
+ * 文件格式（小端，所有偏移相对于文件开头，数据按 8 字节对齐）：
+ *   Header
+ *   Entry[count]，按路径的字节序排序
+ *   路径、源码和代码缓存
+ * 纯 ASCII 的源码按单字节保存，其他源码在打包时解码为 UTF-16 保存，两者都可以直接作为外部字符串。
+ */
+class ModuleArchive {
+public:
+    static const char kMagic[8];
+    static const uint32_t kVersion = 1;
+
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t count;
+        // 生成代码缓存时的 ScriptCompiler::CachedDataVersionTag()，没有代码缓存时为 0
+        uint32_t cacheTag;
+        uint32_t reserved;
+    };
+
+    struct Entry {
+        enum Flags : uint32_t {
+            // 源码是 UTF-16，否则是单字节
+            kTwoByte = 1,
+        };
+        uint32_t pathOffset;
+        uint32_t pathLength;
+        uint32_t sourceOffset;
+        // 源码的字符数
+        uint32_t sourceLength;
+        uint32_t cacheOffset;
+        uint32_t cacheLength;
+        uint32_t flags;
+        uint32_t reserved;
+    };
+
+    /**
+     * 打包工具：收集模块源码，写出归档文件
+     */
+    class Builder {
+    public:
+        /**
+         * 添加模块
+         * @param path 归档内的路径，以 "/" 开头
+         * @param source UTF-8 源码
+         * @return 源码不是合法的 UTF-8 时返回 false
+         */
+        bool add(const std::string &path, const std::string &source);
+        /**
+         * 写出归档文件
+         * @param file
+         * @param isolate 不为空时编译每个模块并保存代码缓存
+         * @return
+         */
+        bool write(const std::string &file, v8::Isolate *isolate = nullptr);
+
+        size_t getSize() const { return _sources.size(); }
+
+    private:
+        // 有序保存，写出的索引即为排序后的
+        std::map<std::string, std::string> _sources;
+    };
+
+    /**
+     * 映射归档文件，文件格式不正确时返回 nullptr
+     * @param file
+     * @param mountPoint 归档挂载的目录，模块路径去掉该前缀后在归档中查找
+     * @return
+     */
+    static std::unique_ptr<ModuleArchive> Open(const std::string &file, std::string mountPoint);
+    ModuleArchive(const ModuleArchive &) = delete;
+    ModuleArchive &operator=(const ModuleArchive &) = delete;
+
+    /**
+     * 模块是否在归档中
+     * @param path 模块的绝对路径
+     * @return
+     */
+    bool contains(const std::string &path) const { return find(path) != nullptr; }
+    /**
+     * 创建模块源码的外部字符串，字符串引用映射的内存，归档对象析构后仍然有效
+     * @param isolate
+     * @param path
+     * @return 不在归档中时返回空
+     */
+    v8::MaybeLocal<v8::String> loadSource(v8::Isolate *isolate, const std::string &path);
+    /**
+     * 编译模块，有匹配的代码缓存时跳过解析和编译
+     * @param isolate
+     * @param path
+     * @return 不在归档中或者编译失败时返回空
+     */
+    v8::MaybeLocal<v8::Module> compileModule(v8::Isolate *isolate, const std::string &path);
+
+    size_t getSize() const { return _count; }
+    const std::string &getMountPoint() const { return _mount_point; }
+    uint64_t getCacheHitCount() const { return _cache_hit_count.load(); }
+    uint64_t getCacheRejectCount() const { return _cache_reject_count.load(); }
+
+private:
+    ModuleArchive(std::shared_ptr<MappedFile> file, std::string mountPoint);
+    /**
+     * 校验文件头和索引，所有偏移都必须落在文件内
+     * @return
+     */
+    bool validate();
+    /**
+     * 二分查找模块，不分配内存
+     * @param path
+     * @return
+     */
+    const Entry *find(const std::string &path) const;
+
+    // 外部字符串持有映射的共享引用
+    std::shared_ptr<MappedFile> _file;
+    std::string _mount_point;
+    const Header *_header = nullptr;
+    const Entry *_entries = nullptr;
+    uint32_t _count = 0;
+    std::atomic<uint64_t> _cache_hit_count{0};
+    std::atomic<uint64_t> _cache_reject_count{0};
+};
+
+#endif//V8_LEARN_MODULE_ARCHIVE_H
@@ -0,0 +1,103 @@
+//
+// Created by user on 2026/10/17.
+//
+
+#include "moduleGraphLoader.h"
+
+ModuleGraphLoader::ModuleGraphLoader(ModuleMap *moduleMap, SourceReader reader, ThreadPool *threadPool)
+    : _module_map(moduleMap), _reader(std::move(reader)),
+      _thread_pool(threadPool == nullptr ? ThreadPool::GetDefault() : threadPool) {
+    if (_reader == nullptr) {
+        _reader = StreamedModule::DefaultReader();
+    }
+}
+
+v8::MaybeLocal<v8::Module> ModuleGraphLoader::load(v8::Local<v8::Context> context, const std::string &path) {
+    v8::Isolate *isolate = context->GetIsolate();
+    v8::EscapableHandleScope handleScope(isolate);
+    _compiled_count = 0;
+    _scheduled.clear();
+    // 合成模块没有源码需要编译，直接由模块表创建
+    if (ModuleMap::IsSynthetic(path)) {
+        v8::Local<v8::Module> module;
+        if (!_module_map->load(path).ToLocal(&module) ||
+            (module->GetStatus() == v8::Module::kUninstantiated && !module->InstantiateModule(context, ModuleMap::ResolveCallback).FromMaybe(false))) {
+            return v8::MaybeLocal<v8::Module>();
+        }
+        return handleScope.Escape(module);
+    }
+    if (!_module_map->contains(path)) {
+        schedule(isolate, path);
+    }
+    bool failed = false;
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (_in_flight > 0) {
+        _condition.wait(lock, [this]() -> bool { return !_completed.empty(); });
+        std::unique_ptr<StreamedModule> streamed(_completed.front());
+        _completed.pop_front();
+        _in_flight--;
+        // 失败后不再提交新的模块，只等待已经提交的任务结束
+        if (failed) {
+            continue;
+        }
+        lock.unlock();
+        failed = !finish(context, streamed.get());
+        lock.lock();
+    }
+    lock.unlock();
+    if (failed) {
+        return v8::MaybeLocal<v8::Module>();
+    }
+    v8::Local<v8::Module> module;
+    if (!_module_map->get(path).ToLocal(&module)) {
+        return v8::MaybeLocal<v8::Module>();
+    }
+    if (module->GetStatus() == v8::Module::kUninstantiated &&
+        !module->InstantiateModule(context, ModuleMap::ResolveCallback).FromMaybe(false)) {
+        return v8::MaybeLocal<v8::Module>();
+    }
+    return handleScope.Escape(module);
+}
+
+void ModuleGraphLoader::schedule(v8::Isolate *isolate, const std::string &path) {
+    if (!_scheduled.insert(path).second) {
+        return;
+    }
+    auto *streamed = new StreamedModule(isolate, path, &_reader);
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _in_flight++;
+    }
+    _thread_pool->submit([this, streamed]() -> void {
+        streamed->run();
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _completed.push_back(streamed);
+        }
+        _condition.notify_one();
+    });
+}
+
+bool ModuleGraphLoader::finish(v8::Local<v8::Context> context, StreamedModule *streamed) {
+    v8::Isolate *isolate = context->GetIsolate();
+    v8::HandleScope handleScope(isolate);
+    v8::Local<v8::Module> module;
+    if (!streamed->finish(context).ToLocal(&module)) {
+        return false;
+    }
+    const std::string &referrerPath = streamed->getPath();
+    _module_map->insert(referrerPath, module);
+    _compiled_count++;
+    // 提交还没有加载的依赖
+    v8::Local<v8::FixedArray> requests = module->GetModuleRequests();
+    for (int i = 0; i < requests->Length(); i++) {
+        v8::Local<v8::ModuleRequest> request = requests->Get(context, i).As<v8::ModuleRequest>();
+        v8::String::Utf8Value specifier(isolate, request->GetSpecifier());
+        std::string path = _module_map->resolve(*specifier, referrerPath);
+        // 合成模块在实例化时由解析回调创建
+        if (!_module_map->contains(path) && !ModuleMap::IsSynthetic(path)) {
+            schedule(isolate, path);
+        }
+    }
+    return true;
+}
@@ -0,0 +1,73 @@
+//
+// Created by user on 2026/10/17.
+//
+
+#ifndef V8_LEARN_MODULE_GRAPH_LOADER_H
+#define V8_LEARN_MODULE_GRAPH_LOADER_H
+#include "moduleMap.h"
+#include "streamedModule.h"
+#include "threadPool.h"
+#include "v8.h"
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+
+/**
+ * 并行加载 es 模块依赖图。
+ * 在实例化之前遍历导入关系：每个模块的读取和编译（ScriptCompiler::StartStreaming）在线程池中进行，
+ * 隔离实例所在的线程只负责完成编译、解析导入的说明符并提交新的模块，
+ * 所有模块编译完成后放入模块表，最后一次性实例化，实例化时的解析全部命中模块表。
+ */
+class ModuleGraphLoader {
+public:
+    using SourceReader = StreamedModule::SourceReader;
+
+    /**
+     * @param moduleMap 加载的模块放入该模块表，已经在表中的模块不会重复加载
+     * @param reader 为空时从文件系统读取
+     * @param threadPool 为空时使用默认线程池
+     */
+    explicit ModuleGraphLoader(ModuleMap *moduleMap, SourceReader reader = nullptr, ThreadPool *threadPool = nullptr);
+
+    /**
+     * 加载并实例化模块及其所有依赖，失败时返回空并且隔离实例上有待处理的异常
+     * @param context
+     * @param path 入口模块的绝对路径
+     * @return
+     */
+    v8::MaybeLocal<v8::Module> load(v8::Local<v8::Context> context, const std::string &path);
+
+    /**
+     * 本次加载编译的模块数量
+     * @return
+     */
+    size_t getCompiledCount() const { return _compiled_count; }
+
+private:
+    void schedule(v8::Isolate *isolate, const std::string &path);
+    /**
+     * 完成编译并把模块放入模块表，提交尚未加载的依赖
+     * @param context
+     * @param streamed
+     * @return
+     */
+    bool finish(v8::Local<v8::Context> context, StreamedModule *streamed);
+
+    ModuleMap *_module_map;
+    SourceReader _reader;
+    ThreadPool *_thread_pool;
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    // 工作线程编译完成等待隔离实例线程处理的任务
+    std::deque<StreamedModule *> _completed;
+    // 已经提交的模块路径，避免同一个模块被多个导入方重复提交
+    std::unordered_set<std::string> _scheduled;
+    size_t _in_flight = 0;
+    size_t _compiled_count = 0;
+};
+
+#endif//V8_LEARN_MODULE_GRAPH_LOADER_H
@@ -0,0 +1,274 @@
+//
+// Created by user on 2026/10/17.
+//
+
+#include "moduleMap.h"
+#include "embedderData.h"
+#include "environment.h"
+#include "nodeBuildInModule.h"
+#include "sourceFile.h"
+
+namespace {
+    // 内建模块路径的前缀
+    const char kBuildInPrefix[] = "node:";
+    const size_t kBuildInPrefixLength = sizeof(kBuildInPrefix) - 1;
+
+    bool EndsWith(const std::string &value, const char *suffix, size_t length) {
+        return value.size() >= length && value.compare(value.size() - length, length, suffix) == 0;
+    }
+}// namespace
+
+ModuleMap::ModuleMap(v8::Local<v8::Context> context, std::string baseDirectory, SourceLoader loader, CodeCache *codeCache)
+    : _isolate(context->GetIsolate()), _context(context->GetIsolate(), context), _base_directory(std::move(baseDirectory)),
+      _loader(std::move(loader)), _code_cache(codeCache) {
+    if (_loader == nullptr) {
+        _loader = [](v8::Isolate *isolate, const std::string &path) -> v8::MaybeLocal<v8::String> {
+            return SourceFile::Load(isolate, path);
+        };
+    }
+    ContextEmbedderData::SetPointer(context, ContextEmbedderIndex::kModuleMap, this);
+}
+
+ModuleMap::~ModuleMap() {
+    v8::HandleScope handleScope(_isolate);
+    ContextEmbedderData::SetPointer(_context.Get(_isolate), ContextEmbedderIndex::kModuleMap, nullptr);
+}
+
+ModuleMap *ModuleMap::FromContext(v8::Local<v8::Context> context) {
+    return static_cast<ModuleMap *>(ContextEmbedderData::GetPointer(context, ContextEmbedderIndex::kModuleMap));
+}
+
+v8::MaybeLocal<v8::Module> ModuleMap::ResolveCallback(v8::Local<v8::Context> context, v8::Local<v8::String> specifier,
+                                                      v8::Local<v8::FixedArray> import_assertions, v8::Local<v8::Module> referrer) {
+    v8::Isolate *isolate = context->GetIsolate();
+    ModuleMap *moduleMap = FromContext(context);
+    if (moduleMap == nullptr) {
+        isolate->ThrowException(v8::Exception::Error(v8::String::NewFromUtf8Literal(isolate, "module map not found")));
+        return v8::MaybeLocal<v8::Module>();
+    }
+    v8::String::Utf8Value value(isolate, specifier);
+    std::string path = moduleMap->resolve(*value, moduleMap->getPath(referrer));
+    return moduleMap->load(path);
+}
+
+bool ModuleMap::IsSynthetic(const std::string &path) {
+    return path.compare(0, kBuildInPrefixLength, kBuildInPrefix) == 0 || EndsWith(path, ".json", 5);
+}
+
+std::string ModuleMap::resolve(const std::string &specifier, const std::string &referrerPath) {
+    // 内建模块优先于同名的文件，与 node 一致
+    if (specifier.compare(0, kBuildInPrefixLength, kBuildInPrefix) == 0) {
+        return specifier;
+    }
+    if (findBuildInNodeModule(specifier.data(), specifier.size()) != nullptr) {
+        return kBuildInPrefix + specifier;
+    }
+    if (Environment::IsAbsolutePath(specifier)) {
+        return Environment::NormalizePath(specifier, "");
+    }
+    bool relative = specifier.compare(0, 2, "./") == 0 || specifier.compare(0, 3, "../") == 0;
+    std::string directory = relative && !referrerPath.empty() ? Environment::DirName(referrerPath) : _base_directory;
+    // 根目录 "/" 去掉末尾的分隔符，避免拼接出 "//"
+    if (!directory.empty() && directory.back() == '/') {
+        directory.pop_back();
+    }
+    return Environment::NormalizePath(specifier, directory);
+}
+
+v8::MaybeLocal<v8::Module> ModuleMap::load(const std::string &path) {
+    v8::EscapableHandleScope handleScope(_isolate);
+    auto it = _modules.find(path);
+    if (it != _modules.end()) {
+        _hit_count++;
+        return handleScope.Escape(it->second.Get(_isolate));
+    }
+    _miss_count++;
+    if (path.compare(0, kBuildInPrefixLength, kBuildInPrefix) == 0) {
+        return handleScope.EscapeMaybe(loadBuildIn(path));
+    }
+    if (EndsWith(path, ".json", 5)) {
+        return handleScope.EscapeMaybe(loadJson(path));
+    }
+    v8::Local<v8::Module> module;
+    // 归档中的模块直接引用映射的源码和代码缓存
+    if (_archive != nullptr && _archive->contains(path)) {
+        if (!_archive->compileModule(_isolate, path).ToLocal(&module)) {
+            return v8::MaybeLocal<v8::Module>();
+        }
+        insert(path, module);
+        return handleScope.Escape(module);
+    }
+    v8::Local<v8::String> source;
+    if (!_loader(_isolate, path).ToLocal(&source)) {
+        if (!_isolate->IsExecutionTerminating()) {
+            std::string message = "Cannot find module '" + path + "'";
+            _isolate->ThrowException(v8::Exception::Error(v8::String::NewFromUtf8(_isolate, message.c_str()).ToLocalChecked()));
+        }
+        return v8::MaybeLocal<v8::Module>();
+    }
+    v8::ScriptOrigin origin(_isolate, v8::String::NewFromUtf8(_isolate, path.c_str()).ToLocalChecked(), 0, 0, false, -1,
+                            v8::Local<v8::Value>(), false, false, true);
+    if (_code_cache != nullptr) {
+        if (!_code_cache->compileModule(_isolate, source, origin).ToLocal(&module)) {
+            return v8::MaybeLocal<v8::Module>();
+        }
+    } else {
+        v8::ScriptCompiler::Source compilerSource(source, origin);
+        if (!v8::ScriptCompiler::CompileModule(_isolate, &compilerSource).ToLocal(&module)) {
+            return v8::MaybeLocal<v8::Module>();
+        }
+    }
+    insert(path, module);
+    return handleScope.Escape(module);
+}
+
+bool ModuleMap::insert(const std::string &path, v8::Local<v8::Module> module) {
+    if (_modules.find(path) != _modules.end()) {
+        return false;
+    }
+    _modules.emplace(path, v8::Global<v8::Module>(_isolate, module));
+    _paths.emplace(module->GetIdentityHash(), path);
+    return true;
+}
+
+v8::MaybeLocal<v8::Module> ModuleMap::get(const std::string &path) {
+    auto it = _modules.find(path);
+    if (it == _modules.end()) {
+        return v8::MaybeLocal<v8::Module>();
+    }
+    _hit_count++;
+    return it->second.Get(_isolate);
+}
+
+std::string ModuleMap::getPath(v8::Local<v8::Module> module) {
+    auto range = _paths.equal_range(module->GetIdentityHash());
+    for (auto it = range.first; it != range.second; ++it) {
+        if (_modules[it->second] == module) {
+            return it->second;
+        }
+    }
+    return "";
+}
+
+v8::MaybeLocal<v8::Module> ModuleMap::loadJson(const std::string &path) {
+    v8::EscapableHandleScope handleScope(_isolate);
+    v8::Local<v8::Context> context = _context.Get(_isolate);
+    v8::Local<v8::String> source;
+    if (!_loader(_isolate, path).ToLocal(&source)) {
+        if (!_isolate->IsExecutionTerminating()) {
+            std::string message = "Cannot find module '" + path + "'";
+            _isolate->ThrowException(v8::Exception::Error(v8::String::NewFromUtf8(_isolate, message.c_str()).ToLocalChecked()));
+        }
+        return v8::MaybeLocal<v8::Module>();
+    }
+    // 解析在创建模块时完成，语法错误在导入方实例化时抛出，而不是执行时
+    v8::Local<v8::Value> value;
+    if (_json_cache != nullptr) {
+        if (!_json_cache->parse(context, source).ToLocal(&value)) {
+            return v8::MaybeLocal<v8::Module>();
+        }
+    } else if (!v8::JSON::Parse(context, source).ToLocal(&value)) {
+        return v8::MaybeLocal<v8::Module>();
+    }
+    return handleScope.Escape(createSyntheticModule(path, value, v8::Local<v8::Array>()));
+}
+
+v8::MaybeLocal<v8::Module> ModuleMap::loadBuildIn(const std::string &path) {
+    v8::EscapableHandleScope handleScope(_isolate);
+    v8::Local<v8::Context> context = _context.Get(_isolate);
+    v8::Context::Scope contextScope(context);
+    const char *name = path.c_str() + kBuildInPrefixLength;
+    size_t length = path.size() - kBuildInPrefixLength;
+    if (findBuildInNodeModule(name, length) == nullptr) {
+        std::string message = "No such built-in module: '" + path + "'";
+        _isolate->ThrowException(v8::Exception::Error(v8::String::NewFromUtf8(_isolate, message.c_str()).ToLocalChecked()));
+        return v8::MaybeLocal<v8::Module>();
+    }
+    // 通过 internalBinding 取得导出对象，与 process.binding 和 require 共享同一个导出缓存
+    v8::Local<v8::Function> binding;
+    v8::Local<v8::Value> argv[1];
+    v8::Local<v8::Value> exports;
+    if (!v8::Function::New(context, internalBinding).ToLocal(&binding) ||
+        !v8::String::NewFromUtf8(_isolate, name, v8::NewStringType::kNormal, static_cast<int>(length)).ToLocal(&argv[0]) ||
+        !binding->Call(context, v8::Undefined(_isolate), 1, argv).ToLocal(&exports)) {
+        return v8::MaybeLocal<v8::Module>();
+    }
+    v8::Local<v8::Array> names;
+    if (!exports->IsObject()) {
+        names = v8::Array::New(_isolate);
+    } else if (!exports.As<v8::Object>()
+                        ->GetOwnPropertyNames(context, v8::PropertyFilter::SKIP_SYMBOLS, v8::KeyConversionMode::kConvertToString)
+                        .ToLocal(&names)) {
+        return v8::MaybeLocal<v8::Module>();
+    }
+    return handleScope.Escape(createSyntheticModule(path, exports, names));
+}
+
+v8::Local<v8::Module> ModuleMap::createSyntheticModule(const std::string &path, v8::Local<v8::Value> defaultExport, v8::Local<v8::Array> names) {
+    v8::EscapableHandleScope handleScope(_isolate);
+    v8::Local<v8::Context> context = _context.Get(_isolate);
+    v8::Local<v8::String> defaultName = v8::String::NewFromUtf8Literal(_isolate, "default");
+    std::vector<v8::Local<v8::String>> exportNames = {defaultName};
+    if (!names.IsEmpty()) {
+        for (uint32_t i = 0; i < names->Length(); i++) {
+            v8::Local<v8::String> name = names->Get(context, i).ToLocalChecked().As<v8::String>();
+            // 导出名称不能重复，exports 上名为 default 的属性会被整个 exports 对象覆盖
+            if (!name->StringEquals(defaultName)) {
+                exportNames.push_back(name);
+            }
+        }
+    }
+    v8::Local<v8::Module> module = v8::Module::CreateSyntheticModule(
+            _isolate, v8::String::NewFromUtf8(_isolate, path.c_str()).ToLocalChecked(), exportNames, EvaluateSyntheticModule);
+    SyntheticExports &exports = _synthetic_exports[path];
+    exports.defaultExport.Reset(_isolate, defaultExport);
+    if (!names.IsEmpty()) {
+        exports.names.Reset(_isolate, names);
+    }
+    insert(path, module);
+    return handleScope.Escape(module);
+}
+
+v8::MaybeLocal<v8::Value> ModuleMap::EvaluateSyntheticModule(v8::Local<v8::Context> context, v8::Local<v8::Module> module) {
+    v8::Isolate *isolate = context->GetIsolate();
+    v8::EscapableHandleScope handleScope(isolate);
+    ModuleMap *moduleMap = FromContext(context);
+    if (moduleMap == nullptr) {
+        isolate->ThrowException(v8::Exception::Error(v8::String::NewFromUtf8Literal(isolate, "module map not found")));
+        return v8::MaybeLocal<v8::Value>();
+    }
+    auto it = moduleMap->_synthetic_exports.find(moduleMap->getPath(module));
+    if (it == moduleMap->_synthetic_exports.end()) {
+        isolate->ThrowException(v8::Exception::Error(v8::String::NewFromUtf8Literal(isolate, "synthetic module exports not found")));
+        return v8::MaybeLocal<v8::Value>();
+    }
+    // 模块只会执行一次，执行后不再持有导出值，之后由模块本身持有
+    SyntheticExports exports = std::move(it->second);
+    moduleMap->_synthetic_exports.erase(it);
+    v8::Local<v8::Value> defaultExport = exports.defaultExport.Get(isolate);
+    if (module->SetSyntheticModuleExport(isolate, v8::String::NewFromUtf8Literal(isolate, "default"), defaultExport).IsNothing()) {
+        return v8::MaybeLocal<v8::Value>();
+    }
+    if (!exports.names.IsEmpty()) {
+        v8::Local<v8::Array> names = exports.names.Get(isolate);
+        v8::Local<v8::String> defaultName = v8::String::NewFromUtf8Literal(isolate, "default");
+        for (uint32_t i = 0; i < names->Length(); i++) {
+            v8::Local<v8::String> name = names->Get(context, i).ToLocalChecked().As<v8::String>();
+            v8::Local<v8::Value> value;
+            if (name->StringEquals(defaultName)) {
+                continue;
+            }
+            // 懒创建的函数在这里第一次被访问
+            if (!defaultExport.As<v8::Object>()->Get(context, name).ToLocal(&value) ||
+                module->SetSyntheticModuleExport(isolate, name, value).IsNothing()) {
+                return v8::MaybeLocal<v8::Value>();
+            }
+        }
+    }
+    // 开启顶层 await 时执行步骤需要返回一个已经兑现的 promise
+    v8::Local<v8::Promise::Resolver> resolver;
+    if (!v8::Promise::Resolver::New(context).ToLocal(&resolver) || resolver->Resolve(context, v8::Undefined(isolate)).IsNothing()) {
+        return v8::MaybeLocal<v8::Value>();
+    }
+    return handleScope.Escape(resolver->GetPromise());
+}
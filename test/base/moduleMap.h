@@ -0,0 +1,164 @@
+//
+// Created by user on 2026/10/17.
+//
+
+#ifndef V8_LEARN_MODULE_MAP_H
+#define V8_LEARN_MODULE_MAP_H
+#include "codeCache.h"
+#include "jsonModuleCache.h"
+#include "moduleArchive.h"
+#include "v8.h"
+#include <functional>
+#include <string>
+#include <unordered_map>
+
+/**
+ * 上下文的模块表。
+ * 以解析后的绝对路径为键保存编译好的模块，同一个模块无论被多少个模块导入都只编译一次；
+ * 同时保存模块到路径的反向映射，用于解析相对于导入方的路径。
+ * 模块表保存在上下文的嵌入数据中，生命周期由创建方管理，必须在上下文销毁前析构。
+ * ".json" 模块和内建模块（"node:" 前缀或者内建模块名称）创建为合成模块，不编译任何 js 源码。
+ */
+class ModuleMap {
+public:
+    /**
+     * 加载模块源码，加载失败时返回空
+     */
+    using SourceLoader = std::function<v8::MaybeLocal<v8::String>(v8::Isolate *isolate, const std::string &path)>;
+
+    /**
+     * @param context
+     * @param baseDirectory 解析非相对路径的说明符时使用的目录
+     * @param loader 源码加载函数，为空时从文件系统加载
+     * @param codeCache 代码缓存，为空时直接编译
+     */
+    ModuleMap(v8::Local<v8::Context> context, std::string baseDirectory, SourceLoader loader = nullptr, CodeCache *codeCache = nullptr);
+    ~ModuleMap();
+    ModuleMap(const ModuleMap &) = delete;
+    ModuleMap &operator=(const ModuleMap &) = delete;
+
+    /**
+     * 获取上下文的模块表，没有时返回 nullptr
+     * @param context
+     * @return
+     */
+    static ModuleMap *FromContext(v8::Local<v8::Context> context);
+    /**
+     * 用于 Module::InstantiateModule 的解析回调
+     */
+    static v8::MaybeLocal<v8::Module> ResolveCallback(v8::Local<v8::Context> context, v8::Local<v8::String> specifier,
+                                                      v8::Local<v8::FixedArray> import_assertions, v8::Local<v8::Module> referrer);
+
+    /**
+     * 判断路径是否对应合成模块，合成模块没有需要编译的源码，不能交给流式编译
+     * @param path resolve 的结果
+     * @return
+     */
+    static bool IsSynthetic(const std::string &path);
+
+    /**
+     * 把说明符解析为绝对路径。"./" 和 "../" 开头的相对于导入方所在的目录，其他相对于 baseDirectory。
+     * 内建模块解析为 "node:" 加模块名称
+     * @param specifier
+     * @param referrerPath 导入方的路径，为空时相对于 baseDirectory
+     * @return
+     */
+    std::string resolve(const std::string &specifier, const std::string &referrerPath);
+    /**
+     * 加载模块，已经加载过时直接返回缓存的模块
+     * @param path 绝对路径
+     * @return
+     */
+    v8::MaybeLocal<v8::Module> load(const std::string &path);
+    /**
+     * 登记在外部编译的模块
+     * @param path
+     * @param module
+     * @return 路径已经存在时返回 false
+     */
+    bool insert(const std::string &path, v8::Local<v8::Module> module);
+    /**
+     * 查找已经加载的模块
+     * @param path
+     * @return
+     */
+    v8::MaybeLocal<v8::Module> get(const std::string &path);
+    /**
+     * 查找模块的路径，不在模块表中时返回空字符串
+     * @param module
+     * @return
+     */
+    std::string getPath(v8::Local<v8::Module> module);
+    /**
+     * 判断模块是否已经加载，不计入命中次数
+     * @param path
+     * @return
+     */
+    bool contains(const std::string &path) const { return _modules.find(path) != _modules.end(); }
+    /**
+     * 设置模块归档，load 时归档中有的模块直接从归档编译，不再调用源码加载函数
+     * @param archive 生命周期由调用方管理
+     */
+    void setArchive(ModuleArchive *archive) { _archive = archive; }
+    ModuleArchive *getArchive() const { return _archive; }
+    /**
+     * 设置 JSON 模块的解析缓存，为空时每次加载都重新解析
+     * @param jsonCache 生命周期由调用方管理，可以在多个模块表之间共享
+     */
+    void setJsonCache(JsonModuleCache *jsonCache) { _json_cache = jsonCache; }
+
+    size_t getSize() const { return _modules.size(); }
+    uint64_t getHitCount() const { return _hit_count; }
+    uint64_t getMissCount() const { return _miss_count; }
+
+private:
+    /**
+     * 合成模块的执行步骤，把加载时保存的导出值设置到模块上
+     */
+    static v8::MaybeLocal<v8::Value> EvaluateSyntheticModule(v8::Local<v8::Context> context, v8::Local<v8::Module> module);
+    /**
+     * 创建 JSON 模块，唯一的导出是 default
+     * @param path
+     * @return
+     */
+    v8::MaybeLocal<v8::Module> loadJson(const std::string &path);
+    /**
+     * 创建内建模块，导出 default 和 exports 对象自身的所有属性
+     * @param path
+     * @return
+     */
+    v8::MaybeLocal<v8::Module> loadBuildIn(const std::string &path);
+    /**
+     * 创建合成模块并登记导出值
+     * @param path
+     * @param defaultExport
+     * @param names default 以外的导出名称，值从 defaultExport 对象上读取，为空时只有 default
+     * @return
+     */
+    v8::Local<v8::Module> createSyntheticModule(const std::string &path, v8::Local<v8::Value> defaultExport, v8::Local<v8::Array> names);
+
+    /**
+     * 合成模块在执行前保存的导出
+     */
+    struct SyntheticExports {
+        v8::Global<v8::Value> defaultExport;
+        v8::Global<v8::Array> names;
+    };
+
+    v8::Isolate *_isolate;
+    v8::Global<v8::Context> _context;
+    std::string _base_directory;
+    SourceLoader _loader;
+    CodeCache *_code_cache;
+    ModuleArchive *_archive = nullptr;
+    JsonModuleCache *_json_cache = nullptr;
+    std::unordered_map<std::string, v8::Global<v8::Module>> _modules;
+    // 模块的标识哈希到路径，哈希可能冲突，需要比较模块本身
+    std::unordered_multimap<int, std::string> _paths;
+    // 等待执行的合成模块的导出，执行后移除
+    std::unordered_map<std::string, SyntheticExports> _synthetic_exports;
+    uint64_t _hit_count = 0;
+    uint64_t _miss_count = 0;
+};
+
+#endif//V8_LEARN_MODULE_MAP_H
@@ -0,0 +1,99 @@
+//
+// Created by user on 2026/10/17.
+//
+
+#ifndef V8_LEARN_MPSC_QUEUE_H
+#define V8_LEARN_MPSC_QUEUE_H
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+/**
+ * 无界的多生产者单消费者无锁队列（Vyukov 侵入式链表队列）。
+ * 生产者只对 _head 做一次原子交换再链接上一个节点，不会互相等待，也不会等待消费者；
+ * 消费者只读写 _tail，不需要原子的读改写操作。
+ * 生产者交换 _head 和链接 next 之间有一个很短的窗口，此时 pop 返回 kBusy 而不是 kEmpty：
+ * 元素已经入队但还不能取出，生产者完成链接后即可取出，消费者应当重试而不是把队列当作空的。
+ * push 可以在任意线程上调用，pop 和 empty 只能在消费者线程上调用。
+ */
+template<typename T>
+class MpscQueue {
+public:
+    enum class PopResult {
+        // 取出了一个元素
+        kItem,
+        // 队列为空
+        kEmpty,
+        // 有生产者正在入队，还没有完成链接，稍后重试
+        kBusy,
+    };
+
+    MpscQueue() : _head(&_stub), _tail(&_stub) {}
+    ~MpscQueue() {
+        T value;
+        while (pop(value) == PopResult::kItem) {
+        }
+        // 最后一个取出的节点还作为哨兵留在队列中
+        if (_tail != &_stub) {
+            delete _tail;
+        }
+    }
+    MpscQueue(const MpscQueue &) = delete;
+    MpscQueue &operator=(const MpscQueue &) = delete;
+
+    /**
+     * 入队，可以在任意线程上调用
+     * @param value
+     */
+    void push(T value) {
+        Node *node = new Node(std::move(value));
+        Node *previous = _head.exchange(node, std::memory_order_acq_rel);
+        previous->next.store(node, std::memory_order_release);
+    }
+    /**
+     * 出队，只能在消费者线程上调用
+     * @param value
+     * @return
+     */
+    PopResult pop(T &value) {
+        Node *tail = _tail;
+        Node *next = tail->next.load(std::memory_order_acquire);
+        if (next == nullptr) {
+            // _head 已经不是哨兵说明有生产者交换了 _head 还没有链接
+            return _head.load(std::memory_order_acquire) == tail ? PopResult::kEmpty : PopResult::kBusy;
+        }
+        // next 成为新的哨兵节点，它的值已经被取走
+        value = std::move(next->value);
+        next->value = T();
+        _tail = next;
+        if (tail != &_stub) {
+            delete tail;
+        }
+        return PopResult::kItem;
+    }
+    /**
+     * 只能在消费者线程上调用
+     * @return 有生产者正在入队（pop 返回 kBusy）时也不为空
+     */
+    bool empty() const {
+        return _tail->next.load(std::memory_order_acquire) == nullptr && _head.load(std::memory_order_acquire) == _tail;
+    }
+
+private:
+    struct Node {
+        Node() = default;
+        explicit Node(T value) : value(std::move(value)) {}
+        std::atomic<Node *> next{nullptr};
+        T value;
+    };
+    static const size_t kCacheLineSize = 64;
+
+    // 最初的哨兵节点，不在堆上分配
+    Node _stub;
+    // 生产者交换的位置
+    alignas(kCacheLineSize) std::atomic<Node *> _head;
+    // 消费者独占
+    alignas(kCacheLineSize) Node *_tail;
+};
+
+#endif//V8_LEARN_MPSC_QUEUE_H
@@ -0,0 +1,254 @@
+//
+// Created by user on 2026/10/17.
+//
+
+#include "nodeBuildInModule.h"
+#include "embedderData.h"
+#include <cstdint>
+#include <cstring>
+
+namespace {
+    constexpr NodeModule kBuildInNodeModules[] = {
+#define V(name) {#name, name##BuildInModule, name##BuildInModuleTemplate},
+            BUILD_IN_MODULE_LIST(V)
+#undef V
+    };
+    constexpr size_t kModuleCount = sizeof(kBuildInNodeModules) / sizeof(kBuildInNodeModules[0]);
+
+    constexpr size_t Length(const char *name) {
+        size_t length = 0;
+        while (name[length] != '\0') {
+            length++;
+        }
+        return length;
+    }
+
+    /**
+     * 带种子的 32 位 FNV-1a 哈希
+     */
+    constexpr uint32_t Hash(const char *name, size_t length, uint32_t seed) {
+        uint32_t hash = 2166136261u ^ seed;
+        for (size_t i = 0; i < length; i++) {
+            hash ^= static_cast<uint8_t>(name[i]);
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
+    /**
+     * 哈希表大小为不小于模块数量两倍的 2 的幂，取模只需要按位与
+     */
+    constexpr size_t TableSize() {
+        size_t size = 1;
+        while (size < kModuleCount * 2) {
+            size <<= 1;
+        }
+        return size;
+    }
+    constexpr size_t kTableSize = TableSize();
+
+    constexpr size_t Slot(const char *name, size_t length, uint32_t seed) {
+        return Hash(name, length, seed) & (kTableSize - 1);
+    }
+
+    /**
+     * 判断种子是否让所有模块名称落在不同的槽位上
+     */
+    constexpr bool IsPerfect(uint32_t seed) {
+        bool used[kTableSize] = {};
+        for (size_t i = 0; i < kModuleCount; i++) {
+            size_t slot = Slot(kBuildInNodeModules[i].nodeModuleName, Length(kBuildInNodeModules[i].nodeModuleName), seed);
+            if (used[slot]) {
+                return false;
+            }
+            used[slot] = true;
+        }
+        return true;
+    }
+
+    /**
+     * 编译期搜索第一个没有冲突的种子
+     */
+    constexpr uint32_t FindSeed() {
+        uint32_t seed = 0;
+        while (!IsPerfect(seed)) {
+            seed++;
+        }
+        return seed;
+    }
+    constexpr uint32_t kSeed = FindSeed();
+
+    struct SlotTable {
+        // 槽位中保存模块的下标，-1 表示空槽位
+        int slots[kTableSize];
+    };
+
+    constexpr SlotTable BuildSlotTable() {
+        SlotTable table{};
+        for (size_t i = 0; i < kTableSize; i++) {
+            table.slots[i] = -1;
+        }
+        for (size_t i = 0; i < kModuleCount; i++) {
+            table.slots[Slot(kBuildInNodeModules[i].nodeModuleName, Length(kBuildInNodeModules[i].nodeModuleName), kSeed)] = static_cast<int>(i);
+        }
+        return table;
+    }
+    constexpr SlotTable kSlotTable = BuildSlotTable();
+
+    // 内建模块名称的最大长度，更长的名称一定不是内建模块
+    const int kMaxNameLength = 64;
+
+    /**
+     * 隔离实例的导出模板缓存，按模块在表中的下标保存
+     */
+    struct BuildInModuleTemplates {
+        v8::Eternal<v8::ObjectTemplate> templates[kModuleCount];
+    };
+}// namespace
+
+const NodeModule *findBuildInNodeModule(const char *name, size_t length) {
+    int index = kSlotTable.slots[Slot(name, length, kSeed)];
+    if (index < 0) {
+        return nullptr;
+    }
+    const NodeModule &nodeModule = kBuildInNodeModules[index];
+    // 完美哈希只保证表中的名称不冲突，还需要比较一次名称
+    if (strncmp(nodeModule.nodeModuleName, name, length) != 0 || nodeModule.nodeModuleName[length] != '\0') {
+        return nullptr;
+    }
+    return &nodeModule;
+}
+
+/**
+ * 懒创建函数的属性第一次被访问时调用，数据中保存着函数的回调
+ * @param property
+ * @param info
+ */
+static void lazyMethodGetter(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value> &info) {
+    v8::Isolate *isolate = info.GetIsolate();
+    auto callback = reinterpret_cast<v8::FunctionCallback>(info.Data().As<v8::External>()->Value());
+    v8::Local<v8::Function> function;
+    if (v8::Function::New(isolate->GetCurrentContext(), callback, v8::Local<v8::Value>(), 0, v8::ConstructorBehavior::kThrow)
+                .ToLocal(&function)) {
+        function->SetName(property.As<v8::String>());
+        info.GetReturnValue().Set(function);
+    }
+}
+
+void setLazyMethod(v8::Isolate *isolate, v8::Local<v8::ObjectTemplate> exports, const char *name, v8::FunctionCallback callback) {
+    exports->SetLazyDataProperty(v8::String::NewFromUtf8(isolate, name, v8::NewStringType::kInternalized).ToLocalChecked(),
+                                 lazyMethodGetter, v8::External::New(isolate, reinterpret_cast<void *>(callback)));
+}
+
+/**
+ * 获取上下文的导出缓存，不存在时创建。
+ * 缓存是保存在上下文嵌入数据中的 js Map，随上下文一起回收，不会因为持有全局句柄让上下文无法释放
+ * @param context
+ * @return
+ */
+static v8::Local<v8::Map> getExportsCache(v8::Local<v8::Context> context) {
+    if (context->GetNumberOfEmbedderDataFields() > ContextEmbedderIndex::kBuildInModuleExports) {
+        v8::Local<v8::Value> cache = context->GetEmbedderData(ContextEmbedderIndex::kBuildInModuleExports);
+        if (cache->IsMap()) {
+            return cache.As<v8::Map>();
+        }
+    }
+    v8::Local<v8::Map> cache = v8::Map::New(context->GetIsolate());
+    ContextEmbedderData::SetValue(context, ContextEmbedderIndex::kBuildInModuleExports, cache);
+    return cache;
+}
+
+/**
+ * 获取上下文的 require 函数，每个上下文只创建一次
+ * @param context
+ * @return
+ */
+static v8::Local<v8::Function> getRequire(v8::Local<v8::Context> context) {
+    if (context->GetNumberOfEmbedderDataFields() > ContextEmbedderIndex::kBuildInModuleRequire) {
+        v8::Local<v8::Value> require = context->GetEmbedderData(ContextEmbedderIndex::kBuildInModuleRequire);
+        if (require->IsFunction()) {
+            return require.As<v8::Function>();
+        }
+    }
+    v8::Local<v8::Function> require = v8::Function::New(context, internalBinding).ToLocalChecked();
+    ContextEmbedderData::SetValue(context, ContextEmbedderIndex::kBuildInModuleRequire, require);
+    return require;
+}
+
+/**
+ * 获取模块的导出模板，每个隔离实例第一次使用时创建，之后在所有上下文中复用
+ * @param isolate
+ * @param nodeModule
+ * @return
+ */
+static v8::Local<v8::ObjectTemplate> getExportsTemplate(v8::Isolate *isolate, const NodeModule *nodeModule) {
+    auto *cache = static_cast<BuildInModuleTemplates *>(isolate->GetData(IsolateDataIndex::kBuildInModuleTemplates));
+    if (cache == nullptr) {
+        cache = new BuildInModuleTemplates();
+        isolate->SetData(IsolateDataIndex::kBuildInModuleTemplates, cache);
+    }
+    v8::Eternal<v8::ObjectTemplate> &exportsTemplate = cache->templates[nodeModule - kBuildInNodeModules];
+    if (exportsTemplate.IsEmpty()) {
+        v8::Local<v8::ObjectTemplate> newTemplate = v8::ObjectTemplate::New(isolate);
+        nodeModule->nodeModuleTemplateFun(isolate, newTemplate);
+        exportsTemplate.Set(isolate, newTemplate);
+    }
+    return exportsTemplate.Get(isolate);
+}
+
+void disposeBuildInModuleTemplates(v8::Isolate *isolate) {
+    // 模板本身是永久句柄，随隔离实例一起释放
+    delete static_cast<BuildInModuleTemplates *>(isolate->GetData(IsolateDataIndex::kBuildInModuleTemplates));
+    isolate->SetData(IsolateDataIndex::kBuildInModuleTemplates, nullptr);
+}
+
+void internalBinding(const v8::FunctionCallbackInfo<v8::Value> &info) {
+    v8::Isolate *isolate = info.GetIsolate();
+    v8::Local<v8::Context> context = isolate->GetCurrentContext();
+    if (info.Length() < 1 || !info[0]->IsString()) {
+        info.GetReturnValue().SetNull();
+        return;
+    }
+    v8::Local<v8::Map> cache = getExportsCache(context);
+    // 如果模块已经加载过。直接从缓存取，不需要转换模块名称
+    v8::Local<v8::Value> cached;
+    if (cache->Get(context, info[0]).ToLocal(&cached) && !cached->IsUndefined()) {
+        info.GetReturnValue().Set(cached);
+        return;
+    }
+    // 模块名称写入栈上的缓冲区，不分配内存
+    v8::Local<v8::String> moduleName = info[0].As<v8::String>();
+    char name[kMaxNameLength];
+    const NodeModule *nodeModule = nullptr;
+    if (moduleName->Utf8Length(isolate) < kMaxNameLength) {
+        int length = moduleName->WriteUtf8(isolate, name, kMaxNameLength, nullptr, v8::String::NO_NULL_TERMINATION);
+        nodeModule = findBuildInNodeModule(name, length);
+    }
+    // 如果没有找到，返回null
+    if (nodeModule == nullptr) {
+        info.GetReturnValue().SetNull();
+        return;
+    }
+    v8::Local<v8::String> exportsKey = v8::String::NewFromUtf8Literal(isolate, "exports");
+    v8::Local<v8::Object> module = v8::Object::New(isolate);
+    // 用导出模板创建 exports，函数在访问时才创建
+    v8::Local<v8::Object> exports;
+    if (!getExportsTemplate(isolate, nodeModule)->NewInstance(context).ToLocal(&exports)) {
+        return;
+    }
+    module->Set(context, exportsKey, exports).Check();
+    // 先缓存初始的导出对象，模块之间循环依赖时返回未完成的导出对象而不是无限递归
+    cache->Set(context, info[0], exports).ToLocalChecked();
+    // 调用注册函数，失败时移除缓存，下一次重新加载
+    v8::TryCatch tryCatch(isolate);
+    nodeModule->nodeModuleRegisterFun(context, module, exports, getRequire(context));
+    if (tryCatch.HasCaught()) {
+        cache->Delete(context, info[0]).Check();
+        tryCatch.ReThrow();
+        return;
+    }
+    // 导出 module对象的exports熟悉值，注册函数可能替换了 module.exports
+    v8::Local<v8::Value> result = module->Get(context, exportsKey).ToLocalChecked();
+    cache->Set(context, info[0], result).ToLocalChecked();
+    info.GetReturnValue().Set(result);
+}
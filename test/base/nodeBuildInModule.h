@@ -0,0 +1,85 @@
+//
+// Created by user on 2026/10/17.
+//
+
+#ifndef V8_LEARN_NODE_BUILD_IN_MODULE_H
+#define V8_LEARN_NODE_BUILD_IN_MODULE_H
+#include "v8.h"
+#include <cstddef>
+
+/**
+ * 内建模块的注册函数
+ */
+using NodeModuleRegisterFun = void (*)(v8::Local<v8::Context> context,
+                                       v8::Local<v8::Object> module,
+                                       v8::Local<v8::Object> exports,
+                                       v8::Local<v8::Function> require);
+
+/**
+ * 描述内建模块导出的函数，在导出模板上设置属性。
+ * 函数通过 setLazyMethod 设置，第一次访问时才创建
+ */
+using NodeModuleTemplateFun = void (*)(v8::Isolate *isolate, v8::Local<v8::ObjectTemplate> exports);
+
+/**
+ * 所有内建模块的列表，与 node 的 NODE_BUILTIN_STANDARD_MODULES 类似。
+ * 新增模块时在这里添加 V(name)，并实现导出模板函数 name##BuildInModuleTemplate 和注册函数 name##BuildInModule。
+ * 绑定时先用导出模板创建 exports 对象，再调用注册函数设置依赖其他模块或者上下文的属性。
+ * 模块描述在编译期生成常量表，运行时不需要注册，也不需要清空。
+ */
+#define BUILD_IN_MODULE_LIST(V) \
+    V(foo)                      \
+    V(bar)
+
+#define V(name)                                                                             \
+    void name##BuildInModuleTemplate(v8::Isolate *isolate, v8::Local<v8::ObjectTemplate> exports); \
+    void name##BuildInModule(v8::Local<v8::Context> context,                                \
+                             v8::Local<v8::Object> module,                                  \
+                             v8::Local<v8::Object> exports,                                 \
+                             v8::Local<v8::Function> require);
+BUILD_IN_MODULE_LIST(V)
+#undef V
+
+/**
+ * 模块描述
+ */
+struct NodeModule {
+    // 模块名称
+    const char *nodeModuleName;
+    // 模块注册函数
+    NodeModuleRegisterFun nodeModuleRegisterFun;
+    // 导出模板函数
+    NodeModuleTemplateFun nodeModuleTemplateFun;
+};
+
+/**
+ * 在导出模板上设置函数属性，函数在第一次访问属性时才创建，之后替换为普通的数据属性
+ * @param isolate
+ * @param exports
+ * @param name
+ * @param callback
+ */
+void setLazyMethod(v8::Isolate *isolate, v8::Local<v8::ObjectTemplate> exports, const char *name, v8::FunctionCallback callback);
+
+/**
+ * 根据名称查找内建模块，使用编译期生成的完美哈希表，找不到时返回 nullptr
+ * @param name
+ * @param length
+ * @return
+ */
+const NodeModule *findBuildInNodeModule(const char *name, size_t length);
+
+/**
+ * 获取内建模块的函数，即 process.binding。
+ * 导出模板每个隔离实例只创建一次，每个上下文第一次获取模块时执行注册函数，导出对象缓存在上下文中，之后直接返回缓存
+ * @param info
+ */
+void internalBinding(const v8::FunctionCallbackInfo<v8::Value> &info);
+
+/**
+ * 释放隔离实例上缓存的导出模板，在 Isolate::Dispose 之前调用，没有使用过内建模块时什么也不做
+ * @param isolate
+ */
+void disposeBuildInModuleTemplates(v8::Isolate *isolate);
+
+#endif//V8_LEARN_NODE_BUILD_IN_MODULE_H
@@ -0,0 +1,156 @@
+//
+// Created by user on 2026/10/17.
+//
+
+#include "numaPageAllocator.h"
+
+#if defined(LINUX)
+#include <linux/mempolicy.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    // 当前线程保留的内存绑定的节点
+    thread_local int t_node = -1;
+    // mbind 的节点掩码支持的节点数量
+    const int kMaxNodeCount = 1024;
+
+#if defined(LINUX)
+    int ToProtection(v8::PageAllocator::Permission permissions) {
+        switch (permissions) {
+            case v8::PageAllocator::kRead:
+                return PROT_READ;
+            case v8::PageAllocator::kReadWrite:
+                return PROT_READ | PROT_WRITE;
+            case v8::PageAllocator::kReadWriteExecute:
+                return PROT_READ | PROT_WRITE | PROT_EXEC;
+            case v8::PageAllocator::kReadExecute:
+                return PROT_READ | PROT_EXEC;
+            default:
+                return PROT_NONE;
+        }
+    }
+#endif
+}// namespace
+
+NumaPageAllocator::NumaPageAllocator(bool strict)
+#if defined(LINUX)
+    : _strict(strict), _page_size(static_cast<size_t>(sysconf(_SC_PAGESIZE))), _random(std::random_device()()) {
+#else
+    : _strict(strict), _page_size(4096), _random(std::random_device()()) {
+#endif
+}
+
+void NumaPageAllocator::SetThreadNode(int node) {
+    t_node = node;
+}
+
+int NumaPageAllocator::GetThreadNode() {
+    return t_node;
+}
+
+void NumaPageAllocator::SetRandomMmapSeed(int64_t seed) {
+    if (seed == 0) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(_random_mutex);
+    _random.seed(static_cast<uint64_t>(seed));
+}
+
+void *NumaPageAllocator::GetRandomMmapAddr() {
+    uint64_t address;
+    {
+        std::lock_guard<std::mutex> lock(_random_mutex);
+        address = _random();
+    }
+    // 与 v8 自带的分配器相同，x64 下用户态地址空间只取低 46 位，并按页对齐
+    address &= uint64_t{0x3FFFFFFFF000};
+    return reinterpret_cast<void *>(static_cast<uintptr_t>(address));
+}
+
+void *NumaPageAllocator::AllocatePages(void *address, size_t length, size_t alignment, Permission permissions) {
+#if defined(LINUX)
+    if (alignment < _page_size) {
+        alignment = _page_size;
+    }
+    // 多保留一段再裁掉两头，保证起始地址对齐
+    size_t request = length + alignment - _page_size;
+    void *result = mmap(address, request, ToProtection(permissions), MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (result == MAP_FAILED) {
+        return nullptr;
+    }
+    uintptr_t base = reinterpret_cast<uintptr_t>(result);
+    uintptr_t aligned = (base + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+    if (aligned != base) {
+        munmap(result, aligned - base);
+    }
+    size_t suffix = base + request - (aligned + length);
+    if (suffix != 0) {
+        munmap(reinterpret_cast<void *>(aligned + length), suffix);
+    }
+    if (t_node >= 0) {
+        bind(reinterpret_cast<void *>(aligned), length, t_node);
+    }
+    return reinterpret_cast<void *>(aligned);
+#else
+    return nullptr;
+#endif
+}
+
+bool NumaPageAllocator::FreePages(void *address, size_t length) {
+#if defined(LINUX)
+    return munmap(address, length) == 0;
+#else
+    return false;
+#endif
+}
+
+bool NumaPageAllocator::ReleasePages(void *address, size_t length, size_t new_length) {
+#if defined(LINUX)
+    return munmap(static_cast<uint8_t *>(address) + new_length, length - new_length) == 0;
+#else
+    return false;
+#endif
+}
+
+bool NumaPageAllocator::SetPermissions(void *address, size_t length, Permission permissions) {
+#if defined(LINUX)
+    if (mprotect(address, length, ToProtection(permissions)) != 0) {
+        return false;
+    }
+    // 不可访问的页立即归还给系统，再次提交时重新按绑定的节点分配
+    if (permissions == kNoAccess || permissions == kNoAccessWillJitLater) {
+        madvise(address, length, MADV_DONTNEED);
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool NumaPageAllocator::DiscardSystemPages(void *address, size_t size) {
+#if defined(LINUX)
+    return madvise(address, size, MADV_DONTNEED) == 0;
+#else
+    return true;
+#endif
+}
+
+void NumaPageAllocator::bind(void *address, size_t length, int node) {
+#if defined(LINUX)
+    if (node < kMaxNodeCount) {
+        const size_t bitsPerLong = sizeof(unsigned long) * 8;
+        unsigned long mask[kMaxNodeCount / (sizeof(unsigned long) * 8)] = {};
+        mask[node / bitsPerLong] = 1UL << (node % bitsPerLong);
+        // 内核只读取 maxnode - 1 位
+        long result = syscall(SYS_mbind, address, length, _strict ? MPOL_BIND : MPOL_PREFERRED, mask, kMaxNodeCount + 1, 0);
+        if (result == 0) {
+            _bound_bytes += length;
+            return;
+        }
+    }
+#endif
+    _bind_failure_count++;
+}
@@ -0,0 +1,66 @@
+//
+// Created by user on 2026/10/17.
+//
+
+#ifndef V8_LEARN_NUMA_PAGE_ALLOCATOR_H
+#define V8_LEARN_NUMA_PAGE_ALLOCATOR_H
+#include "v8-platform.h"
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <random>
+
+/**
+ * 把页绑定到 NUMA 节点的页分配器，由 EmbedderPlatform::GetPageAllocator 返回给 v8。
+ * 每次保留地址空间时，用 mbind 把这段内存绑定到当前线程设置的节点（SetThreadNode），之后提交的页都从该节点分配。
+ * 开启指针压缩时隔离实例在创建时一次性保留整个堆的地址空间，所以在哪个节点的线程上创建隔离实例，
+ * 它的堆就落在哪个节点上，之后由哪个线程访问都不会改变。
+ * 线程没有设置节点时不绑定，由内核按首次访问的线程分配。只在 linux 下实现，其他平台上 EmbedderPlatform 不使用它。
+ */
+class NumaPageAllocator : public v8::PageAllocator {
+public:
+    /**
+     * @param strict 为 true 时使用 MPOL_BIND，节点内存不足时分配失败；否则使用 MPOL_PREFERRED，内存不足时退回其他节点
+     */
+    explicit NumaPageAllocator(bool strict = false);
+
+    /**
+     * 设置当前线程之后保留的内存绑定的节点
+     * @param node 为 -1 时不绑定
+     */
+    static void SetThreadNode(int node);
+    static int GetThreadNode();
+
+    size_t AllocatePageSize() override { return _page_size; }
+    size_t CommitPageSize() override { return _page_size; }
+    void SetRandomMmapSeed(int64_t seed) override;
+    void *GetRandomMmapAddr() override;
+    void *AllocatePages(void *address, size_t length, size_t alignment, Permission permissions) override;
+    bool FreePages(void *address, size_t length) override;
+    bool ReleasePages(void *address, size_t length, size_t new_length) override;
+    bool SetPermissions(void *address, size_t length, Permission permissions) override;
+    bool DiscardSystemPages(void *address, size_t size) override;
+
+    /**
+     * 绑定到节点的内存总量（保留的地址空间，不是实际提交的页）
+     * @return
+     */
+    uint64_t getBoundBytes() const { return _bound_bytes.load(); }
+    /**
+     * mbind 失败的次数，节点不存在或者内核不支持 NUMA 时失败，失败的内存按默认策略分配
+     * @return
+     */
+    uint64_t getBindFailureCount() const { return _bind_failure_count.load(); }
+
+private:
+    void bind(void *address, size_t length, int node);
+
+    const bool _strict;
+    const size_t _page_size;
+    std::mutex _random_mutex;
+    std::mt19937_64 _random;
+    std::atomic<uint64_t> _bound_bytes{0};
+    std::atomic<uint64_t> _bind_failure_count{0};
+};
+
+#endif//V8_LEARN_NUMA_PAGE_ALLOCATOR_H
@@ -0,0 +1,89 @@
+//
+// Created by user on 2026/10/17.
+//
+
+#include "scriptStreamer.h"
+#include "sourceFile.h"
+#include <cstring>
+
+FileSourceStream::FileSourceStream(FILE *file) : _file(file) {}
+
+FileSourceStream::~FileSourceStream() {
+    fclose(_file);
+}
+
+size_t FileSourceStream::GetMoreData(const uint8_t **src) {
+    auto *data = new uint8_t[kChunkSize];
+    size_t size = fread(data, 1, kChunkSize, _file);
+    // 跳过 UTF-8 BOM，与 SourceFile::Load 得到的完整源码保持一致
+    if (_first && size >= 3 && memcmp(data, "\xEF\xBB\xBF", 3) == 0) {
+        memmove(data, data + 3, size - 3);
+        size -= 3;
+    }
+    _first = false;
+    if (size == 0) {
+        delete[] data;
+        return 0;
+    }
+    _chunk_count++;
+    // 缓冲区由 v8 释放
+    *src = data;
+    return size;
+}
+
+ScriptStreamer::ScriptStreamer(v8::Isolate *isolate, std::string path, ThreadPool *threadPool)
+    : _isolate(isolate), _path(std::move(path)) {
+    FILE *file = fopen(_path.c_str(), "rb");
+    if (file == nullptr) {
+        return;
+    }
+    auto stream = std::make_unique<FileSourceStream>(file);
+    _stream = stream.get();
+    _source = std::make_unique<v8::ScriptCompiler::StreamedSource>(std::move(stream), v8::ScriptCompiler::StreamedSource::UTF8);
+    _task.reset(v8::ScriptCompiler::StartStreaming(isolate, _source.get()));
+    _done = false;
+    if (threadPool == nullptr) {
+        threadPool = ThreadPool::GetDefault();
+    }
+    threadPool->submit([this]() -> void {
+        _task->Run();
+        std::lock_guard<std::mutex> lock(_mutex);
+        _done = true;
+        _condition.notify_all();
+    });
+}
+
+ScriptStreamer::~ScriptStreamer() {
+    wait();
+}
+
+void ScriptStreamer::wait() {
+    std::unique_lock<std::mutex> lock(_mutex);
+    _condition.wait(lock, [this]() -> bool { return _done; });
+}
+
+v8::MaybeLocal<v8::Script> ScriptStreamer::finish(v8::Local<v8::Context> context) {
+    v8::EscapableHandleScope handleScope(_isolate);
+    if (_source == nullptr) {
+        std::string message = "Cannot open file '" + _path + "'";
+        _isolate->ThrowException(v8::Exception::Error(v8::String::NewFromUtf8(_isolate, message.c_str()).ToLocalChecked()));
+        return v8::MaybeLocal<v8::Script>();
+    }
+    // 完整源码用于 Function.prototype.toString 和调试，映射为外部字符串，不需要复制
+    v8::Local<v8::String> fullSource;
+    if (!SourceFile::Load(_isolate, _path).ToLocal(&fullSource)) {
+        return v8::MaybeLocal<v8::Script>();
+    }
+    wait();
+    v8::ScriptOrigin origin(_isolate, v8::String::NewFromUtf8(_isolate, _path.c_str()).ToLocalChecked());
+    v8::Local<v8::Script> script;
+    if (!v8::ScriptCompiler::Compile(context, _source.get(), fullSource, origin).ToLocal(&script)) {
+        return v8::MaybeLocal<v8::Script>();
+    }
+    return handleScope.Escape(script);
+}
+
+v8::MaybeLocal<v8::Script> ScriptStreamer::Compile(v8::Local<v8::Context> context, const std::string &path) {
+    ScriptStreamer streamer(context->GetIsolate(), path);
+    return streamer.finish(context);
+}
@@ -0,0 +1,89 @@
+//
+// Created by user on 2026/10/17.
+//
+
+#ifndef V8_LEARN_SCRIPT_STREAMER_H
+#define V8_LEARN_SCRIPT_STREAMER_H
+#include "threadPool.h"
+#include "v8.h"
+#include <condition_variable>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+
+/**
+ * 按块读取文件的源码流。
+ * v8 在执行解析的后台线程上调用 GetMoreData，允许阻塞，所以直接在这里读取下一块，不再另外创建读取线程；
+ * 顺序读取时操作系统的预读已经让读取和解析重叠。
+ */
+class FileSourceStream : public v8::ScriptCompiler::ExternalSourceStream {
+public:
+    static const size_t kChunkSize = 64 * 1024;
+
+    /**
+     * @param file 已经打开的文件，由源码流关闭
+     */
+    explicit FileSourceStream(FILE *file);
+    ~FileSourceStream() override;
+    size_t GetMoreData(const uint8_t **src) override;
+
+    size_t getChunkCount() const { return _chunk_count; }
+
+private:
+    FILE *_file;
+    bool _first = true;
+    size_t _chunk_count = 0;
+};
+
+/**
+ * 流式编译脚本文件。
+ * 构造时开始在线程池中边读边解析，隔离实例所在的线程可以继续做其他事情，
+ * 最后调用 finish 完成编译，只有这一步在隔离实例所在的线程上执行。
+ */
+class ScriptStreamer {
+public:
+    /**
+     * @param isolate
+     * @param path
+     * @param threadPool 为空时使用默认线程池
+     */
+    ScriptStreamer(v8::Isolate *isolate, std::string path, ThreadPool *threadPool = nullptr);
+    /**
+     * 等待后台任务结束
+     */
+    ~ScriptStreamer();
+    ScriptStreamer(const ScriptStreamer &) = delete;
+    ScriptStreamer &operator=(const ScriptStreamer &) = delete;
+
+    /**
+     * 等待后台解析结束并完成编译，文件不存在或者有语法错误时返回空并抛出异常
+     * @param context
+     * @return
+     */
+    v8::MaybeLocal<v8::Script> finish(v8::Local<v8::Context> context);
+    /**
+     * 流式编译文件
+     * @param context
+     * @param path
+     * @return
+     */
+    static v8::MaybeLocal<v8::Script> Compile(v8::Local<v8::Context> context, const std::string &path);
+
+    size_t getChunkCount() const { return _stream == nullptr ? 0 : _stream->getChunkCount(); }
+
+private:
+    void wait();
+
+    v8::Isolate *_isolate;
+    std::string _path;
+    // 由 _source 拥有
+    FileSourceStream *_stream = nullptr;
+    std::unique_ptr<v8::ScriptCompiler::StreamedSource> _source;
+    std::unique_ptr<v8::ScriptCompiler::ScriptStreamingTask> _task;
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    bool _done = true;
+};
+
+#endif//V8_LEARN_SCRIPT_STREAMER_H
@@ -0,0 +1,86 @@
+//
+// Created by user on 2026/10/17.
+//
+
+#include "snapshot.h"
+#include "builtins.h"
+#include <fstream>
+#include <iterator>
+
+const char *const Snapshot::kFileName = "v8_learn_snapshot.bin";
+const size_t Snapshot::kBuiltinContextIndex = 0;
+std::string Snapshot::_blob;
+v8::StartupData Snapshot::_startup_data = {nullptr, 0};
+
+v8::StartupData Snapshot::Create() {
+    v8::SnapshotCreator snapshotCreator(Builtins::GetExternalReferences());
+    v8::Isolate *isolate = snapshotCreator.GetIsolate();
+    size_t index;
+    {
+        v8::HandleScope handleScope(isolate);
+        // 默认上下文保持干净，v8::Context::New 创建的上下文和原来一样
+        snapshotCreator.SetDefaultContext(v8::Context::New(isolate));
+        v8::Local<v8::Context> context = v8::Context::New(isolate, nullptr, Builtins::NewGlobalTemplate(isolate));
+        {
+            v8::Context::Scope context_scope(context);
+            Builtins::Install(context);
+        }
+        index = snapshotCreator.AddContext(context);
+    }
+    // 每条路径都要生成快照，没有生成快照的 SnapshotCreator 析构时会触发 v8 的检查
+    v8::StartupData startupData = snapshotCreator.CreateBlob(v8::SnapshotCreator::FunctionCodeHandling::kClear);
+    if (index != kBuiltinContextIndex) {
+        delete[] startupData.data;
+        return {nullptr, 0};
+    }
+    return startupData;
+}
+
+bool Snapshot::WriteFile(const std::string &path, const v8::StartupData &startupData) {
+    std::ofstream out(path.c_str(), std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        return false;
+    }
+    out.write(startupData.data, startupData.raw_size);
+    return out.good();
+}
+
+bool Snapshot::Load(const std::string &path) {
+    std::ifstream in(path.c_str(), std::ios::binary);
+    if (!in.is_open()) {
+        return false;
+    }
+    std::string blob((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    v8::StartupData startupData = {blob.data(), static_cast<int>(blob.size())};
+    // 快照必须由同一个 v8 版本生成
+    if (blob.empty() || !startupData.IsValid()) {
+        return false;
+    }
+    _blob = std::move(blob);
+    _startup_data = {_blob.data(), static_cast<int>(_blob.size())};
+    return true;
+}
+
+v8::StartupData *Snapshot::GetStartupData() {
+    return _startup_data.data == nullptr ? nullptr : &_startup_data;
+}
+
+void Snapshot::InitCreateParams(v8::Isolate::CreateParams &create_params) {
+    if (GetStartupData() == nullptr) {
+        return;
+    }
+    create_params.snapshot_blob = &_startup_data;
+    create_params.external_references = Builtins::GetExternalReferences();
+}
+
+v8::Local<v8::Context> Snapshot::NewBuiltinContext(v8::Isolate *isolate) {
+    v8::EscapableHandleScope handleScope(isolate);
+    v8::Local<v8::Context> context;
+    // 隔离实例不是从自定义快照启动时，快照中没有该上下文
+    if (!v8::Context::FromSnapshot(isolate, kBuiltinContextIndex).ToLocal(&context)) {
+        context = v8::Context::New(isolate, nullptr, Builtins::NewGlobalTemplate(isolate));
+        v8::Context::Scope context_scope(context);
+        Builtins::Install(context);
+    }
+    return handleScope.Escape(context);
+}
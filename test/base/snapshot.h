@@ -0,0 +1,62 @@
+//
+// Created by user on 2026/10/17.
+//
+
+#ifndef V8_LEARN_SNAPSHOT_H
+#define V8_LEARN_SNAPSHOT_H
+#include "v8.h"
+#include <string>
+
+/**
+ * 自定义启动快照。
+ * 快照由构建步骤 v8_learn_mksnapshot 生成，除了默认上下文外，还包含一个预置了内建对象的上下文，
+ * 从快照反序列化上下文不再需要在运行时逐个创建这些对象。
+ */
+class Snapshot {
+public:
+    // 快照文件名称，和可执行文件在同一个目录
+    static const char *const kFileName;
+    // 预置内建对象的上下文在快照中的索引
+    static const size_t kBuiltinContextIndex;
+
+    /**
+     * 使用 SnapshotCreator 创建快照，调用方负责 delete[] 返回的 data
+     * @return
+     */
+    static v8::StartupData Create();
+    /**
+     * 把快照写入文件
+     * @param path
+     * @param startupData
+     * @return
+     */
+    static bool WriteFile(const std::string &path, const v8::StartupData &startupData);
+    /**
+     * 加载快照文件，之后通过 InitCreateParams 创建的隔离实例都从该快照启动
+     * @param path
+     * @return 文件不存在或者快照和当前 v8 版本不匹配时返回 false
+     */
+    static bool Load(const std::string &path);
+    /**
+     * 获取已加载的快照，没有加载时返回 nullptr
+     * @return
+     */
+    static v8::StartupData *GetStartupData();
+    /**
+     * 设置隔离实例的快照和外部引用
+     * @param create_params
+     */
+    static void InitCreateParams(v8::Isolate::CreateParams &create_params);
+    /**
+     * 创建预置了内建对象的上下文。隔离实例从快照启动时直接反序列化，否则在运行时安装。
+     * @param isolate
+     * @return
+     */
+    static v8::Local<v8::Context> NewBuiltinContext(v8::Isolate *isolate);
+
+private:
+    static std::string _blob;
+    static v8::StartupData _startup_data;
+};
+
+#endif//V8_LEARN_SNAPSHOT_H
@@ -0,0 +1,228 @@
+//
+// Created by user on 2026/10/17.
+//
+
+#include "sourceFile.h"
+#include <cstring>
+#include <vector>
+
+#if defined(LINUX)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+const size_t SourceFile::kExternalThreshold = 4096;
+
+namespace {
+    /**
+     * 直接引用映射内存的单字节外部字符串
+     */
+    class MappedOneByteResource : public v8::String::ExternalOneByteStringResource {
+    public:
+        MappedOneByteResource(std::unique_ptr<MappedFile> file, size_t offset) : _file(std::move(file)), _offset(offset) {}
+        const char *data() const override { return _file->data() + _offset; }
+        size_t length() const override { return _file->size() - _offset; }
+
+    private:
+        std::unique_ptr<MappedFile> _file;
+        size_t _offset;
+    };
+
+    /**
+     * UTF-8 解码后的双字节外部字符串
+     */
+    class TwoByteResource : public v8::String::ExternalStringResource {
+    public:
+        explicit TwoByteResource(std::vector<uint16_t> data) : _data(std::move(data)) {}
+        const uint16_t *data() const override { return _data.data(); }
+        size_t length() const override { return _data.size(); }
+
+    private:
+        std::vector<uint16_t> _data;
+    };
+}// namespace
+
+std::unique_ptr<MappedFile> MappedFile::Open(const std::string &path) {
+    std::unique_ptr<MappedFile> file(new MappedFile());
+#if defined(LINUX)
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return nullptr;
+    }
+    struct stat st {};
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+        close(fd);
+        return nullptr;
+    }
+    file->_size = static_cast<size_t>(st.st_size);
+    // 空文件不能映射
+    if (file->_size > 0) {
+        void *address = mmap(nullptr, file->_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (address == MAP_FAILED) {
+            close(fd);
+            return nullptr;
+        }
+        // 源码总是从头到尾顺序扫描
+        madvise(address, file->_size, MADV_SEQUENTIAL);
+        file->_data = static_cast<const char *>(address);
+    }
+    // 映射建立后文件描述符就不再需要了
+    close(fd);
+#elif defined(WIN)
+    file->_file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file->_file == INVALID_HANDLE_VALUE) {
+        return nullptr;
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file->_file, &size)) {
+        return nullptr;
+    }
+    file->_size = static_cast<size_t>(size.QuadPart);
+    if (file->_size > 0) {
+        file->_mapping = CreateFileMappingA(file->_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (file->_mapping == nullptr) {
+            return nullptr;
+        }
+        file->_data = static_cast<const char *>(MapViewOfFile(file->_mapping, FILE_MAP_READ, 0, 0, 0));
+        if (file->_data == nullptr) {
+            return nullptr;
+        }
+    }
+#else
+    return nullptr;
+#endif
+    return file;
+}
+
+MappedFile::~MappedFile() {
+#if defined(LINUX)
+    if (_data != nullptr) {
+        munmap(const_cast<char *>(_data), _size);
+    }
+#elif defined(WIN)
+    if (_data != nullptr) {
+        UnmapViewOfFile(_data);
+    }
+    if (_mapping != nullptr) {
+        CloseHandle(_mapping);
+    }
+    if (_file != INVALID_HANDLE_VALUE) {
+        CloseHandle(_file);
+    }
+#endif
+}
+
+v8::MaybeLocal<v8::String> SourceFile::Load(v8::Isolate *isolate, const std::string &path) {
+    std::unique_ptr<MappedFile> file = MappedFile::Open(path);
+    if (file == nullptr) {
+        return v8::MaybeLocal<v8::String>();
+    }
+    return NewString(isolate, std::move(file));
+}
+
+v8::MaybeLocal<v8::String> SourceFile::NewString(v8::Isolate *isolate, std::unique_ptr<MappedFile> file) {
+    const char *data = file->data();
+    size_t length = file->size();
+    // 跳过 UTF-8 的 BOM
+    size_t offset = 0;
+    if (length >= 3 && memcmp(data, "\xEF\xBB\xBF", 3) == 0) {
+        offset = 3;
+    }
+    if (length - offset < kExternalThreshold) {
+        return v8::String::NewFromUtf8(isolate, data + offset, v8::NewStringType::kNormal, static_cast<int>(length - offset));
+    }
+    v8::Local<v8::String> result;
+    if (IsAscii(data + offset, length - offset)) {
+        // ASCII 同时也是合法的 Latin-1，映射的内存可以直接作为单字节字符串
+        auto *resource = new MappedOneByteResource(std::move(file), offset);
+        if (!v8::String::NewExternalOneByte(isolate, resource).ToLocal(&result)) {
+            delete resource;
+            return v8::MaybeLocal<v8::String>();
+        }
+        return result;
+    }
+    std::vector<uint16_t> utf16;
+    if (!DecodeUtf8(reinterpret_cast<const uint8_t *>(data + offset), length - offset, &utf16)) {
+        // 非法的 UTF-8 交给 v8 处理，非法字符会被替换成 U+FFFD
+        return v8::String::NewFromUtf8(isolate, data + offset, v8::NewStringType::kNormal, static_cast<int>(length - offset));
+    }
+    auto *resource = new TwoByteResource(std::move(utf16));
+    if (!v8::String::NewExternalTwoByte(isolate, resource).ToLocal(&result)) {
+        delete resource;
+        return v8::MaybeLocal<v8::String>();
+    }
+    return result;
+}
+
+bool SourceFile::IsAscii(const char *data, size_t length) {
+    size_t i = 0;
+    // 每次检查 8 个字节的最高位
+    for (; i + sizeof(uint64_t) <= length; i += sizeof(uint64_t)) {
+        uint64_t word;
+        memcpy(&word, data + i, sizeof(word));
+        if (word & 0x8080808080808080ULL) {
+            return false;
+        }
+    }
+    for (; i < length; i++) {
+        if (static_cast<unsigned char>(data[i]) & 0x80) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool SourceFile::DecodeUtf8(const uint8_t *data, size_t length, std::vector<uint16_t> *out) {
+    out->reserve(length);
+    size_t i = 0;
+    while (i < length) {
+        uint32_t code = data[i];
+        if (code < 0x80) {
+            out->push_back(static_cast<uint16_t>(code));
+            i++;
+            continue;
+        }
+        size_t extra;
+        uint32_t min;
+        if ((code & 0xE0) == 0xC0) {
+            extra = 1;
+            code &= 0x1F;
+            min = 0x80;
+        } else if ((code & 0xF0) == 0xE0) {
+            extra = 2;
+            code &= 0x0F;
+            min = 0x800;
+        } else if ((code & 0xF8) == 0xF0) {
+            extra = 3;
+            code &= 0x07;
+            min = 0x10000;
+        } else {
+            return false;
+        }
+        if (length - i <= extra) {
+            return false;
+        }
+        for (size_t k = 1; k <= extra; k++) {
+            uint8_t byte = data[i + k];
+            if ((byte & 0xC0) != 0x80) {
+                return false;
+            }
+            code = (code << 6) | (byte & 0x3F);
+        }
+        // 过长编码、超出范围以及代理区的码点都是非法的
+        if (code < min || code > 0x10FFFF || (code >= 0xD800 && code <= 0xDFFF)) {
+            return false;
+        }
+        if (code >= 0x10000) {
+            code -= 0x10000;
+            out->push_back(static_cast<uint16_t>(0xD800 + (code >> 10)));
+            out->push_back(static_cast<uint16_t>(0xDC00 + (code & 0x3FF)));
+        } else {
+            out->push_back(static_cast<uint16_t>(code));
+        }
+        i += extra + 1;
+    }
+    return true;
+}
@@ -0,0 +1,84 @@
+//
+// Created by user on 2026/10/17.
+//
+
+#ifndef V8_LEARN_SOURCE_FILE_H
+#define V8_LEARN_SOURCE_FILE_H
+#include "v8.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+#if defined(WIN)
+#include <windows.h>
+#endif
+
+/**
+ * 只读内存映射的文件
+ */
+class MappedFile {
+public:
+    /**
+     * 映射整个文件，打开失败返回 nullptr
+     * @param path
+     * @return
+     */
+    static std::unique_ptr<MappedFile> Open(const std::string &path);
+    ~MappedFile();
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    const char *data() const { return _data; }
+    size_t size() const { return _size; }
+
+private:
+    MappedFile() = default;
+    const char *_data = nullptr;
+    size_t _size = 0;
+#if defined(WIN)
+    HANDLE _file = INVALID_HANDLE_VALUE;
+    HANDLE _mapping = nullptr;
+#endif
+};
+
+/**
+ * 源码文件加载。
+ * 纯 ASCII 文件直接把映射的内存作为外部字符串交给 v8，不会复制到 c++ 堆和 v8 堆上；
+ * 含有多字节字符的 UTF-8 文件解码成外部双字节字符串。
+ */
+class SourceFile {
+public:
+    // 小于该大小的文件直接复制到 v8 堆上，映射的开销比复制更大
+    static const size_t kExternalThreshold;
+    /**
+     * 加载源码文件
+     * @param isolate
+     * @param path
+     * @return 文件不存在时返回空
+     */
+    static v8::MaybeLocal<v8::String> Load(v8::Isolate *isolate, const std::string &path);
+    /**
+     * 把内存中的源码创建为 v8 字符串，规则和 Load 一致，file 的所有权转移给 v8
+     * @param isolate
+     * @param file
+     * @return
+     */
+    static v8::MaybeLocal<v8::String> NewString(v8::Isolate *isolate, std::unique_ptr<MappedFile> file);
+    /**
+     * 是否全部是 ASCII 字符
+     * @param data
+     * @param length
+     * @return
+     */
+    static bool IsAscii(const char *data, size_t length);
+    /**
+     * 把 UTF-8 解码成 UTF-16，遇到非法编码返回 false
+     * @param data
+     * @param length
+     * @param out
+     * @return
+     */
+    static bool DecodeUtf8(const uint8_t *data, size_t length, std::vector<uint16_t> *out);
+};
+
+#endif//V8_LEARN_SOURCE_FILE_H
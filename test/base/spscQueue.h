@@ -0,0 +1,106 @@
+//
+// Created by user on 2026/10/17.
+//
+
+#ifndef V8_LEARN_SPSC_QUEUE_H
+#define V8_LEARN_SPSC_QUEUE_H
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+/**
+ * 有界的单生产者单消费者无锁队列。
+ * 环形缓冲区的容量向上取整为 2 的幂，下标只增不减，取模只需要按位与。
+ * 生产者只写 _tail，消费者只写 _head，两个下标放在不同的缓存行上，避免伪共享；
+ * 各自缓存对方下标的旧值，只有看起来满或者空时才重新读取对方的下标。
+ * push 只能在一个线程上调用，pop 只能在另一个线程上调用。
+ */
+template<typename T>
+class SpscQueue {
+public:
+    /**
+     * @param capacity 最少能容纳的元素数量
+     */
+    explicit SpscQueue(size_t capacity) {
+        size_t size = 2;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        _mask = size - 1;
+        _slots.reset(new T[size]);
+    }
+    SpscQueue(const SpscQueue &) = delete;
+    SpscQueue &operator=(const SpscQueue &) = delete;
+
+    /**
+     * 入队，只能在生产者线程上调用
+     * @param value 成功时被移走，队列满时不变
+     * @return 队列满时返回 false
+     */
+    bool push(T &value) {
+        size_t tail = _tail.load(std::memory_order_relaxed);
+        if (tail - _cached_head > _mask) {
+            _cached_head = _head.load(std::memory_order_acquire);
+            if (tail - _cached_head > _mask) {
+                return false;
+            }
+        }
+        _slots[tail & _mask] = std::move(value);
+        _tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+    /**
+     * 判断队列是否已满，只能在生产者线程上调用。返回 false 时紧接着的 push 一定成功
+     * @return
+     */
+    bool full() {
+        size_t tail = _tail.load(std::memory_order_relaxed);
+        if (tail - _cached_head > _mask) {
+            _cached_head = _head.load(std::memory_order_acquire);
+        }
+        return tail - _cached_head > _mask;
+    }
+    /**
+     * 出队，只能在消费者线程上调用
+     * @param value
+     * @return 队列空时返回 false
+     */
+    bool pop(T &value) {
+        size_t head = _head.load(std::memory_order_relaxed);
+        if (head == _cached_tail) {
+            _cached_tail = _tail.load(std::memory_order_acquire);
+            if (head == _cached_tail) {
+                return false;
+            }
+        }
+        value = std::move(_slots[head & _mask]);
+        // 释放槽位中剩余的资源，不等到槽位被覆盖
+        _slots[head & _mask] = T();
+        _head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+    /**
+     * 近似的元素数量，可以在任意线程上调用
+     * @return
+     */
+    size_t size() const {
+        size_t head = _head.load(std::memory_order_acquire);
+        return _tail.load(std::memory_order_acquire) - head;
+    }
+    size_t capacity() const { return _mask + 1; }
+
+private:
+    static const size_t kCacheLineSize = 64;
+
+    std::unique_ptr<T[]> _slots;
+    size_t _mask;
+    // 消费者独占的缓存行：消费者写入的 _head 和消费者缓存的 _tail
+    alignas(kCacheLineSize) std::atomic<size_t> _head{0};
+    size_t _cached_tail = 0;
+    // 生产者独占的缓存行：生产者写入的 _tail 和生产者缓存的 _head
+    alignas(kCacheLineSize) std::atomic<size_t> _tail{0};
+    size_t _cached_head = 0;
+};
+
+#endif//V8_LEARN_SPSC_QUEUE_H
@@ -0,0 +1,81 @@
+//
+// Created by user on 2026/10/17.
+//
+
+#include "streamedModule.h"
+#include "sourceFile.h"
+#include <cstring>
+
+/**
+ * 在工作线程上读取源码，一次交给 v8
+ */
+class StreamedModule::SourceStream : public v8::ScriptCompiler::ExternalSourceStream {
+public:
+    SourceStream(StreamedModule *module, const SourceReader *reader) : _module(module), _reader(reader) {}
+    size_t GetMoreData(const uint8_t **src) override {
+        if (_done) {
+            return 0;
+        }
+        _done = true;
+        if (!(*_reader)(_module->_path, _module->_source)) {
+            _module->_found = false;
+            return 0;
+        }
+        // 返回的缓冲区由 v8 释放
+        auto *buffer = new uint8_t[_module->_source.size()];
+        memcpy(buffer, _module->_source.data(), _module->_source.size());
+        *src = buffer;
+        return _module->_source.size();
+    }
+
+private:
+    StreamedModule *_module;
+    const SourceReader *_reader;
+    bool _done = false;
+};
+
+StreamedModule::SourceReader StreamedModule::DefaultReader() {
+    return [](const std::string &path, std::string &source) -> bool {
+        std::unique_ptr<MappedFile> file = MappedFile::Open(path);
+        if (file == nullptr) {
+            return false;
+        }
+        source.assign(file->data(), file->size());
+        return true;
+    };
+}
+
+StreamedModule::StreamedModule(v8::Isolate *isolate, std::string path, const SourceReader *reader) : _path(std::move(path)) {
+    _streamed_source = std::make_unique<v8::ScriptCompiler::StreamedSource>(
+            std::make_unique<SourceStream>(this, reader), v8::ScriptCompiler::StreamedSource::UTF8);
+    // 必须在隔离实例所在的线程上开始，返回的任务可以在任意线程上执行
+    _task.reset(v8::ScriptCompiler::StartStreaming(isolate, _streamed_source.get(), v8::ScriptType::kModule));
+}
+
+StreamedModule::~StreamedModule() = default;
+
+void StreamedModule::run() {
+    _task->Run();
+}
+
+v8::MaybeLocal<v8::Module> StreamedModule::finish(v8::Local<v8::Context> context) {
+    v8::Isolate *isolate = context->GetIsolate();
+    v8::EscapableHandleScope handleScope(isolate);
+    if (!_found) {
+        std::string message = "Cannot find module '" + _path + "'";
+        isolate->ThrowException(v8::Exception::Error(v8::String::NewFromUtf8(isolate, message.c_str()).ToLocalChecked()));
+        return v8::MaybeLocal<v8::Module>();
+    }
+    v8::Local<v8::String> fullSource;
+    v8::Local<v8::String> name;
+    if (!v8::String::NewFromUtf8(isolate, _source.data(), v8::NewStringType::kNormal, static_cast<int>(_source.size())).ToLocal(&fullSource) ||
+        !v8::String::NewFromUtf8(isolate, _path.c_str()).ToLocal(&name)) {
+        return v8::MaybeLocal<v8::Module>();
+    }
+    v8::ScriptOrigin origin(isolate, name, 0, 0, false, -1, v8::Local<v8::Value>(), false, false, true);
+    v8::Local<v8::Module> module;
+    if (!v8::ScriptCompiler::CompileModule(context, _streamed_source.get(), fullSource, origin).ToLocal(&module)) {
+        return v8::MaybeLocal<v8::Module>();
+    }
+    return handleScope.Escape(module);
+}
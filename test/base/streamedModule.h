@@ -0,0 +1,64 @@
+//
+// Created by user on 2026/10/17.
+//
+
+#ifndef V8_LEARN_STREAMED_MODULE_H
+#define V8_LEARN_STREAMED_MODULE_H
+#include "v8.h"
+#include <functional>
+#include <memory>
+#include <string>
+
+/**
+ * 在工作线程上读取并编译的一个 es 模块（ScriptCompiler::StartStreaming），ModuleGraphLoader 和 DynamicImportLoader 共用。
+ * 在隔离实例所在的线程上创建，run 可以在任意线程上执行，之后回到隔离实例所在的线程调用 finish 得到模块。
+ */
+class StreamedModule {
+public:
+    /**
+     * 读取模块源码（UTF-8），在工作线程上调用，必须是线程安全的。找不到模块时返回 false
+     */
+    using SourceReader = std::function<bool(const std::string &path, std::string &source)>;
+
+    /**
+     * 从文件系统读取源码
+     * @return
+     */
+    static SourceReader DefaultReader();
+
+    /**
+     * 开始编译，只能在隔离实例所在的线程上调用
+     * @param isolate
+     * @param path 模块的绝对路径，也是编译后模块的资源名
+     * @param reader 读取源码，生命周期需要长于本对象
+     */
+    StreamedModule(v8::Isolate *isolate, std::string path, const SourceReader *reader);
+    ~StreamedModule();
+    StreamedModule(const StreamedModule &) = delete;
+    StreamedModule &operator=(const StreamedModule &) = delete;
+
+    /**
+     * 读取源码并在后台完成解析，可以在任意线程上调用，只能调用一次
+     */
+    void run();
+    /**
+     * 完成编译，只能在隔离实例所在的线程上、run 返回之后调用。
+     * 找不到模块或者编译失败时返回空并且隔离实例上有待处理的异常
+     * @param context
+     * @return
+     */
+    v8::MaybeLocal<v8::Module> finish(v8::Local<v8::Context> context);
+
+    const std::string &getPath() const { return _path; }
+
+private:
+    class SourceStream;
+
+    std::string _path;
+    std::string _source;
+    bool _found = true;
+    std::unique_ptr<v8::ScriptCompiler::StreamedSource> _streamed_source;
+    std::unique_ptr<v8::ScriptCompiler::ScriptStreamingTask> _task;
+};
+
+#endif//V8_LEARN_STREAMED_MODULE_H
@@ -0,0 +1,125 @@
+//
+// Created by user on 2026/10/17.
+//
+
+#include "threadPool.h"
+#include <map>
+
+namespace {
+    // 当前线程所属的线程池和在池中的下标，非工作线程为空
+    thread_local ThreadPool *t_pool = nullptr;
+    thread_local size_t t_index = 0;
+}// namespace
+
+ThreadPool::ThreadPool(size_t threadCount, std::vector<ThreadPlacement> placements) {
+    if (threadCount == 0) {
+        threadCount = std::max(2u, std::thread::hardware_concurrency());
+    }
+    for (size_t i = 0; i < threadCount; ++i) {
+        _workers.push_back(std::make_unique<Worker>());
+        if (!placements.empty()) {
+            _workers[i]->placement = placements[i % placements.size()];
+        }
+    }
+    // 所有队列创建完成后再启动线程，避免窃取时访问到未创建的队列
+    for (size_t i = 0; i < threadCount; ++i) {
+        _workers[i]->thread = std::thread(&ThreadPool::work, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+    _condition.notify_all();
+    for (std::unique_ptr<Worker> &worker : _workers) {
+        worker->thread.join();
+    }
+}
+
+ThreadPool *ThreadPool::GetDefault() {
+    static ThreadPool pool;
+    return &pool;
+}
+
+ThreadPool *ThreadPool::GetNodePool(int node) {
+    const CpuTopology::Node *topologyNode = CpuTopology::Get().getNode(node);
+    if (topologyNode == nullptr || topologyNode->cpus.empty()) {
+        return GetDefault();
+    }
+    static std::mutex mutex;
+    static std::map<int, std::unique_ptr<ThreadPool>> pools;
+    std::lock_guard<std::mutex> lock(mutex);
+    std::unique_ptr<ThreadPool> &pool = pools[node];
+    if (!pool) {
+        ThreadPlacement placement;
+        placement.numaNode = node;
+        pool = std::make_unique<ThreadPool>(topologyNode->cpus.size(), std::vector<ThreadPlacement>{placement});
+    }
+    return pool.get();
+}
+
+void ThreadPool::submit(Task task) {
+    size_t index = t_pool == this ? t_index : _next++ % _workers.size();
+    {
+        // 先在 _mutex 内增加计数，保证工作线程检查条件和进入休眠之间不会错过唤醒，计数也不会小于 0
+        std::lock_guard<std::mutex> lock(_mutex);
+        _queued++;
+    }
+    {
+        Worker &worker = *_workers[index];
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        worker.tasks.push_back(std::move(task));
+    }
+    _condition.notify_one();
+}
+
+bool ThreadPool::pop(size_t index, Task &task) {
+    Worker &worker = *_workers[index];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    if (worker.tasks.empty()) {
+        return false;
+    }
+    task = std::move(worker.tasks.back());
+    worker.tasks.pop_back();
+    return true;
+}
+
+bool ThreadPool::steal(size_t index, Task &task) {
+    for (size_t i = 1; i < _workers.size(); ++i) {
+        Worker &victim = *_workers[(index + i) % _workers.size()];
+        std::unique_lock<std::mutex> lock(victim.mutex, std::try_to_lock);
+        if (!lock.owns_lock() || victim.tasks.empty()) {
+            continue;
+        }
+        task = std::move(victim.tasks.front());
+        victim.tasks.pop_front();
+        _steal_count++;
+        return true;
+    }
+    return false;
+}
+
+void ThreadPool::work(size_t index) {
+    t_pool = this;
+    t_index = index;
+    CpuTopology::Apply(_workers[index]->placement);
+    while (true) {
+        Task task;
+        if (pop(index, task) || steal(index, task)) {
+            _queued--;
+            task();
+            _executed_count++;
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(_mutex);
+        // 窃取时使用 try_lock 可能漏掉任务，计数不为 0 时重新查找
+        _condition.wait(lock, [this]() -> bool {
+            return _stopping || _queued.load() > 0;
+        });
+        if (_stopping && _queued.load() == 0) {
+            return;
+        }
+    }
+}
@@ -0,0 +1,89 @@
+//
+// Created by user on 2026/10/17.
+//
+
+#ifndef V8_LEARN_THREAD_POOL_H
+#define V8_LEARN_THREAD_POOL_H
+#include "cpuTopology.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * 固定大小的工作窃取线程池。
+ * 每个工作线程有自己的双端队列：自己从尾部取任务（后进先出，缓存友好），
+ * 空闲的工作线程从其他队列的头部窃取任务（先进先出，窃取的是最早的任务）。
+ * 任务之间不能互相阻塞等待，否则所有工作线程都被占满时会死锁。
+ */
+class ThreadPool {
+public:
+    using Task = std::function<void()>;
+
+    /**
+     * @param threadCount 工作线程数量，为 0 时使用硬件线程数
+     * @param placements 第 i 个工作线程使用 placements[i % placements.size()] 放置，为空时不限制
+     */
+    explicit ThreadPool(size_t threadCount = 0, std::vector<ThreadPlacement> placements = std::vector<ThreadPlacement>());
+    /**
+     * 执行完队列中剩余的任务后退出所有工作线程
+     */
+    ~ThreadPool();
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    /**
+     * 提交任务。在工作线程上提交时放入该线程自己的队列，否则轮流放入各个工作线程的队列
+     * @param task
+     */
+    void submit(Task task);
+    /**
+     * 进程默认的线程池，第一次使用时创建
+     * @return
+     */
+    static ThreadPool *GetDefault();
+    /**
+     * 绑定在 NUMA 节点上的线程池，第一次使用时创建，每个 cpu 一个工作线程。
+     * 工作线程只在该节点的 cpu 上运行，线程上创建的隔离实例的堆也分配在该节点上
+     * @param node
+     * @return 节点不存在时返回默认线程池
+     */
+    static ThreadPool *GetNodePool(int node);
+
+    size_t getThreadCount() const { return _workers.size(); }
+    const ThreadPlacement &getPlacement(size_t index) const { return _workers[index]->placement; }
+    /**
+     * 所有队列中等待执行的任务数量
+     * @return
+     */
+    size_t getQueueDepth() const { return _queued.load(); }
+    uint64_t getStealCount() const { return _steal_count.load(); }
+    uint64_t getExecutedCount() const { return _executed_count.load(); }
+
+private:
+    struct Worker {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+        ThreadPlacement placement;
+        std::thread thread;
+    };
+    void work(size_t index);
+    bool pop(size_t index, Task &task);
+    bool steal(size_t index, Task &task);
+
+    std::vector<std::unique_ptr<Worker>> _workers;
+    // 只用于空闲工作线程的休眠和唤醒
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    bool _stopping = false;
+    std::atomic<size_t> _queued{0};
+    std::atomic<size_t> _next{0};
+    std::atomic<uint64_t> _steal_count{0};
+    std::atomic<uint64_t> _executed_count{0};
+};
+
+#endif//V8_LEARN_THREAD_POOL_H
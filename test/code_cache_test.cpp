@@ -0,0 +1,79 @@
+#include "./base/codeCache.h"
+#include "./base/environment.h"
+#include <cstdio>
+
+TEST_F(Environment, code_cache_script) {
+    v8::Isolate *isolate = getIsolate();
+    v8::HandleScope handleScope(isolate);
+    CodeCache codeCache("./code_cache_test");
+    const char *scriptSource = "function square(value) {\n"
+                               "  return value * value;\n"
+                               "}\n"
+                               "square(3);\n";
+    v8::Local<v8::String> source = v8::String::NewFromUtf8(isolate, scriptSource).ToLocalChecked();
+    std::remove(codeCache.getCachePath(isolate, source, false).c_str());
+    v8::ScriptOrigin origin(isolate, v8::String::NewFromUtf8Literal(isolate, "square.js"));
+    {
+        // 第一次编译生成缓存文件
+        v8::Local<v8::Context> context = v8::Context::New(isolate);
+        v8::Context::Scope context_scope(context);
+        v8::Local<v8::Script> script = codeCache.compileScript(context, source, origin).ToLocalChecked();
+        EXPECT_EQ(script->Run(context).ToLocalChecked().As<v8::Number>()->Value(), 9);
+        EXPECT_EQ(codeCache.getMissCount(), 1);
+        EXPECT_EQ(Environment::ReadFile(codeCache.getCachePath(isolate, source, false)).empty(), false);
+    }
+    {
+        // 第二次从缓存反序列化
+        v8::Local<v8::Context> context = v8::Context::New(isolate);
+        v8::Context::Scope context_scope(context);
+        v8::Local<v8::Script> script = codeCache.compileScript(context, source, origin).ToLocalChecked();
+        EXPECT_EQ(script->Run(context).ToLocalChecked().As<v8::Number>()->Value(), 9);
+        EXPECT_EQ(codeCache.getHitCount(), 1);
+        EXPECT_EQ(codeCache.getRejectCount(), 0);
+    }
+}
+
+TEST_F(Environment, code_cache_rejected) {
+    v8::Isolate *isolate = getIsolate();
+    v8::HandleScope handleScope(isolate);
+    v8::Local<v8::Context> context = v8::Context::New(isolate);
+    v8::Context::Scope context_scope(context);
+    CodeCache codeCache("./code_cache_test");
+    v8::Local<v8::String> source = v8::String::NewFromUtf8Literal(isolate, "const rejected = 40;\nrejected + 2;\n");
+    v8::ScriptOrigin origin(isolate, v8::String::NewFromUtf8Literal(isolate, "rejected.js"));
+    // 写入损坏的缓存
+    std::string path = codeCache.getCachePath(isolate, source, false);
+    {
+        std::ofstream out(path.c_str(), std::ios::binary | std::ios::trunc);
+        out << "this is not a code cache";
+    }
+    // 缓存被拒绝后从源码编译，结果不受影响
+    v8::Local<v8::Script> script = codeCache.compileScript(context, source, origin).ToLocalChecked();
+    EXPECT_EQ(script->Run(context).ToLocalChecked().As<v8::Number>()->Value(), 42);
+    EXPECT_EQ(codeCache.getRejectCount(), 1);
+    // 损坏的缓存被新生成的缓存覆盖
+    EXPECT_NE(Environment::ReadFile(path), "this is not a code cache");
+}
+
+TEST_F(Environment, code_cache_module) {
+    v8::Isolate *isolate = getIsolate();
+    v8::HandleScope handleScope(isolate);
+    v8::Local<v8::Context> context = v8::Context::New(isolate);
+    v8::Context::Scope context_scope(context);
+    CodeCache codeCache("./code_cache_test");
+    v8::Local<v8::String> source = v8::String::NewFromUtf8Literal(isolate, "export const value = 1;\n");
+    std::remove(codeCache.getCachePath(isolate, source, true).c_str());
+    v8::ScriptOrigin origin(isolate, v8::String::NewFromUtf8Literal(isolate, "value.js"), 0, 0, false, -1, v8::Local<v8::Value>(), false, false, true);
+    for (int i = 0; i < 2; i++) {
+        v8::Local<v8::Module> module = codeCache.compileModule(isolate, source, origin).ToLocalChecked();
+        EXPECT_TRUE(module->InstantiateModule(context, [](v8::Local<v8::Context> context, v8::Local<v8::String> specifier,
+                                                          v8::Local<v8::FixedArray> import_assertions, v8::Local<v8::Module> referrer) -> v8::MaybeLocal<v8::Module> {
+                                    return v8::MaybeLocal<v8::Module>();
+                                })
+                            .FromJust());
+        module->Evaluate(context).ToLocalChecked();
+        EXPECT_TRUE(module->GetModuleNamespace().As<v8::Object>()->Get(context, v8::String::NewFromUtf8Literal(isolate, "value")).ToLocalChecked()->StrictEquals(v8::Number::New(isolate, 1)));
+    }
+    EXPECT_EQ(codeCache.getMissCount(), 1);
+    EXPECT_EQ(codeCache.getHitCount(), 1);
+}
@@ -0,0 +1,120 @@
+#include "./base/commonJsLoader.h"
+#include "./base/environment.h"
+
+/**
+ * 测试用的 CommonJS 模块目录，构建时复制到可执行文件所在目录
+ * @return
+ */
+static std::string fixtureDirectory() {
+    std::string directory;
+    FileSystemCache().realPath(Environment::GetWorkingDirectory() + "/source/commonjs", &directory);
+    return directory;
+}
+
+static v8::Local<v8::Value> get(v8::Local<v8::Context> context, v8::Local<v8::Value> object, const char *name) {
+    v8::Isolate *isolate = context->GetIsolate();
+    return object.As<v8::Object>()->Get(context, v8::String::NewFromUtf8(isolate, name).ToLocalChecked()).ToLocalChecked();
+}
+
+TEST_F(Environment, common_js_require) {
+    v8::Isolate *isolate = getIsolate();
+    v8::HandleScope handleScope(isolate);
+    v8::Local<v8::Context> context = v8::Context::New(isolate);
+    v8::Context::Scope context_scope(context);
+    std::string directory = fixtureDirectory();
+    ASSERT_FALSE(directory.empty());
+    CommonJsLoader loader(context);
+    EXPECT_EQ(CommonJsLoader::FromContext(context), &loader);
+    context->Global()->Set(context, v8::String::NewFromUtf8Literal(isolate, "require"), loader.createRequire(directory + "/index.js").ToLocalChecked()).Check();
+
+    v8::TryCatch tryCatch(isolate);
+    v8::Local<v8::Value> exports = v8::Script::Compile(context, v8::String::NewFromUtf8Literal(isolate, "require('./main')")).ToLocalChecked()->Run(context).ToLocalChecked();
+    ASSERT_FALSE(tryCatch.HasCaught());
+    EXPECT_EQ(get(context, exports, "sum").As<v8::Number>()->Value(), 3);
+    EXPECT_TRUE(get(context, exports, "same")->IsTrue());
+    // 包目录的 package.json main，包内向上查找 node_modules
+    v8::String::Utf8Value pkg(isolate, get(context, exports, "pkg"));
+    EXPECT_STREQ(*pkg, "pkg");
+    v8::String::Utf8Value dep(isolate, get(context, exports, "dep"));
+    EXPECT_STREQ(*dep, "dep");
+    EXPECT_EQ(get(context, exports, "value").As<v8::Number>()->Value(), 42);
+    // 循环依赖时拿到的是未完成的 exports
+    EXPECT_TRUE(get(context, exports, "cycle")->IsFalse());
+    v8::String::Utf8Value filename(isolate, get(context, exports, "filename"));
+    EXPECT_EQ(std::string(*filename), directory + "/main.js");
+    v8::String::Utf8Value dirname(isolate, get(context, exports, "dirname"));
+    EXPECT_EQ(std::string(*dirname), directory);
+
+    // main、math、a、b、entry、dep 各编译一次
+    EXPECT_EQ(loader.getCompiledCount(), 6);
+    v8::Local<v8::Array> keys = loader.getCache()->GetOwnPropertyNames(context).ToLocalChecked();
+    EXPECT_EQ(keys->Length(), 8);
+    v8::Local<v8::Value> mainModule = loader.getCache()->Get(context, v8::String::NewFromUtf8(isolate, (directory + "/main.js").c_str()).ToLocalChecked()).ToLocalChecked();
+    EXPECT_TRUE(get(context, mainModule, "loaded")->IsTrue());
+
+    // 从 require.cache 中删除后重新加载
+    v8::Script::Compile(context, v8::String::NewFromUtf8Literal(isolate, "delete require.cache[require.resolve('./lib/math')];\n"
+                                                                         "require('./lib/math');"))
+            .ToLocalChecked()
+            ->Run(context)
+            .ToLocalChecked();
+    EXPECT_EQ(loader.getCompiledCount(), 7);
+
+    // 内建模块
+    v8::Local<v8::Value> foo = v8::Script::Compile(context, v8::String::NewFromUtf8Literal(isolate, "require('foo').result")).ToLocalChecked()->Run(context).ToLocalChecked();
+    EXPECT_EQ(foo.As<v8::Number>()->Value(), 1);
+}
+
+TEST_F(Environment, common_js_require_error) {
+    v8::Isolate *isolate = getIsolate();
+    v8::HandleScope handleScope(isolate);
+    v8::Local<v8::Context> context = v8::Context::New(isolate);
+    v8::Context::Scope context_scope(context);
+    std::string directory = fixtureDirectory();
+    CommonJsLoader loader(context);
+    context->Global()->Set(context, v8::String::NewFromUtf8Literal(isolate, "require"), loader.createRequire(directory + "/index.js").ToLocalChecked()).Check();
+
+    v8::Local<v8::Value> code = v8::Script::Compile(context, v8::String::NewFromUtf8Literal(isolate, "try { require('./missing'); } catch (error) { error.code; }")).ToLocalChecked()->Run(context).ToLocalChecked();
+    v8::String::Utf8Value codeValue(isolate, code);
+    EXPECT_STREQ(*codeValue, "MODULE_NOT_FOUND");
+    // 执行失败的模块不留在缓存中，再次 require 会重新执行
+    v8::Local<v8::Value> count = v8::Script::Compile(context, v8::String::NewFromUtf8Literal(isolate, "for (let i = 0; i < 2; i++) { try { require('./throws'); } catch (error) {} }\n"
+                                                                                                      "globalThis.throwsCount;"))
+                                         .ToLocalChecked()
+                                         ->Run(context)
+                                         .ToLocalChecked();
+    EXPECT_EQ(count.As<v8::Number>()->Value(), 2);
+}
+
+TEST_F(Environment, common_js_resolve_cache) {
+    v8::Isolate *isolate = getIsolate();
+    v8::HandleScope handleScope(isolate);
+    v8::Local<v8::Context> context = v8::Context::New(isolate);
+    v8::Context::Scope context_scope(context);
+    std::string directory = fixtureDirectory();
+    FileSystemCache fileSystemCache;
+    CommonJsLoader loader(context, &fileSystemCache);
+    std::string libDirectory = directory + "/node_modules/pkg/lib";
+    std::string filename;
+    ASSERT_TRUE(loader.resolve("dep", libDirectory, &filename));
+    EXPECT_EQ(filename, directory + "/node_modules/dep/index.js");
+    uint64_t statCount = fileSystemCache.getStatCount();
+    uint64_t realPathCount = fileSystemCache.getRealPathCount();
+    EXPECT_GT(statCount, 0);
+
+    // 已经解析过的不再有系统调用
+    filename.clear();
+    ASSERT_TRUE(loader.resolve("dep", libDirectory, &filename));
+    EXPECT_EQ(filename, directory + "/node_modules/dep/index.js");
+    // 同一个包从其他目录解析，已经查询过的路径命中缓存
+    ASSERT_TRUE(loader.resolve("dep", directory + "/node_modules/pkg", &filename));
+    ASSERT_TRUE(loader.resolve("../../dep", libDirectory, &filename));
+    EXPECT_EQ(fileSystemCache.getStatCount(), statCount);
+    EXPECT_EQ(fileSystemCache.getRealPathCount(), realPathCount);
+    EXPECT_GT(fileSystemCache.getHitCount(), 0);
+
+    EXPECT_FALSE(loader.resolve("not-exist", libDirectory, &filename));
+    fileSystemCache.clear();
+    ASSERT_TRUE(loader.resolve("dep", libDirectory, &filename));
+    EXPECT_GT(fileSystemCache.getStatCount(), statCount);
+}
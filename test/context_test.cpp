@@ -2,6 +2,7 @@
 // Created by CF on 2021/5/21.
 //
 #include "./base/environment.h"
+#include "./base/lockerProfiler.h"
 #include "libplatform/libplatform.h"
 #include <iostream>
 #include <string>
@@ -362,7 +363,7 @@ TEST_F(Environment, context_SecurityChecks) {
 
 TEST_F(Environment, context_embedderData) {
     v8::Isolate *isolate = getIsolate();
-    v8::Locker locker(isolate);
+    PROFILED_LOCKER(locker, isolate);
     v8::HandleScope handleScope(isolate);
     v8::Local<v8::Context> context = v8::Context::New(isolate);
     v8::Context::Scope context_scope(context);
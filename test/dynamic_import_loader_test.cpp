@@ -0,0 +1,175 @@
+#include "./base/commonJsLoader.h"
+#include "./base/dynamicImportLoader.h"
+#include "./base/environment.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+static std::atomic<int> readCount{0};
+
+/**
+ * 读取模块源码，故意放慢，保证多次导入时第一次加载还没有完成
+ * @param path
+ * @param source
+ * @return
+ */
+static bool readSlowly(const std::string &path, std::string &source) {
+    readCount++;
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    if (path == "/app/lazy.js") {
+        source = "import { base } from './base.js';\n"
+                 "globalThis.evaluated = (globalThis.evaluated || 0) + 1;\n"
+                 "export const value = base + 1;\n";
+        return true;
+    }
+    return false;
+}
+
+/**
+ * 被动态导入的模块的静态依赖，实例化时通过模块表加载
+ * @param isolate
+ * @param path
+ * @return
+ */
+static v8::MaybeLocal<v8::String> loadStatic(v8::Isolate *isolate, const std::string &path) {
+    if (path == "/app/base.js") {
+        return v8::String::NewFromUtf8Literal(isolate, "export const base = 41;\n");
+    }
+    return v8::MaybeLocal<v8::String>();
+}
+
+/**
+ * 以 /app/main.js 为导入方执行脚本
+ * @param context
+ * @param source
+ * @return
+ */
+static v8::Local<v8::Value> runMain(v8::Local<v8::Context> context, const char *source) {
+    v8::Isolate *isolate = context->GetIsolate();
+    v8::ScriptOrigin origin(isolate, v8::String::NewFromUtf8Literal(isolate, "/app/main.js"));
+    v8::Local<v8::Script> script = v8::Script::Compile(context, v8::String::NewFromUtf8(isolate, source).ToLocalChecked(), &origin).ToLocalChecked();
+    return script->Run(context).ToLocalChecked();
+}
+
+static v8::Local<v8::Value> getGlobal(v8::Local<v8::Context> context, const char *name) {
+    v8::Isolate *isolate = context->GetIsolate();
+    return context->Global()->Get(context, v8::String::NewFromUtf8(isolate, name).ToLocalChecked()).ToLocalChecked();
+}
+
+TEST_F(Environment, dynamic_import_loader_shared) {
+    v8::Isolate *isolate = getIsolate();
+    isolate->SetHostImportModuleDynamicallyCallback(DynamicImportLoader::ImportModuleDynamically);
+    v8::HandleScope handleScope(isolate);
+    v8::Local<v8::Context> context = v8::Context::New(isolate);
+    v8::Context::Scope context_scope(context);
+    readCount = 0;
+    ModuleMap moduleMap(context, "/app", loadStatic);
+    EventLoop loop(isolate, g_default_platform);
+    ThreadPool threadPool(2);
+    DynamicImportLoader loader(context, &moduleMap, &loop, readSlowly, &threadPool);
+
+    // 同一个模块同时被导入多次，回调立即返回，只在后台加载一次
+    v8::Local<v8::Value> promise = runMain(context, "Promise.all([import('./lazy.js'), import('lazy.js'), import('/app/lazy.js')])\n"
+                                                    "    .then((modules) => { globalThis.values = modules.map((m) => m.value); });\n");
+    EXPECT_TRUE(promise->IsPromise());
+    EXPECT_EQ(loader.getInFlightCount(), 1);
+    EXPECT_EQ(loader.getLoadCount(), 1);
+    EXPECT_EQ(loader.getSharedCount(), 2);
+    loop.run();
+    EXPECT_EQ(readCount.load(), 1);
+    EXPECT_EQ(loader.getInFlightCount(), 0);
+    EXPECT_EQ(getGlobal(context, "evaluated").As<v8::Number>()->Value(), 1);
+    v8::Local<v8::Array> values = getGlobal(context, "values").As<v8::Array>();
+    ASSERT_EQ(values->Length(), 3);
+    for (uint32_t i = 0; i < values->Length(); i++) {
+        EXPECT_EQ(values->Get(context, i).ToLocalChecked().As<v8::Number>()->Value(), 42);
+    }
+    EXPECT_TRUE(moduleMap.contains("/app/base.js"));
+
+    // 加载完成后的导入直接命中模块表
+    runMain(context, "import('./lazy.js').then((m) => { globalThis.again = m.value; });\n");
+    EXPECT_EQ(loader.getCacheHitCount(), 1);
+    loop.run();
+    EXPECT_EQ(readCount.load(), 1);
+    EXPECT_EQ(getGlobal(context, "again").As<v8::Number>()->Value(), 42);
+    EXPECT_EQ(getGlobal(context, "evaluated").As<v8::Number>()->Value(), 1);
+}
+
+TEST_F(Environment, dynamic_import_loader_not_found) {
+    v8::Isolate *isolate = getIsolate();
+    isolate->SetHostImportModuleDynamicallyCallback(DynamicImportLoader::ImportModuleDynamically);
+    v8::HandleScope handleScope(isolate);
+    v8::Local<v8::Context> context = v8::Context::New(isolate);
+    v8::Context::Scope context_scope(context);
+    readCount = 0;
+    ModuleMap moduleMap(context, "/app", loadStatic);
+    EventLoop loop(isolate, g_default_platform);
+    DynamicImportLoader loader(context, &moduleMap, &loop, readSlowly);
+
+    runMain(context, "import('./missing.js').catch((error) => { globalThis.message = error.message; });\n"
+                     "import('./missing.js').catch((error) => { globalThis.shared = error.message; });\n");
+    loop.run();
+    EXPECT_EQ(readCount.load(), 1);
+    v8::String::Utf8Value message(isolate, getGlobal(context, "message"));
+    EXPECT_STREQ(*message, "Cannot find module '/app/missing.js'");
+    v8::String::Utf8Value shared(isolate, getGlobal(context, "shared"));
+    EXPECT_STREQ(*shared, *message);
+    // 失败的模块不进入模块表
+    EXPECT_FALSE(moduleMap.contains("/app/missing.js"));
+}
+
+/**
+ * 模块表同步加载时也能读到 lazy.js
+ * @param isolate
+ * @param path
+ * @return
+ */
+static v8::MaybeLocal<v8::String> loadStaticAndLazy(v8::Isolate *isolate, const std::string &path) {
+    std::string source;
+    if (path == "/app/lazy.js" && readSlowly(path, source)) {
+        return v8::String::NewFromUtf8(isolate, source.c_str());
+    }
+    return loadStatic(isolate, path);
+}
+
+TEST_F(Environment, dynamic_import_loader_loaded_while_streaming) {
+    v8::Isolate *isolate = getIsolate();
+    isolate->SetHostImportModuleDynamicallyCallback(DynamicImportLoader::ImportModuleDynamically);
+    v8::HandleScope handleScope(isolate);
+    v8::Local<v8::Context> context = v8::Context::New(isolate);
+    v8::Context::Scope context_scope(context);
+    ModuleMap moduleMap(context, "/app", loadStaticAndLazy);
+    EventLoop loop(isolate, g_default_platform);
+    ThreadPool threadPool(1);
+    DynamicImportLoader loader(context, &moduleMap, &loop, readSlowly, &threadPool);
+
+    runMain(context, "import('./lazy.js').then((m) => { globalThis.imported = m; });\n");
+    EXPECT_EQ(loader.getInFlightCount(), 1);
+    // 后台编译还没有完成时，同一个路径通过模块表同步加载
+    v8::Local<v8::Module> module = moduleMap.load("/app/lazy.js").ToLocalChecked();
+    loop.run();
+    // import() 得到的是模块表中的同一个模块，只执行一次
+    ASSERT_EQ(module->GetStatus(), v8::Module::kEvaluated);
+    EXPECT_TRUE(getGlobal(context, "imported")->StrictEquals(module->GetModuleNamespace()));
+    EXPECT_EQ(getGlobal(context, "evaluated").As<v8::Number>()->Value(), 1);
+}
+
+TEST_F(Environment, dynamic_import_loader_common_js_only_context) {
+    v8::Isolate *isolate = getIsolate();
+    isolate->SetHostImportModuleDynamicallyCallback(DynamicImportLoader::ImportModuleDynamically);
+    v8::HandleScope handleScope(isolate);
+    v8::Local<v8::Context> context = v8::Context::New(isolate);
+    v8::Context::Scope context_scope(context);
+    // 只设置了下标最大的 CommonJS 加载器，模块表和动态导入加载器的下标没有写过
+    CommonJsLoader commonJsLoader(context);
+    EXPECT_EQ(ModuleMap::FromContext(context), nullptr);
+    EXPECT_EQ(DynamicImportLoader::FromContext(context), nullptr);
+
+    v8::TryCatch tryCatch(isolate);
+    v8::ScriptOrigin origin(isolate, v8::String::NewFromUtf8Literal(isolate, "/app/main.js"));
+    v8::Local<v8::Script> script = v8::Script::Compile(context, v8::String::NewFromUtf8Literal(isolate, "import('./lazy.js')"), &origin).ToLocalChecked();
+    EXPECT_TRUE(script->Run(context).IsEmpty());
+    ASSERT_TRUE(tryCatch.HasCaught());
+    v8::String::Utf8Value message(isolate, tryCatch.Exception());
+    EXPECT_STREQ(*message, "Error: dynamic import loader not found");
+}
@@ -0,0 +1,84 @@
+#include "./base/embedderPlatform.h"
+#include "gtest/gtest.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+class CountTask : public v8::Task {
+public:
+    explicit CountTask(std::atomic<int> *count) : count(count) {}
+    void Run() override {
+        (*count)++;
+    }
+
+private:
+    std::atomic<int> *count;
+};
+
+static void WaitFor(std::atomic<int> &count, int expected) {
+    for (int i = 0; i < 2000 && count.load() < expected; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+TEST(embedder_platform_test, parse_cpu_list) {
+    EXPECT_EQ(EmbedderPlatform::ParseCpuList("0-3,6"), std::vector<int>({0, 1, 2, 3, 6}));
+    EXPECT_EQ(EmbedderPlatform::ParseCpuList("2"), std::vector<int>({2}));
+    EXPECT_TRUE(EmbedderPlatform::ParseCpuList("").empty());
+}
+
+TEST(embedder_platform_test, worker_thread_priorities) {
+    EmbedderPlatform::Options options;
+    options.threadCount = 2;
+    EmbedderPlatform platform(options);
+    EXPECT_EQ(platform.NumberOfWorkerThreads(), 2);
+    std::atomic<int> count{0};
+    for (int i = 0; i < 10; ++i) {
+        platform.CallOnWorkerThread(std::make_unique<CountTask>(&count));
+        platform.CallBlockingTaskOnWorkerThread(std::make_unique<CountTask>(&count));
+        platform.CallLowPriorityTaskOnWorkerThread(std::make_unique<CountTask>(&count));
+    }
+    WaitFor(count, 30);
+    EXPECT_EQ(count.load(), 30);
+    // 每个队列单独统计
+    EXPECT_EQ(platform.getQueueStats(v8::TaskPriority::kUserVisible).count, 10);
+    EXPECT_EQ(platform.getQueueStats(v8::TaskPriority::kUserBlocking).count, 10);
+    EXPECT_EQ(platform.getQueueStats(v8::TaskPriority::kBestEffort).count, 10);
+    EXPECT_EQ(platform.getQueueStats(v8::TaskPriority::kBestEffort).depth, 0);
+}
+
+TEST(embedder_platform_test, delayed_task) {
+    EmbedderPlatform::Options options;
+    options.threadCount = 1;
+    EmbedderPlatform platform(options);
+    std::atomic<int> count{0};
+    double start = platform.MonotonicallyIncreasingTime();
+    platform.CallDelayedOnWorkerThread(std::make_unique<CountTask>(&count), 0.05);
+    WaitFor(count, 1);
+    EXPECT_EQ(count.load(), 1);
+    EXPECT_GE(platform.MonotonicallyIncreasingTime() - start, 0.05);
+}
+
+TEST(embedder_platform_test, post_job) {
+    class CountJob : public v8::JobTask {
+    public:
+        explicit CountJob(std::atomic<int> *count) : count(count) {}
+        void Run(v8::JobDelegate *delegate) override {
+            while (!delegate->ShouldYield() && count->fetch_add(1) < 99) {
+            }
+        }
+        size_t GetMaxConcurrency(size_t worker_count) const override {
+            return count->load() < 100 ? 2 : 0;
+        }
+
+    private:
+        std::atomic<int> *count;
+    };
+    EmbedderPlatform::Options options;
+    options.threadCount = 2;
+    EmbedderPlatform platform(options);
+    std::atomic<int> count{0};
+    std::unique_ptr<v8::JobHandle> handle = platform.PostJob(v8::TaskPriority::kUserVisible, std::make_unique<CountJob>(&count));
+    handle->Join();
+    EXPECT_GE(count.load(), 100);
+}
@@ -0,0 +1,185 @@
+#include "./base/environment.h"
+#include "./base/eventLoop.h"
+#include "v8-platform.h"
+#include <chrono>
+#include <thread>
+#include <vector>
+#if defined(LINUX)
+#include <unistd.h>
+#endif
+
+static unsigned int global_count = 0;
+
+TEST_F(Environment, event_loop_resolve_from_worker) {
+    global_count = 0;
+    v8::Isolate *isolate = getIsolate();
+    EventLoop loop(isolate, g_default_platform);
+    v8::HandleScope handleScope(isolate);
+    v8::Local<v8::Context> context = v8::Context::New(isolate);
+    v8::Context::Scope context_scope(context);
+    v8::Local<v8::Promise::Resolver> resolver = v8::Promise::Resolver::New(context).ToLocalChecked();
+    v8::Local<v8::Promise> promise = resolver->GetPromise();
+    EXPECT_FALSE(promise->Then(context, v8::Function::New(context, [](const v8::FunctionCallbackInfo<v8::Value> &info) -> void {
+                                              global_count++;
+                                              EXPECT_EQ(info[0].As<v8::Number>()->Value(), 42);
+                                          }).ToLocalChecked())
+                         .IsEmpty());
+    v8::Global<v8::Context> persistentContext(isolate, context);
+    v8::Global<v8::Promise::Resolver> persistentResolver(isolate, resolver);
+
+    // 工作线程只做计算，结果通过事件循环回到隔离实例所在的线程
+    loop.ref();
+    std::thread thread([&loop, &persistentContext, &persistentResolver]() -> void {
+        int result = 6 * 7;
+        loop.post([&loop, &persistentContext, &persistentResolver, result]() -> void {
+            v8::Isolate *isolate = loop.getIsolate();
+            v8::Local<v8::Context> context = persistentContext.Get(isolate);
+            persistentResolver.Get(isolate)->Resolve(context, v8::Number::New(isolate, result)).Check();
+            loop.unref();
+        });
+    });
+    loop.run();
+    thread.join();
+    // 微任务在 run 中执行
+    EXPECT_EQ(global_count, 1);
+    EXPECT_EQ(promise->State(), v8::Promise::PromiseState::kFulfilled);
+}
+
+TEST_F(Environment, event_loop_batch_completion) {
+    global_count = 0;
+    v8::Isolate *isolate = getIsolate();
+    EventLoop loop(isolate, g_default_platform);
+    const int workerCount = 8;
+    const int postCount = 100;
+    for (int i = 0; i < workerCount; ++i) {
+        loop.ref();
+    }
+    std::vector<std::thread> threads;
+    for (int i = 0; i < workerCount; ++i) {
+        threads.emplace_back([&loop]() -> void {
+            for (int j = 0; j < postCount; ++j) {
+                loop.post([]() -> void { global_count++; });
+            }
+            loop.post([&loop]() -> void { loop.unref(); });
+        });
+    }
+    loop.run();
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(global_count, workerCount * postCount);
+    // 同一次 tick 中批量执行完成回调，事件循环处理之前连续提交的回调只唤醒一次
+    EXPECT_LT(loop.getTickCount(), static_cast<uint64_t>(workerCount * (postCount + 1)));
+    EXPECT_LT(loop.getWakeupCount(), static_cast<uint64_t>(workerCount * (postCount + 1)));
+}
+
+TEST(mpsc_queue_test, multiple_producers) {
+    const int producerCount = 4;
+    const int pushCount = 10000;
+    MpscQueue<int> queue;
+    EXPECT_TRUE(queue.empty());
+    std::vector<std::thread> threads;
+    for (int i = 0; i < producerCount; ++i) {
+        threads.emplace_back([&queue, i]() -> void {
+            for (int j = 0; j < pushCount; ++j) {
+                queue.push(i * pushCount + j);
+            }
+        });
+    }
+    // 每个生产者的元素按提交顺序出队
+    std::vector<int> last(producerCount, -1);
+    int received = 0;
+    while (received < producerCount * pushCount) {
+        int value;
+        MpscQueue<int>::PopResult result = queue.pop(value);
+        if (result != MpscQueue<int>::PopResult::kItem) {
+            // 正在入队时队列不为空
+            if (result == MpscQueue<int>::PopResult::kBusy) {
+                EXPECT_FALSE(queue.empty());
+            }
+            std::this_thread::yield();
+            continue;
+        }
+        int producer = value / pushCount;
+        ASSERT_GT(value % pushCount, last[producer]);
+        last[producer] = value % pushCount;
+        received++;
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+    EXPECT_TRUE(queue.empty());
+    int value;
+    EXPECT_EQ(queue.pop(value), MpscQueue<int>::PopResult::kEmpty);
+}
+
+TEST_F(Environment, event_loop_platform_delayed_task) {
+    global_count = 0;
+    v8::Isolate *isolate = getIsolate();
+    EventLoop loop(isolate, g_default_platform);
+    class DelayedTask : public v8::Task {
+    public:
+        explicit DelayedTask(EventLoop *loop) : loop(loop) {}
+        void Run() override {
+            global_count++;
+            loop->unref();
+        }
+
+    private:
+        EventLoop *loop;
+    };
+    loop.ref();
+    g_default_platform->GetForegroundTaskRunner(isolate)->PostDelayedTask(std::make_unique<DelayedTask>(&loop), 0.02);
+    loop.run();
+    EXPECT_EQ(global_count, 1);
+}
+
+TEST_F(Environment, event_loop_delayed_task) {
+    global_count = 0;
+    v8::Isolate *isolate = getIsolate();
+    EventLoop loop(isolate, g_default_platform);
+    class CountTask : public v8::Task {
+    public:
+        void Run() override {
+            global_count++;
+        }
+    };
+    // 不需要 ref，定时任务执行之前 run 不会返回
+    auto start = std::chrono::steady_clock::now();
+    loop.postDelayedTask(std::make_unique<CountTask>(), 0.05);
+    loop.postDelayedTask(std::make_unique<CountTask>(), 0.01);
+    // 其他线程通过 post 转交到事件循环线程上投递
+    std::thread thread([&loop]() -> void {
+        loop.post([&loop]() -> void {
+            loop.postDelayedTask(std::make_unique<CountTask>(), 0.02);
+        });
+    });
+    thread.join();
+    loop.run();
+    EXPECT_EQ(global_count, 3);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(50));
+}
+
+#if defined(LINUX)
+TEST_F(Environment, event_loop_watch_fd) {
+    global_count = 0;
+    v8::Isolate *isolate = getIsolate();
+    EventLoop loop(isolate, g_default_platform);
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+    EXPECT_TRUE(loop.watch(fds[0], EPOLLIN, [&loop, &fds](uint32_t events) -> void {
+        char buffer[16];
+        EXPECT_EQ(read(fds[0], buffer, sizeof(buffer)), 5);
+        global_count++;
+        loop.unwatch(fds[0]);
+    }));
+    std::thread thread([&fds]() -> void {
+        EXPECT_EQ(write(fds[1], "hello", 5), 5);
+    });
+    loop.run();
+    thread.join();
+    close(fds[0]);
+    close(fds[1]);
+    EXPECT_EQ(global_count, 1);
+}
+#endif
@@ -0,0 +1,34 @@
+#include "./base/filePath.h"
+#include "gtest/gtest.h"
+
+TEST(file_path_test, normalize) {
+    EXPECT_EQ(FilePath::Normalize("./b/../c.js", "/a"), "/a/c.js");
+    EXPECT_EQ(FilePath::Normalize("/x/./y//z.js", "/a"), "/x/y/z.js");
+    EXPECT_EQ(FilePath::Normalize("../../../x.js", "/a/b"), "/x.js");
+    EXPECT_EQ(FilePath::Normalize("foo.js", ""), "/foo.js");
+    EXPECT_EQ(FilePath::Normalize("lib\\foo.js", "/a/"), "/a/lib/foo.js");
+    EXPECT_EQ(FilePath::Normalize("..", "/"), "/");
+    EXPECT_EQ(FilePath::Normalize("b/", "a"), "a/b");
+}
+
+TEST(file_path_test, normalize_buffer) {
+    char buffer[8];
+    size_t length = FilePath::Normalize("c.js", "/a", buffer, sizeof(buffer));
+    ASSERT_NE(length, StringView::npos);
+    EXPECT_EQ(std::string(buffer, length), "/a/c.js");
+    // 缓冲区不够时不会越界
+    EXPECT_EQ(FilePath::Normalize("long.js", "/a", buffer, sizeof(buffer)), StringView::npos);
+}
+
+TEST(file_path_test, dir_name) {
+    std::string path = "/a/b/c.js";
+    StringView dirName = FilePath::DirName(path);
+    EXPECT_EQ(dirName, "/a/b");
+    // 返回的是原路径的子视图
+    EXPECT_EQ(dirName.data(), path.data());
+    EXPECT_EQ(FilePath::DirName("/c.js"), "");
+    EXPECT_EQ(FilePath::DirName("a/c.js"), "");
+    EXPECT_TRUE(FilePath::IsAbsolute("/a"));
+    EXPECT_FALSE(FilePath::IsAbsolute("a"));
+    EXPECT_FALSE(FilePath::IsAbsolute(""));
+}
@@ -0,0 +1,49 @@
+#include "./base/environment.h"
+#include "./base/heapTelemetry.h"
+#include <cstdio>
+
+/**
+ * 读取临时文件的全部内容
+ * @param file
+ * @return
+ */
+static std::string readAll(FILE *file) {
+    std::string content;
+    rewind(file);
+    char buffer[4096];
+    size_t size;
+    while ((size = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        content.append(buffer, size);
+    }
+    return content;
+}
+
+TEST_F(Environment, heap_telemetry_gc_pause) {
+    v8::Isolate *isolate = getIsolate();
+    FILE *out = tmpfile();
+    ASSERT_NE(out, nullptr);
+    {
+        HeapTelemetry telemetry(isolate);
+        {
+            v8::HandleScope handleScope(isolate);
+            v8::Local<v8::Context> context = v8::Context::New(isolate);
+            v8::Context::Scope context_scope(context);
+            v8::Local<v8::String> source = v8::String::NewFromUtf8Literal(isolate, "var list = []; for (var i = 0; i < 10000; i++) list.push({i: i});");
+            v8::Script::Compile(context, source).ToLocalChecked()->Run(context).ToLocalChecked();
+        }
+        // 触发完整 GC
+        isolate->LowMemoryNotification();
+        telemetry.writeJsonLine(out, "heap_telemetry_gc_pause", "\"extra\": 1");
+    }
+    std::string line = readAll(out);
+    fclose(out);
+    EXPECT_EQ(line.find("{\"name\": \"heap_telemetry_gc_pause\""), 0);
+    EXPECT_EQ(line.back(), '\n');
+    // 完整 GC 计入 mark_sweep_compact，不会被记成其他类型
+    EXPECT_EQ(line.find("\"mark_sweep_compact\": {\"count\": 0"), std::string::npos);
+    // 只输出 v8 头文件中实际存在的 GC 类型
+    EXPECT_EQ(line.find("minor_mark_compact"), std::string::npos);
+    EXPECT_NE(line.find("\"used_heap_size\""), std::string::npos);
+    EXPECT_NE(line.find("\"old_space\""), std::string::npos);
+    EXPECT_NE(line.find("\"extra\": 1}"), std::string::npos);
+}
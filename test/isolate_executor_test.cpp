@@ -0,0 +1,75 @@
+#include "./base/environment.h"
+#include "./base/isolateExecutor.h"
+
+static const char *kSetupSource = "function fib(n) { return n < 2 ? n : fib(n - 1) + fib(n - 2); }\n"
+                                  "function sum(...values) { return { total: values.reduce((a, b) => a + b, 0) }; }\n"
+                                  "async function later(value) { await null; return value * 2; }";
+
+TEST_F(Environment, isolate_executor_call) {
+    v8::Isolate *isolate = getIsolate();
+    v8::HandleScope handleScope(isolate);
+    v8::Local<v8::Context> context = v8::Context::New(isolate);
+    v8::Context::Scope context_scope(context);
+    IsolateExecutor executor(2, kSetupSource, g_default_platform);
+    EXPECT_EQ(executor.getWorkerCount(), 2);
+
+    // 参数在当前隔离实例中序列化，结果在当前隔离实例中反序列化
+    std::vector<uint8_t> arguments;
+    v8::Local<v8::Value> values[] = {v8::Number::New(isolate, 1), v8::Number::New(isolate, 2), v8::Number::New(isolate, 3)};
+    ASSERT_TRUE(IsolateExecutor::Serialize(context, v8::Array::New(isolate, values, 3), &arguments));
+    IsolateExecutor::Result result = executor.call("sum", arguments).get();
+    ASSERT_TRUE(result.success) << result.error;
+    v8::Local<v8::Value> value = IsolateExecutor::Deserialize(context, result.value).ToLocalChecked();
+    v8::Local<v8::Value> total = value.As<v8::Object>()->Get(context, v8::String::NewFromUtf8Literal(isolate, "total")).ToLocalChecked();
+    EXPECT_EQ(total.As<v8::Number>()->Value(), 6);
+
+    // 异步函数等待微任务执行完
+    ASSERT_TRUE(IsolateExecutor::Serialize(context, v8::Array::New(isolate, values, 1), &arguments));
+    result = executor.call("later", arguments).get();
+    ASSERT_TRUE(result.success) << result.error;
+    EXPECT_EQ(IsolateExecutor::Deserialize(context, result.value).ToLocalChecked().As<v8::Number>()->Value(), 2);
+
+    result = executor.evaluate("fib(10)").get();
+    ASSERT_TRUE(result.success) << result.error;
+    EXPECT_EQ(IsolateExecutor::Deserialize(context, result.value).ToLocalChecked().As<v8::Number>()->Value(), 55);
+}
+
+TEST_F(Environment, isolate_executor_error) {
+    IsolateExecutor executor(1, kSetupSource);
+    IsolateExecutor::Result result = executor.evaluate("throw new RangeError('bad')").get();
+    EXPECT_FALSE(result.success);
+    EXPECT_EQ(result.error, "RangeError: bad");
+    result = executor.call("missing").get();
+    EXPECT_FALSE(result.success);
+    EXPECT_EQ(result.error, "TypeError: missing is not a function");
+    // 函数不能序列化
+    result = executor.evaluate("fib").get();
+    EXPECT_FALSE(result.success);
+    // 出错后工作线程继续可用
+    EXPECT_TRUE(executor.evaluate("fib(1)").get().success);
+
+    IsolateExecutor broken(1, "syntax error(");
+    result = broken.evaluate("1").get();
+    EXPECT_FALSE(result.success);
+    EXPECT_EQ(result.error.compare(0, 11, "SyntaxError"), 0);
+}
+
+TEST_F(Environment, isolate_executor_least_loaded) {
+    const size_t workerCount = 4;
+    IsolateExecutor executor(workerCount, kSetupSource);
+    std::vector<std::future<IsolateExecutor::Result>> futures;
+    for (int i = 0; i < 32; i++) {
+        futures.push_back(executor.evaluate("fib(20)"));
+    }
+    for (std::future<IsolateExecutor::Result> &future : futures) {
+        EXPECT_TRUE(future.get().success);
+    }
+    EXPECT_EQ(executor.getPendingCount(), 0);
+    // 任务分散到所有工作线程上
+    uint64_t executed = 0;
+    for (size_t i = 0; i < workerCount; i++) {
+        EXPECT_GT(executor.getExecutedCount(i), 0);
+        executed += executor.getExecutedCount(i);
+    }
+    EXPECT_EQ(executed, 32);
+}
@@ -0,0 +1,161 @@
+#include "./base/isolateCallbacks.h"
+#include "./base/isolatePool.h"
+#include "gtest/gtest.h"
+#include <chrono>
+#include <functional>
+#include <thread>
+
+/**
+ * 等待后台线程满足条件，超时返回 false
+ * @param predicate
+ * @return
+ */
+static bool waitFor(const std::function<bool()> &predicate) {
+    for (int i = 0; i < 1000; i++) {
+        if (predicate()) {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return predicate();
+}
+
+TEST(isolate_pool_test, prewarm_hit_and_miss) {
+    IsolatePool pool(2);
+    // 后台线程把池填满
+    EXPECT_TRUE(waitFor([&pool]() -> bool { return pool.getIdleCount() == 2; }));
+    v8::Isolate *isolate1 = pool.acquire();
+    v8::Isolate *isolate2 = pool.acquire();
+    EXPECT_EQ(pool.getHitCount(), 2);
+    EXPECT_EQ(pool.getMissCount(), 0);
+    EXPECT_TRUE(pool.getArrayBufferAllocator(isolate1) != nullptr);
+    {
+        v8::Isolate::Scope scope(isolate1);
+        v8::HandleScope handleScope(isolate1);
+        v8::Local<v8::Context> context = v8::Context::New(isolate1);
+        v8::Context::Scope context_scope(context);
+        v8::Local<v8::Value> result = v8::Script::Compile(context, v8::String::NewFromUtf8Literal(isolate1, "1 + 1")).ToLocalChecked()->Run(context).ToLocalChecked();
+        EXPECT_EQ(result.As<v8::Number>()->Value(), 2);
+    }
+    pool.release(isolate1);
+    pool.release(isolate2);
+    // 池容量为 0 时每次都要同步创建
+    IsolatePool emptyPool(0);
+    v8::Isolate *isolate3 = emptyPool.acquire();
+    EXPECT_EQ(emptyPool.getHitCount(), 0);
+    EXPECT_EQ(emptyPool.getMissCount(), 1);
+    emptyPool.release(isolate3);
+}
+
+TEST(isolate_pool_test, reset_reusable_isolate) {
+    IsolatePool pool(1);
+    EXPECT_TRUE(waitFor([&pool]() -> bool { return pool.getIdleCount() == 1; }));
+    v8::Isolate *isolate = pool.acquire();
+    {
+        v8::Locker locker(isolate);
+        v8::Isolate::Scope scope(isolate);
+        isolate->SetMicrotasksPolicy(v8::MicrotasksPolicy::kExplicit);
+    }
+    pool.release(isolate, true);
+    EXPECT_TRUE(waitFor([&pool]() -> bool { return pool.getIdleCount() == 1; }));
+    // 无论拿到的是复用的还是新建的隔离实例，状态都应该是初始状态
+    isolate = pool.acquire();
+    {
+        v8::Locker locker(isolate);
+        v8::Isolate::Scope scope(isolate);
+        EXPECT_EQ(isolate->GetMicrotasksPolicy(), v8::MicrotasksPolicy::kAuto);
+    }
+    pool.release(isolate);
+}
+
+/**
+ * 在隔离实例上执行会抛出未捕获异常的脚本并做一次完整的 GC，触发消息监听和 GC 回调
+ * @param isolate
+ */
+static void throwAndCollect(v8::Isolate *isolate) {
+    v8::HandleScope handleScope(isolate);
+    v8::Local<v8::Context> context = v8::Context::New(isolate);
+    v8::Context::Scope context_scope(context);
+    EXPECT_TRUE(v8::Script::Compile(context, v8::String::NewFromUtf8Literal(isolate, "throw new Error('error');")).ToLocalChecked()->Run(context).IsEmpty());
+    isolate->LowMemoryNotification();
+}
+
+TEST(isolate_pool_test, reuse_without_leaking_callbacks) {
+    static int messageCount = 0;
+    int gcCount = 0;
+    IsolatePool pool(1);
+    EXPECT_TRUE(waitFor([&pool]() -> bool { return pool.getIdleCount() == 1; }));
+    v8::Isolate *isolate = pool.acquire();
+    // 等待池补充完，归还的隔离实例替换队尾的空闲隔离实例，仍然优先被取出
+    EXPECT_TRUE(waitFor([&pool]() -> bool { return pool.getIdleCount() == 1; }));
+    {
+        v8::Locker locker(isolate);
+        v8::Isolate::Scope scope(isolate);
+        IsolateCallbacks::AddMessageListener(isolate, [](v8::Local<v8::Message> message, v8::Local<v8::Value> data) -> void {
+            messageCount++;
+        });
+        IsolateCallbacks::AddGCPrologueCallback(
+                isolate, [](v8::Isolate *isolate, v8::GCType type, v8::GCCallbackFlags flags, void *data) -> void {
+                    (*static_cast<int *>(data))++;
+                },
+                &gcCount);
+        throwAndCollect(isolate);
+        EXPECT_EQ(IsolateCallbacks::Count(isolate), 2);
+    }
+    EXPECT_EQ(messageCount, 1);
+    EXPECT_GT(gcCount, 0);
+    pool.release(isolate, true);
+    EXPECT_TRUE(waitFor([&pool]() -> bool { return pool.getRecycleCount() == 1; }));
+    EXPECT_EQ(pool.getIdleCount(), 1);
+    v8::Isolate *reused = pool.acquire();
+    EXPECT_EQ(reused, isolate);
+    messageCount = 0;
+    gcCount = 0;
+    {
+        v8::Locker locker(reused);
+        v8::Isolate::Scope scope(reused);
+        EXPECT_EQ(IsolateCallbacks::Count(reused), 0);
+        throwAndCollect(reused);
+    }
+    // 上一次使用注册的回调都已经移除
+    EXPECT_EQ(messageCount, 0);
+    EXPECT_EQ(gcCount, 0);
+    pool.release(reused);
+}
+
+/**
+ * 在隔离实例上创建指定长度的 ArrayBuffer，返回前释放
+ * @param isolate
+ * @param length
+ */
+static void allocateArrayBuffer(v8::Isolate *isolate, size_t length) {
+    v8::Locker locker(isolate);
+    v8::Isolate::Scope scope(isolate);
+    {
+        v8::HandleScope handleScope(isolate);
+        v8::Local<v8::Context> context = v8::Context::New(isolate);
+        v8::Context::Scope context_scope(context);
+        v8::ArrayBuffer::New(isolate, length);
+    }
+    isolate->LowMemoryNotification();
+}
+
+TEST(isolate_pool_test, reused_isolate_peak_bytes) {
+    const size_t largeLength = 8 * 1024 * 1024;
+    const size_t smallLength = 1024;
+    IsolatePool pool(1);
+    EXPECT_TRUE(waitFor([&pool]() -> bool { return pool.getIdleCount() == 1; }));
+    v8::Isolate *isolate = pool.acquire();
+    allocateArrayBuffer(isolate, largeLength);
+    EXPECT_GE(pool.getArrayBufferAllocator(isolate)->getPeakBytes(), largeLength);
+    pool.release(isolate, true);
+    EXPECT_TRUE(waitFor([&pool]() -> bool { return pool.getRecycleCount() == 1; }));
+    // 同一个隔离实例上之后的小分配只统计自己的峰值
+    v8::Isolate *reused = pool.acquire();
+    ASSERT_EQ(reused, isolate);
+    allocateArrayBuffer(reused, smallLength);
+    PooledArrayBufferAllocator *allocator = pool.getArrayBufferAllocator(reused);
+    EXPECT_GE(allocator->getPeakBytes(), smallLength);
+    EXPECT_LT(allocator->getPeakBytes(), largeLength);
+    pool.release(reused);
+}
@@ -1,5 +1,8 @@
 
+#include "./base/dynamicImportLoader.h"
 #include "./base/environment.h"
+#include "./base/isolateCallbacks.h"
+#include "./base/lockerProfiler.h"
 #include "libplatform/libplatform.h"
 #include <iostream>
 #include <string>
@@ -162,7 +165,7 @@ TEST(isolate_test, scope) {
         v8::Isolate::Scope scope(isolate1);
         // 把隔离实例传递到其他线程使用
         std::thread thread([](v8::Isolate *isolate1) -> void {
-            v8::Locker locker(isolate1);
+            PROFILED_LOCKER(locker, isolate1);
             EXPECT_TRUE(v8::Isolate::GetCurrent() == nullptr);
             v8::Isolate::Scope scope(isolate1);
             EXPECT_TRUE(v8::Isolate::GetCurrent() == isolate1);
@@ -201,99 +204,31 @@ TEST_F(Environment, isolate_data) {
     delete data;
 }
 
-class ModuleResolutionData {
-public:
-    ModuleResolutionData(v8::Isolate *_isolate, v8::Local<v8::Module> _module, v8::Local<v8::Promise::Resolver> _resolver) {
-        isolate = _isolate;
-        module.Reset(_isolate, _module);
-        resolver.Reset(_isolate, _resolver);
-    };
-    v8::Global<v8::Module> module;
-    v8::Global<v8::Promise::Resolver> resolver;
-    v8::Isolate *isolate;
-    ~ModuleResolutionData() {
-        module.SetWeak();
-        resolver.SetWeak();
+/**
+ * 读取被动态导入的模块源码，在线程池中调用
+ * @param path
+ * @param source
+ * @return
+ */
+static bool readDynamicModule(const std::string &path, std::string &source) {
+    if (path != "/liebao.cn/second.js") {
+        return false;
     }
-};
+    source = "export const fun = function () {\n"
+             "  return 1;\n"
+             "}\n";
+    return true;
+}
 
 TEST_F(Environment, dynamicallyImport) {
     // 设置允许顶层await v8 9.0版本需要需要 flags 启动
     v8::V8::SetFlagsFromString("--harmony-top-level-await");
     v8::Isolate *isolate = getIsolate();
-    isolate->SetMicrotasksPolicy(v8::MicrotasksPolicy::kExplicit);
     v8::Locker locker(isolate);
     {
-        // 请求  import('xxx.js')执行的回调，由嵌入式应用提供回调
-        isolate->SetHostImportModuleDynamicallyCallback(
-                [](v8::Local<v8::Context> context,
-                   v8::Local<v8::ScriptOrModule> referrer,
-                   v8::Local<v8::String> specifier,
-                   v8::Local<v8::FixedArray> import_assertions) -> v8::MaybeLocal<v8::Promise> {
-                    // 获取该上下文的隔离实例
-                    v8::Isolate *isolate = context->GetIsolate();
-                    v8::Locker locker(isolate);
-
-                    // v8::Local<v8::ScriptOrModule> referrer 为引用的模块，在这里为index。js
-                    // v8::Local<v8::String> specifier, 为请求的模块名称
-                    EXPECT_TRUE(specifier->StringEquals(v8::String::NewFromUtf8Literal(isolate, "https://liebao.cn/second.js")));
-                    EXPECT_TRUE(referrer->GetResourceName().As<v8::String>()->StringEquals(
-                            v8::String::NewFromUtf8Literal(isolate, "https://liebao.cn/index.js")));
-                    // 创建 promise
-                    v8::Local<v8::Promise::Resolver> resolver = v8::Promise::Resolver::New(context).ToLocalChecked();
-                    const char *scriptSource = "export const fun = function () {\n"
-                                               "  return 1;\n"
-                                               "}\n";
-                    // 脚本编译需要的编译条件。
-                    v8::ScriptOrigin origin(
-                            isolate, specifier,
-                            0, 0, false, -1, v8::Local<v8::Value>(), false, false, true);
-                    v8::ScriptCompiler::Source source(
-                            v8::String::NewFromUtf8(isolate, scriptSource).ToLocalChecked(),
-                            origin);
-                    // 把脚本作为模块去编译
-                    v8::Local<v8::Module> module =
-                            v8::ScriptCompiler::CompileModule(
-                                    isolate, &source,
-                                    v8::ScriptCompiler::CompileOptions::kNoCompileOptions,
-                                    v8::ScriptCompiler::NoCacheReason::kNoCacheNoReason)
-                                    .ToLocalChecked();
-                    // 实例化模块
-                    module->InstantiateModule(
-                                  context,
-                                  [](v8::Local<v8::Context> context, v8::Local<v8::String> specifier,
-                                     v8::Local<v8::FixedArray> import_assertions,
-                                     v8::Local<v8::Module> referrer) -> v8::MaybeLocal<v8::Module> {
-                                      return v8::MaybeLocal<v8::Module>();
-                                  })
-                            .FromJust();
-                    v8::Local<v8::Value> result = module->Evaluate(context).ToLocalChecked();
-                    // 执行事件循环
-                    isolate->PerformMicrotaskCheckpoint();
-
-                    EXPECT_TRUE(result->IsPromise());
-
-                    ModuleResolutionData *moduleResolutionData = new ModuleResolutionData(isolate, module, resolver);
-                    // 外部扩展。用于把 c++指针包装成句柄
-                    v8::Local<v8::External> external = v8::External::New(isolate, moduleResolutionData);
-                    // 设置Promise 回调
-                    result.As<v8::Promise>()->Then(context, v8::Function::New(
-                                                                    context, [](const v8::FunctionCallbackInfo<v8::Value> &info) -> void {
-                                                                        v8::Isolate *isolate = info.GetIsolate();
-                                                                        v8::HandleScope handleScope(isolate);
-                                                                        // 把ModuleResolutionData 指针转换成 std::unique_ptr指针。在析构函数中把全局句柄变量 setWeak。可以让gc回收。
-                                                                        std::unique_ptr<ModuleResolutionData> moduleResolutionData(static_cast<ModuleResolutionData *>(info.Data().As<v8::External>()->Value()));
-                                                                        v8::Local<v8::Module> module = moduleResolutionData->module.Get(isolate);
-                                                                        v8::Local<v8::Promise::Resolver> resolver = moduleResolutionData->resolver.Get(isolate);
-                                                                        resolver->Resolve(isolate->GetCurrentContext(), module->GetModuleNamespace()).FromJust();
-                                                                    },
-                                                                    external)
-                                                                    .ToLocalChecked())
-                            .ToLocalChecked();
-
-                    isolate->PerformMicrotaskCheckpoint();
-                    return resolver->GetPromise();
-                });
+        // 请求  import('xxx.js')执行的回调，由嵌入式应用提供回调。
+        // 回调立即返回待定的 promise，模块在线程池中读取和编译，完成后由事件循环兑现
+        isolate->SetHostImportModuleDynamicallyCallback(DynamicImportLoader::ImportModuleDynamically);
 
         // 获取模块元信息回调
         isolate->SetHostInitializeImportMetaObjectCallback(
@@ -324,14 +259,20 @@ TEST_F(Environment, dynamicallyImport) {
                                                                                                  }).ToLocalChecked())
                 .FromJust();
 
-        const char *scriptSource = "const { fun } = await import('https://liebao.cn/second.js');\n"
+        // 模块表和动态导入加载器保存在上下文中，事件循环负责执行完成回调和微任务
+        ModuleMap moduleMap(context, "/liebao.cn");
+        EventLoop loop(isolate, g_default_platform);
+        DynamicImportLoader loader(context, &moduleMap, &loop, readDynamicModule);
+
+        const char *scriptSource = "const { fun } = await import('./second.js');\n"
                                    "const result = fun();\n"
                                    "printMetaUrl(import.meta.url);\n"
-                                   "print(result);\n";
+                                   "print(result);\n"
+                                   "globalThis.done = true;\n";
 
         // 脚本元信息
         v8::ScriptOrigin origin(
-                isolate, v8::String::NewFromUtf8Literal(isolate, "https://liebao.cn/index.js"),
+                isolate, v8::String::NewFromUtf8Literal(isolate, "/liebao.cn/index.js"),
                 0, 0, false, -1, v8::Local<v8::Value>(), false, false, true);
         // 脚本
         v8::ScriptCompiler::Source source(
@@ -345,19 +286,17 @@ TEST_F(Environment, dynamicallyImport) {
                                                v8::ScriptCompiler::CompileOptions::kNoCompileOptions,
                                                v8::ScriptCompiler::NoCacheReason::kNoCacheNoReason)
                                                .ToLocalChecked();
+        moduleMap.insert("/liebao.cn/index.js", module);
         // 实例化模块
-        module->InstantiateModule(
-                      context,
-                      [](v8::Local<v8::Context> context, v8::Local<v8::String> specifier,
-                         v8::Local<v8::FixedArray> import_assertions,
-                         v8::Local<v8::Module> referrer) -> v8::MaybeLocal<v8::Module> {
-                          return {};
-                      })
-                .FromJust();
-        // 执行模块;
+        module->InstantiateModule(context, ModuleMap::ResolveCallback).FromJust();
+        // 执行模块，import() 在这里只返回待定的 promise
         module->Evaluate(context).ToLocalChecked();
-        // 执行微任务队列
-        isolate->PerformMicrotaskCheckpoint();
+        EXPECT_EQ(loader.getInFlightCount(), 1);
+        // 运行事件循环直到模块加载完成，模块的剩余部分在微任务中执行
+        loop.run();
+        EXPECT_FALSE(tryCatch.HasCaught());
+        EXPECT_TRUE(context->Global()->Get(context, v8::String::NewFromUtf8Literal(isolate, "done")).ToLocalChecked()->IsTrue());
+        EXPECT_TRUE(moduleMap.contains("/liebao.cn/second.js"));
     }
 }
 
@@ -405,8 +344,9 @@ TEST_F(Environment, Microtask) {
     int microtasksCompleteCount = 0;
     v8::Isolate *isolate = getIsolate();
     v8::Locker locker(isolate);
-    isolate->AddMicrotasksCompletedCallback(
-            [](v8::Isolate *isolate, void *data) -> void {
+    // 隔离实例可能归还到池中复用，回调指向栈上的数据，需要在归还时移除
+    IsolateCallbacks::AddMicrotasksCompletedCallback(
+            isolate, [](v8::Isolate *isolate, void *data) -> void {
                 (*static_cast<int *>(data))++;
             },
             &microtasksCompleteCount);
@@ -447,8 +387,8 @@ TEST_F(Environment, MicrotasksPolicy) {
         (*static_cast<int *>(data))++;
     };
 
-    isolate->AddMicrotasksCompletedCallback(
-            [](v8::Isolate *isolate, void *data) -> void {
+    IsolateCallbacks::AddMicrotasksCompletedCallback(
+            isolate, [](v8::Isolate *isolate, void *data) -> void {
                 (*static_cast<int *>(data))++;
             },
             &microtasksCompleteCount);
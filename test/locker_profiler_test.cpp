@@ -0,0 +1,71 @@
+#include "./base/environment.h"
+#include "./base/lockerProfiler.h"
+#include <cstdio>
+#include <thread>
+
+TEST(locker_profiler_test, histogram) {
+    LockerProfiler::Histogram histogram;
+    EXPECT_EQ(LockerProfiler::Histogram::Bucket(0), 0);
+    EXPECT_EQ(LockerProfiler::Histogram::Bucket(1), 1);
+    EXPECT_EQ(LockerProfiler::Histogram::Bucket(1023), 10);
+    EXPECT_EQ(LockerProfiler::Histogram::Bucket(1024), 11);
+    EXPECT_EQ(LockerProfiler::Histogram::Bucket(UINT64_MAX), LockerProfiler::kBucketCount - 1);
+    for (int i = 0; i < 99; i++) {
+        histogram.record(100);
+    }
+    histogram.record(1000000);
+    EXPECT_EQ(histogram.count, 100);
+    EXPECT_EQ(histogram.maxNanoseconds, 1000000);
+    // 百分位数是所在桶的上界
+    EXPECT_EQ(histogram.percentile(50), 127);
+    EXPECT_EQ(histogram.percentile(100), 1000000);
+}
+
+TEST_F(Environment, locker_profiler_contention) {
+    v8::Isolate *isolate = getIsolate();
+    LockerProfiler *profiler = LockerProfiler::Get();
+    profiler->forget(isolate);
+    bool enabled = LockerProfiler::IsEnabled();
+    LockerProfiler::SetEnabled(true);
+    std::thread thread;
+    {
+        PROFILED_LOCKER(locker, isolate);
+        // 嵌套加锁不统计
+        PROFILED_LOCKER(nested, isolate);
+        thread = std::thread([isolate]() -> void {
+            PROFILED_LOCKER(locker, isolate);
+            v8::Isolate::Scope scope(isolate);
+        });
+        // 持有锁期间另一个线程在等待
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    thread.join();
+    LockerProfiler::SetEnabled(false);
+    {
+        // 关闭后不再统计
+        PROFILED_LOCKER(locker, isolate);
+    }
+    LockerProfiler::SetEnabled(enabled);
+
+    LockerProfiler::IsolateStats stats;
+    ASSERT_TRUE(profiler->getStats(isolate, &stats));
+    EXPECT_EQ(stats.wait.count, 2);
+    EXPECT_GE(stats.hold.maxNanoseconds, 20000000u);
+    EXPECT_GE(stats.wait.maxNanoseconds, 10000000u);
+    // 两个加锁位置分别统计
+    ASSERT_EQ(stats.sites.size(), 2);
+    for (const auto &site : stats.sites) {
+        EXPECT_EQ(site.second.wait.count, 1);
+        EXPECT_STREQ(site.second.file, __FILE__);
+    }
+
+    FILE *out = tmpfile();
+    profiler->dump(out);
+    rewind(out);
+    char line[64] = {};
+    ASSERT_NE(fgets(line, sizeof(line), out), nullptr);
+    EXPECT_EQ(std::string(line).compare(0, 12, "{\"isolate\": "), 0);
+    fclose(out);
+    profiler->forget(isolate);
+    EXPECT_FALSE(profiler->getStats(isolate, &stats));
+}
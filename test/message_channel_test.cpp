@@ -0,0 +1,133 @@
+#include "./base/environment.h"
+#include "./base/messageChannel.h"
+#include <cstring>
+#include <thread>
+
+TEST(spsc_queue_test, push_pop) {
+    SpscQueue<int> queue(3);
+    EXPECT_EQ(queue.capacity(), 4);
+    for (int i = 0; i < 4; i++) {
+        EXPECT_TRUE(queue.push(i));
+    }
+    int value = 4;
+    EXPECT_TRUE(queue.full());
+    EXPECT_FALSE(queue.push(value));
+    EXPECT_EQ(value, 4);
+    for (int i = 0; i < 4; i++) {
+        ASSERT_TRUE(queue.pop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_FALSE(queue.pop(value));
+    EXPECT_EQ(queue.size(), 0);
+}
+
+TEST(spsc_queue_test, two_threads) {
+    const int count = 100000;
+    SpscQueue<int> queue(64);
+    std::thread producer([&queue]() -> void {
+        for (int i = 0; i < count; i++) {
+            int value = i;
+            while (!queue.push(value)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+    // 消费者按顺序收到所有元素
+    int expected = 0;
+    while (expected < count) {
+        int value;
+        if (!queue.pop(value)) {
+            std::this_thread::yield();
+            continue;
+        }
+        ASSERT_EQ(value, expected);
+        expected++;
+    }
+    producer.join();
+}
+
+TEST_F(Environment, message_channel_transfer) {
+    // 接收方隔离实例，与当前隔离实例在同一个线程上交替使用
+    v8::Isolate::CreateParams createParams;
+    std::unique_ptr<v8::ArrayBuffer::Allocator> allocator(v8::ArrayBuffer::Allocator::NewDefaultAllocator());
+    createParams.array_buffer_allocator = allocator.get();
+    v8::Isolate *receiver = v8::Isolate::New(createParams);
+    MessageChannel channel(4);
+    const size_t size = 1024 * 1024;
+    void *transferredData = nullptr;
+    void *sharedData = nullptr;
+    {
+        v8::Isolate *isolate = getIsolate();
+        v8::HandleScope handleScope(isolate);
+        v8::Local<v8::Context> context = v8::Context::New(isolate);
+        v8::Context::Scope context_scope(context);
+        const char *source = "globalThis.buffer = new ArrayBuffer(1024 * 1024);\n"
+                             "new Uint8Array(buffer)[0] = 7;\n"
+                             "globalThis.shared = new SharedArrayBuffer(16);\n"
+                             "({ name: 'payload', buffer, view: new Uint8Array(buffer, 8, 8), shared, again: shared });";
+        v8::Local<v8::Value> value = v8::Script::Compile(context, v8::String::NewFromUtf8(isolate, source).ToLocalChecked()).ToLocalChecked()->Run(context).ToLocalChecked();
+        v8::Local<v8::ArrayBuffer> buffer = context->Global()->Get(context, v8::String::NewFromUtf8Literal(isolate, "buffer")).ToLocalChecked().As<v8::ArrayBuffer>();
+        v8::Local<v8::SharedArrayBuffer> shared = context->Global()->Get(context, v8::String::NewFromUtf8Literal(isolate, "shared")).ToLocalChecked().As<v8::SharedArrayBuffer>();
+        transferredData = buffer->GetBackingStore()->Data();
+        sharedData = shared->GetBackingStore()->Data();
+        EXPECT_TRUE(channel.getPort1()->postMessage(context, value, {buffer}).FromJust());
+        // 转移后发送方的 ArrayBuffer 被分离
+        EXPECT_EQ(buffer->ByteLength(), 0);
+        EXPECT_EQ(channel.getPort1()->getZeroCopyBytes(), size + 16);
+
+        // 不能转移两次，也不能序列化函数
+        v8::TryCatch tryCatch(isolate);
+        EXPECT_TRUE(channel.getPort1()->postMessage(context, v8::Object::New(isolate), {buffer, buffer}).IsNothing());
+        EXPECT_TRUE(tryCatch.HasCaught());
+        tryCatch.Reset();
+        EXPECT_TRUE(channel.getPort1()->postMessage(context, context->Global()->Get(context, v8::String::NewFromUtf8Literal(isolate, "Object")).ToLocalChecked()).IsNothing());
+        EXPECT_TRUE(tryCatch.HasCaught());
+        EXPECT_EQ(channel.getPort1()->getSentCount(), 1);
+    }
+    {
+        v8::Isolate::Scope isolateScope(receiver);
+        v8::HandleScope handleScope(receiver);
+        v8::Local<v8::Context> context = v8::Context::New(receiver);
+        v8::Context::Scope context_scope(context);
+        ASSERT_TRUE(channel.getPort2()->hasMessage());
+        v8::Local<v8::Value> value = channel.getPort2()->receiveMessage(context).ToLocalChecked();
+        EXPECT_FALSE(channel.getPort2()->hasMessage());
+        context->Global()->Set(context, v8::String::NewFromUtf8Literal(receiver, "message"), value).Check();
+        const char *source = "new Uint8Array(message.shared)[0] = 9;\n"
+                             "[message.name, message.buffer.byteLength, new Uint8Array(message.buffer)[0],\n"
+                             " message.view.buffer === message.buffer, message.shared === message.again].join()";
+        v8::Local<v8::Value> result = v8::Script::Compile(context, v8::String::NewFromUtf8(receiver, source).ToLocalChecked()).ToLocalChecked()->Run(context).ToLocalChecked();
+        v8::String::Utf8Value utf8(receiver, result);
+        EXPECT_STREQ(*utf8, "payload,1048576,7,true,true");
+        // 接收方的对象直接使用发送方的内存
+        v8::Local<v8::Object> message = value.As<v8::Object>();
+        v8::Local<v8::ArrayBuffer> buffer = message->Get(context, v8::String::NewFromUtf8Literal(receiver, "buffer")).ToLocalChecked().As<v8::ArrayBuffer>();
+        v8::Local<v8::SharedArrayBuffer> shared = message->Get(context, v8::String::NewFromUtf8Literal(receiver, "shared")).ToLocalChecked().As<v8::SharedArrayBuffer>();
+        EXPECT_EQ(buffer->GetBackingStore()->Data(), transferredData);
+        EXPECT_EQ(shared->GetBackingStore()->Data(), sharedData);
+        EXPECT_TRUE(channel.getPort2()->receiveMessage(context).IsEmpty());
+    }
+    // 接收方写入的共享内存对发送方可见
+    EXPECT_EQ(static_cast<uint8_t *>(sharedData)[0], 9);
+    receiver->Dispose();
+}
+
+TEST_F(Environment, message_channel_back_pressure) {
+    v8::Isolate *isolate = getIsolate();
+    v8::HandleScope handleScope(isolate);
+    v8::Local<v8::Context> context = v8::Context::New(isolate);
+    v8::Context::Scope context_scope(context);
+    MessageChannel channel(2);
+    v8::Local<v8::ArrayBuffer> buffer = v8::ArrayBuffer::New(isolate, 16);
+    EXPECT_TRUE(channel.getPort1()->postMessage(context, v8::Number::New(isolate, 1)).FromJust());
+    EXPECT_TRUE(channel.getPort1()->postMessage(context, v8::Number::New(isolate, 2)).FromJust());
+    // 队列满时不发送，也不分离转移的缓冲区
+    EXPECT_FALSE(channel.getPort1()->postMessage(context, buffer, {buffer}).FromJust());
+    EXPECT_EQ(buffer->ByteLength(), 16);
+    EXPECT_EQ(channel.getPort2()->receiveMessage(context).ToLocalChecked().As<v8::Number>()->Value(), 1);
+    EXPECT_TRUE(channel.getPort1()->postMessage(context, buffer, {buffer}).FromJust());
+    EXPECT_EQ(buffer->ByteLength(), 0);
+    // 两个方向互不影响
+    EXPECT_TRUE(channel.getPort2()->postMessage(context, v8::Number::New(isolate, 3)).FromJust());
+    EXPECT_EQ(channel.getPort1()->receiveMessage(context).ToLocalChecked().As<v8::Number>()->Value(), 3);
+}
@@ -0,0 +1,118 @@
+#include "./base/dynamicImportLoader.h"
+#include "./base/environment.h"
+#include "./base/moduleArchive.h"
+#include <cstdio>
+#include <fstream>
+
+static const char *kArchivePath = "module_archive_test.pack";
+
+/**
+ * 打包一个包含单字节和双字节源码的归档
+ * @param isolate 不为空时生成代码缓存
+ */
+static void writeArchive(v8::Isolate *isolate) {
+    ModuleArchive::Builder builder;
+    EXPECT_TRUE(builder.add("/main.js", "import { greeting } from './lib/greeting.js';\n"
+                                        "import { base } from './lib/base.js';\n"
+                                        "globalThis.result = greeting + base;\n"));
+    EXPECT_TRUE(builder.add("/lib/greeting.js", "\xEF\xBB\xBF"
+                                                "export const greeting = '你好';\n"));
+    EXPECT_TRUE(builder.add("/lib/base.js", "export const base = 42;\n"));
+    EXPECT_TRUE(builder.add("/lazy.js", "export const lazy = 'lazy';\n"));
+    // 非法的 UTF-8 不能打包
+    EXPECT_FALSE(builder.add("/broken.js", "export const broken = '\xC3\x28';\n"));
+    EXPECT_EQ(builder.getSize(), 4);
+    ASSERT_TRUE(builder.write(kArchivePath, isolate));
+}
+
+static bool readNothing(const std::string &path, std::string &source) {
+    ADD_FAILURE() << "unexpected read " << path;
+    return false;
+}
+
+TEST_F(Environment, module_archive_load) {
+    v8::Isolate *isolate = getIsolate();
+    v8::HandleScope handleScope(isolate);
+    v8::Local<v8::Context> context = v8::Context::New(isolate);
+    v8::Context::Scope context_scope(context);
+    writeArchive(isolate);
+    std::unique_ptr<ModuleArchive> archive = ModuleArchive::Open(kArchivePath, "/app/");
+    ASSERT_NE(archive, nullptr);
+    EXPECT_EQ(archive->getSize(), 4);
+    EXPECT_EQ(archive->getMountPoint(), "/app");
+    EXPECT_TRUE(archive->contains("/app/lib/base.js"));
+    EXPECT_FALSE(archive->contains("/app/lib/missing.js"));
+    EXPECT_FALSE(archive->contains("/lib/base.js"));
+    EXPECT_FALSE(archive->contains("/application/lib/base.js"));
+
+    // 源码直接引用映射的内存
+    v8::Local<v8::String> base = archive->loadSource(isolate, "/app/lib/base.js").ToLocalChecked();
+    EXPECT_TRUE(base->IsExternalOneByte());
+    v8::Local<v8::String> greeting = archive->loadSource(isolate, "/app/lib/greeting.js").ToLocalChecked();
+    EXPECT_TRUE(greeting->IsExternal());
+    v8::String::Utf8Value greetingValue(isolate, greeting);
+    EXPECT_STREQ(*greetingValue, "export const greeting = '你好';\n");
+
+    ModuleMap moduleMap(context, "/app", [](v8::Isolate *isolate, const std::string &path) -> v8::MaybeLocal<v8::String> {
+        ADD_FAILURE() << "unexpected load " << path;
+        return v8::MaybeLocal<v8::String>();
+    });
+    moduleMap.setArchive(archive.get());
+    v8::Local<v8::Module> module = moduleMap.load("/app/main.js").ToLocalChecked();
+    ASSERT_TRUE(module->InstantiateModule(context, ModuleMap::ResolveCallback).FromJust());
+    module->Evaluate(context).ToLocalChecked();
+    v8::String::Utf8Value result(isolate, context->Global()->Get(context, v8::String::NewFromUtf8Literal(isolate, "result")).ToLocalChecked());
+    EXPECT_STREQ(*result, "你好42");
+    // 每个模块都带有代码缓存
+    EXPECT_EQ(archive->getCacheHitCount() + archive->getCacheRejectCount(), 3);
+
+    // 动态导入也直接从归档加载，不经过线程池读取
+    isolate->SetHostImportModuleDynamicallyCallback(DynamicImportLoader::ImportModuleDynamically);
+    EventLoop loop(isolate, g_default_platform);
+    DynamicImportLoader loader(context, &moduleMap, &loop, readNothing);
+    v8::ScriptOrigin origin(isolate, v8::String::NewFromUtf8Literal(isolate, "/app/main.js"));
+    v8::Script::Compile(context, v8::String::NewFromUtf8Literal(isolate, "import('./lazy.js').then((m) => { globalThis.lazy = m.lazy; });"), &origin)
+            .ToLocalChecked()
+            ->Run(context)
+            .ToLocalChecked();
+    loop.run();
+    v8::String::Utf8Value lazy(isolate, context->Global()->Get(context, v8::String::NewFromUtf8Literal(isolate, "lazy")).ToLocalChecked());
+    EXPECT_STREQ(*lazy, "lazy");
+    EXPECT_EQ(loader.getLoadCount(), 1);
+    archive.reset();
+    // 归档对象析构后，已经创建的外部字符串仍然有效
+    v8::String::Utf8Value baseValue(isolate, base);
+    EXPECT_STREQ(*baseValue, "export const base = 42;\n");
+    std::remove(kArchivePath);
+}
+
+TEST_F(Environment, module_archive_invalid) {
+    writeArchive(nullptr);
+    std::unique_ptr<ModuleArchive> archive = ModuleArchive::Open(kArchivePath, "/");
+    ASSERT_NE(archive, nullptr);
+    // 没有代码缓存时从源码编译
+    v8::Isolate *isolate = getIsolate();
+    v8::HandleScope handleScope(isolate);
+    EXPECT_FALSE(archive->compileModule(isolate, "/lib/base.js").IsEmpty());
+    EXPECT_EQ(archive->getCacheHitCount() + archive->getCacheRejectCount(), 0);
+    archive.reset();
+
+    // 截断的归档：索引指向文件之外
+    std::string content;
+    {
+        std::ifstream in(kArchivePath, std::ios::binary);
+        content.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    {
+        std::ofstream out(kArchivePath, std::ios::binary | std::ios::trunc);
+        out.write(content.data(), static_cast<std::streamsize>(content.size() / 2));
+    }
+    EXPECT_EQ(ModuleArchive::Open(kArchivePath, "/"), nullptr);
+    {
+        std::ofstream out(kArchivePath, std::ios::binary | std::ios::trunc);
+        out << "not an archive";
+    }
+    EXPECT_EQ(ModuleArchive::Open(kArchivePath, "/"), nullptr);
+    EXPECT_EQ(ModuleArchive::Open("module_archive_missing.pack", "/"), nullptr);
+    std::remove(kArchivePath);
+}
@@ -0,0 +1,88 @@
+#include "./base/environment.h"
+#include "./base/moduleGraphLoader.h"
+#include <atomic>
+#include <unordered_map>
+
+static const int kSiblingCount = 32;
+
+/**
+ * 入口模块导入 kSiblingCount 个模块，每个模块都导入 shared.js
+ * @return
+ */
+static const std::unordered_map<std::string, std::string> &graphSources() {
+    static const std::unordered_map<std::string, std::string> sources = []() -> std::unordered_map<std::string, std::string> {
+        std::unordered_map<std::string, std::string> sources;
+        std::string main;
+        std::string sum = "0";
+        for (int i = 0; i < kSiblingCount; i++) {
+            std::string name = "m" + std::to_string(i);
+            main += "import { " + name + " } from './lib/" + name + ".js';\n";
+            sum += " + " + name;
+            sources["/graph/lib/" + name + ".js"] = "import { shared } from './shared.js';\nexport const " + name + " = shared + " + std::to_string(i) + ";\n";
+        }
+        main += "globalThis.result = " + sum + ";\n";
+        sources["/graph/main.js"] = main;
+        sources["/graph/lib/shared.js"] = "export const shared = 1;\n";
+        sources["/graph/broken.js"] = "import { missing } from './missing.js';\n";
+        sources["/graph/syntax.js"] = "import { shared } from './lib/shared.js';\nexport const = ;\n";
+        return sources;
+    }();
+    return sources;
+}
+
+static std::atomic<int> readCount{0};
+
+static bool readGraphSource(const std::string &path, std::string &source) {
+    readCount++;
+    auto it = graphSources().find(path);
+    if (it == graphSources().end()) {
+        return false;
+    }
+    source = it->second;
+    return true;
+}
+
+TEST_F(Environment, module_graph_loader_parallel) {
+    v8::Isolate *isolate = getIsolate();
+    v8::HandleScope handleScope(isolate);
+    v8::Local<v8::Context> context = v8::Context::New(isolate);
+    v8::Context::Scope context_scope(context);
+    readCount = 0;
+    ModuleMap moduleMap(context, "/graph");
+    ThreadPool threadPool(4);
+    ModuleGraphLoader loader(&moduleMap, readGraphSource, &threadPool);
+    v8::Local<v8::Module> module;
+    ASSERT_TRUE(loader.load(context, "/graph/main.js").ToLocal(&module));
+    EXPECT_EQ(module->GetStatus(), v8::Module::kInstantiated);
+    // 每个模块只读取和编译一次
+    EXPECT_EQ(loader.getCompiledCount(), kSiblingCount + 2);
+    EXPECT_EQ(readCount.load(), kSiblingCount + 2);
+    EXPECT_EQ(moduleMap.getSize(), kSiblingCount + 2);
+    module->Evaluate(context).ToLocalChecked();
+    v8::Local<v8::Value> result = context->Global()->Get(context, v8::String::NewFromUtf8Literal(isolate, "result")).ToLocalChecked();
+    EXPECT_EQ(result.As<v8::Number>()->Value(), kSiblingCount + kSiblingCount * (kSiblingCount - 1) / 2);
+    // 已经在模块表中的模块不会重新加载
+    EXPECT_TRUE(loader.load(context, "/graph/main.js").ToLocal(&module));
+    EXPECT_EQ(loader.getCompiledCount(), 0);
+}
+
+TEST_F(Environment, module_graph_loader_error) {
+    v8::Isolate *isolate = getIsolate();
+    v8::HandleScope handleScope(isolate);
+    v8::Local<v8::Context> context = v8::Context::New(isolate);
+    v8::Context::Scope context_scope(context);
+    ModuleMap moduleMap(context, "/graph");
+    ModuleGraphLoader loader(&moduleMap, readGraphSource);
+    {
+        v8::TryCatch tryCatch(isolate);
+        EXPECT_TRUE(loader.load(context, "/graph/broken.js").IsEmpty());
+        EXPECT_TRUE(tryCatch.HasCaught());
+        v8::String::Utf8Value message(isolate, tryCatch.Exception());
+        EXPECT_NE(std::string(*message).find("/graph/missing.js"), std::string::npos);
+    }
+    {
+        v8::TryCatch tryCatch(isolate);
+        EXPECT_TRUE(loader.load(context, "/graph/syntax.js").IsEmpty());
+        EXPECT_TRUE(tryCatch.HasCaught());
+    }
+}
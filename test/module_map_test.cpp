@@ -0,0 +1,71 @@
+#include "./base/environment.h"
+#include "./base/moduleMap.h"
+#include <unordered_map>
+
+/**
+ * 菱形依赖：main 导入 a 和 b，a 和 b 都导入 shared
+ * @param isolate
+ * @param path
+ * @return
+ */
+static v8::MaybeLocal<v8::String> loadDiamond(v8::Isolate *isolate, const std::string &path) {
+    static const std::unordered_map<std::string, const char *> sources = {
+            {"/app/a.js", "import { value } from './lib/shared.js'; export const a = value + 1;"},
+            {"/app/b.js", "import { value } from './lib/shared.js'; export const b = value + 2;"},
+            {"/app/lib/shared.js", "import { base } from '../config.js'; export const value = base * 10;"},
+            {"/app/config.js", "export const base = 1;"},
+    };
+    auto it = sources.find(path);
+    if (it == sources.end()) {
+        return v8::MaybeLocal<v8::String>();
+    }
+    return v8::String::NewFromUtf8(isolate, it->second);
+}
+
+TEST_F(Environment, module_map_resolve) {
+    v8::Isolate *isolate = getIsolate();
+    v8::HandleScope handleScope(isolate);
+    v8::Local<v8::Context> context = v8::Context::New(isolate);
+    ModuleMap moduleMap(context, "/app", loadDiamond);
+    EXPECT_EQ(ModuleMap::FromContext(context), &moduleMap);
+    EXPECT_EQ(moduleMap.resolve("./lib/shared.js", "/app/a.js"), "/app/lib/shared.js");
+    EXPECT_EQ(moduleMap.resolve("../config.js", "/app/lib/shared.js"), "/app/config.js");
+    EXPECT_EQ(moduleMap.resolve("a.js", "/app/lib/shared.js"), "/app/a.js");
+    EXPECT_EQ(moduleMap.resolve("/other/c.js", "/app/a.js"), "/other/c.js");
+}
+
+TEST_F(Environment, module_map_compile_once) {
+    v8::Isolate *isolate = getIsolate();
+    v8::HandleScope handleScope(isolate);
+    v8::Local<v8::Context> context = v8::Context::New(isolate);
+    v8::Context::Scope context_scope(context);
+    ModuleMap moduleMap(context, "/app", loadDiamond);
+    v8::ScriptOrigin origin(isolate, v8::String::NewFromUtf8Literal(isolate, "/app/main.js"), 0, 0, false, -1, v8::Local<v8::Value>(), false, false, true);
+    v8::ScriptCompiler::Source source(v8::String::NewFromUtf8Literal(isolate, "import { a } from './a.js'; import { b } from './b.js'; globalThis.result = a + b;"), origin);
+    v8::Local<v8::Module> module = v8::ScriptCompiler::CompileModule(isolate, &source).ToLocalChecked();
+    EXPECT_TRUE(moduleMap.insert("/app/main.js", module));
+    EXPECT_FALSE(moduleMap.insert("/app/main.js", module));
+    EXPECT_TRUE(module->InstantiateModule(context, ModuleMap::ResolveCallback).FromJust());
+    module->Evaluate(context).ToLocalChecked();
+    v8::Local<v8::Value> result = context->Global()->Get(context, v8::String::NewFromUtf8Literal(isolate, "result")).ToLocalChecked();
+    EXPECT_EQ(result.As<v8::Number>()->Value(), 23);
+    // 每个模块只编译一次，被多次导入的 shared.js 命中缓存
+    EXPECT_EQ(moduleMap.getSize(), 5);
+    EXPECT_EQ(moduleMap.getMissCount(), 4);
+    EXPECT_GE(moduleMap.getHitCount(), 1);
+    v8::Local<v8::Module> shared;
+    EXPECT_TRUE(moduleMap.get("/app/lib/shared.js").ToLocal(&shared));
+    EXPECT_EQ(moduleMap.getPath(shared), "/app/lib/shared.js");
+    EXPECT_EQ(moduleMap.getPath(module), "/app/main.js");
+}
+
+TEST_F(Environment, module_map_not_found) {
+    v8::Isolate *isolate = getIsolate();
+    v8::HandleScope handleScope(isolate);
+    v8::Local<v8::Context> context = v8::Context::New(isolate);
+    v8::Context::Scope context_scope(context);
+    ModuleMap moduleMap(context, "/app", loadDiamond);
+    v8::TryCatch tryCatch(isolate);
+    EXPECT_TRUE(moduleMap.load("/app/missing.js").IsEmpty());
+    EXPECT_TRUE(tryCatch.HasCaught());
+}
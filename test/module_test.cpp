@@ -1,4 +1,7 @@
+#include "./base/codeCache.h"
+#include "./base/commonJsLoader.h"
 #include "./base/environment.h"
+#include "./base/moduleMap.h"
 #include "libplatform/libplatform.h"
 #include <iostream>
 
@@ -23,65 +26,47 @@ TEST_F(Environment, module_classic_test) {
 }
 
 
-void module(v8::Local<v8::Object> exports) {
-    v8::Isolate *isolate = v8::Isolate::GetCurrent();
-    v8::Local<v8::Context> context = isolate->GetCurrentContext();
-    // 设置 add函数
-    exports->Set(context, v8::String::NewFromUtf8Literal(isolate, "add"),
-                 v8::Function::New(context, [](const v8::FunctionCallbackInfo<v8::Value> &info) -> void {
-                     v8::Isolate *isolate = info.GetIsolate();
-                     // 参数校验
-                     if (info.Length() != 2 || !info[0]->IsNumber() && !info[1]->IsNumber()) {
-                         isolate->ThrowException(v8::String::NewFromUtf8Literal(isolate, "参数错误"));
-                         return;
-                     }
-                     double first = info[0].As<v8::Number>()->Value();
-                     double second = info[1].As<v8::Number>()->Value();
-                     double result = first + second;
-                     info.GetReturnValue().Set(v8::Number::New(isolate, result));
-                 }).ToLocalChecked())
-            .FromJust();
-    // 设置属性result = 1;
-    exports->Set(context, v8::String::NewFromUtf8Literal(isolate, "result"), v8::Number::New(isolate, 1)).FromJust();
-}
-
 TEST_F(Environment, module_commonjs_test) {
     v8::Isolate *isolate = getIsolate();
     v8::HandleScope handleScope(isolate);
     v8::Local<v8::Context> context = v8::Context::New(isolate);
     v8::Context::Scope context_scope(context);
-    v8::Local<v8::Object> exports = v8::Object::New(isolate);
-    module(exports);
-    // 获取moudle函数执行暴露的变量和函数
+    // 模块源码包装成函数执行，exports 上的属性就是模块暴露的变量和函数
+    CommonJsLoader loader(context);
+    v8::Local<v8::Object> exports = loader.require("./source/commonjs/lib/math.js", Environment::GetWorkingDirectory()).ToLocalChecked().As<v8::Object>();
+    // 获取模块暴露的变量和函数
     v8::Local<v8::Function> add = exports->Get(context, v8::String::NewFromUtf8Literal(isolate, "add")).ToLocalChecked().As<v8::Function>();
     v8::Local<v8::Number> result = exports->Get(context, v8::String::NewFromUtf8Literal(isolate, "result")).ToLocalChecked().As<v8::Number>();
     v8::Local<v8::Value> argv[] = {v8::Number::New(isolate, 1), result};
     EXPECT_TRUE(add->Call(context, context->Global(), 2, argv).ToLocalChecked().As<v8::Number>()->Value() == 2);
 };
 
-v8::MaybeLocal<v8::Module> resolveModule(v8::Local<v8::Context> context, v8::Local<v8::String> specifier,
-                                         v8::Local<v8::FixedArray> import_assertions, v8::Local<v8::Module> referrer) {
-    v8::Isolate *isolate = context->GetIsolate();
+/**
+ * 模块编译结果缓存在磁盘上，下一次运行直接反序列化。
+ * 第一次使用时才创建缓存目录，没有运行模块测试时不会创建
+ * @return
+ */
+static CodeCache *getModuleCodeCache() {
+    static CodeCache codeCache("./code_cache");
+    return &codeCache;
+}
 
+/**
+ * 加载模块源码，模块路径已经由模块表解析为绝对路径
+ * @param isolate
+ * @param path
+ * @return
+ */
+v8::MaybeLocal<v8::String> loadModuleSource(v8::Isolate *isolate, const std::string &path) {
     // 判断是请求加载那个模块
-    if (specifier->StrictEquals(
-                v8::String::NewFromUtf8Literal(isolate, "foo.js"))) {
-        const char *scriptSource = " export const add = function (first, second) {\n"
-                                   "    return first + second;\n"
-                                   "};\n";
-        v8::ScriptOrigin origin(v8::String::NewFromUtf8Literal(isolate, "foo.js"), 0, 0, false, -1, v8::Local<v8::Value>(), false, false, true);
-        v8::ScriptCompiler::Source source(v8::String::NewFromUtf8(isolate, scriptSource).ToLocalChecked(), origin);
-        v8::Local<v8::Module> module = v8::ScriptCompiler::CompileModule(isolate, &source).ToLocalChecked();
-        module->InstantiateModule(context, resolveModule).FromJust();
-        return module;
-    } else {
-        const char *scriptSource = " export const result = 1;";
-        v8::ScriptOrigin origin(v8::String::NewFromUtf8Literal(isolate, "bar.js"), 0, 0, false, -1, v8::Local<v8::Value>(), false, false, true);
-        v8::ScriptCompiler::Source source(v8::String::NewFromUtf8(isolate, scriptSource).ToLocalChecked(), origin);
-        v8::Local<v8::Module> module = v8::ScriptCompiler::CompileModule(isolate, &source).ToLocalChecked();
-        module->InstantiateModule(context, resolveModule).FromJust();
-        return module;
+    if (path == "/foo.js") {
+        return v8::String::NewFromUtf8Literal(isolate, " export const add = function (first, second) {\n"
+                                                       "    return first + second;\n"
+                                                       "};\n");
+    } else if (path == "/bar.js") {
+        return v8::String::NewFromUtf8Literal(isolate, " export const result = 1;");
     }
+    return v8::MaybeLocal<v8::String>();
 }
 
 
@@ -90,17 +75,20 @@ TEST_F(Environment, module_esmodule_test) {
     v8::HandleScope handleScope(isolate);
     v8::Local<v8::Context> context = v8::Context::New(isolate);
     v8::Context::Scope context_scope(context);
+    // 模块表保存在上下文中，依赖的模块只编译一次
+    CodeCache *moduleCodeCache = getModuleCodeCache();
+    ModuleMap moduleMap(context, "/", loadModuleSource, moduleCodeCache);
     const char *scriptSource = "import { add } from 'foo.js';\n"
                                "import { result } from 'bar.js';\n"
                                "add(result, 1);\n";
     // 构建编译条件
     v8::ScriptOrigin origin(v8::String::NewFromUtf8Literal(isolate, "main.js"), 1, 0, false, -1, v8::Local<v8::Value>(), false, false, true);
-    // 构建编译source
-    v8::ScriptCompiler::Source source(v8::String::NewFromUtf8(isolate, scriptSource).ToLocalChecked(), origin);
     // 编译模块
-    v8::Local<v8::Module> module = v8::ScriptCompiler::CompileModule(isolate, &source).ToLocalChecked();
-    // 实例化模块
-    module->InstantiateModule(context, resolveModule).FromJust();
+    v8::Local<v8::Module> module = moduleCodeCache->compileModule(isolate, v8::String::NewFromUtf8(isolate, scriptSource).ToLocalChecked(), origin).ToLocalChecked();
+    moduleMap.insert("/main.js", module);
+    // 实例化模块，依赖的模块通过模块表解析
+    module->InstantiateModule(context, ModuleMap::ResolveCallback).FromJust();
     // 执行模块
     module->Evaluate(context).ToLocalChecked();
+    EXPECT_EQ(moduleMap.getSize(), 3);
 }
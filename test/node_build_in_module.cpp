@@ -1,158 +1,19 @@
+#include "./base/embedderData.h"
 #include "./base/environment.h"
+#include "./base/nodeBuildInModule.h"
 #include "libplatform/libplatform.h"
 #include "v8.h"
 #include <algorithm>
 #include <functional>
 #include <string>
 
-/**
- * 模块结构体
- */
-class NodeModule {
-public:
-    // 模块名称
-    std::string nodeModuleName;
-    // 模块注册函数
-    std::function<void(v8::Local<v8::Context> context,
-                       v8::Local<v8::Object> module,
-                       v8::Local<v8::Object> exports,
-                       v8::Local<v8::Function> require)>
-            nodeModuleRegisterFun;
-    NodeModule *front = nullptr;
-    // 模块的导出数据
-    v8::MaybeLocal<v8::Object> exports = v8::MaybeLocal<v8::Object>();
-};
-
-
-// 保存着最后一个内建模块的
-static NodeModule *buildInNodeModule = nullptr;
-
-/**
- * 获取内建模块的函数，
- * @param info
- */
-void internalBinding(const v8::FunctionCallbackInfo<v8::Value> &info) {
-    v8::Isolate *isolate = v8::Isolate::GetCurrent();
-    v8::Local<v8::Context> context = isolate->GetCurrentContext();
-    std::string moduleName(*v8::String::Utf8Value(isolate, info[0].As<v8::String>()));
-    NodeModule *nodeModule = buildInNodeModule;
-
-    // 遍历内建模块链表，根据模块名称获取模块
-    while (nodeModule != nullptr) {
-        if (nodeModule->nodeModuleName == moduleName) {
-            // 如果模块已经加载过。直接从缓存取
-            if (!nodeModule->exports.IsEmpty()) {
-                info.GetReturnValue().Set(nodeModule->exports.ToLocalChecked());
-            }
-            v8::Local<v8::Object> module = v8::Object::New(isolate);
-            v8::Local<v8::Object> exports = v8::Object::New(isolate);
-            EXPECT_TRUE(module->Set(context, v8::String::NewFromUtf8Literal(isolate, "exports"), exports).FromJust());
-            // 调用注册函数
-            nodeModule->nodeModuleRegisterFun(context, module, exports, v8::Function::New(context, internalBinding).ToLocalChecked());
-            // 导出 module对象的exports熟悉值
-            info.GetReturnValue().Set(module->Get(context, v8::String::NewFromUtf8Literal(isolate, "exports")).ToLocalChecked());
-            return;
-        }
-        nodeModule = nodeModule->front;
-    }
-    // 如果没有找到，返回null
-    info.GetReturnValue().SetNull();
-}
-
-/**
- * 清空内建模块的链表
- */
-void clearBuildInNodeModule() {
-    while (buildInNodeModule != nullptr) {
-        NodeModule *nodeModule = buildInNodeModule;
-        buildInNodeModule = buildInNodeModule->front;
-        delete nodeModule;
-    }
-}
-
-/**
- * 内建模块的注册函数
- * @param nodeModuleName
- * @param nodeModuleRegisterFun
- */
-void buildInNodeModuleRegister(std::string nodeModuleName, void (*nodeModuleRegisterFun)(v8::Local<v8::Context> context,
-                                                                                         v8::Local<v8::Object> module,
-                                                                                         v8::Local<v8::Object> exports,
-                                                                                         v8::Local<v8::Function> require)) {
-    NodeModule *nodeModule = new NodeModule();
-    nodeModule->nodeModuleName = std::move(nodeModuleName);
-    nodeModule->nodeModuleRegisterFun = nodeModuleRegisterFun;
-    // 保存上一个nodeModule到当前的模块下
-    nodeModule->front = buildInNodeModule;
-    // 更新最后一个模块
-    buildInNodeModule = nodeModule;
-}
-
-/**
- * 工具模块
- * @param context
- * @param module
- * @param exports
- * @param require
- */
-void fooBuildInModule(v8::Local<v8::Context> context,
-                      v8::Local<v8::Object> module,
-                      v8::Local<v8::Object> exports,
-                      v8::Local<v8::Function> require) {
-    v8::Isolate *isolate = context->GetIsolate();
-    v8::HandleScope handleScope(isolate);
-    // 导出加法函数
-    EXPECT_TRUE(exports->Set(context, v8::String::NewFromUtf8Literal(isolate, "add"), v8::Function::New(context, [](const v8::FunctionCallbackInfo<v8::Value> &info) -> void {
-                                                                                          double first = info[0].As<v8::Number>()->Value();
-                                                                                          double second = info[1].As<v8::Number>()->Value();
-                                                                                          info.GetReturnValue().Set(first + second);
-                                                                                      }).ToLocalChecked())
-                        .FromJust());
-    EXPECT_TRUE(exports->Set(context, v8::String::NewFromUtf8Literal(isolate, "result"), v8::Number::New(isolate, 1)).FromJust());
-}
-
-/**
- * 内建bar模块
- * @param context
- * @param module
- * @param exports
- * @param require
- */
-void barBuildInModule(v8::Local<v8::Context> context,
-                      v8::Local<v8::Object> module,
-                      v8::Local<v8::Object> exports,
-                      v8::Local<v8::Function> require) {
-    v8::Isolate *isolate = context->GetIsolate();
-    v8::HandleScope handleScope(isolate);
-    // 乘法函数
-    EXPECT_TRUE(exports->Set(context, v8::String::NewFromUtf8Literal(isolate, "mul"),
-                             v8::Function::New(context, [](const v8::FunctionCallbackInfo<v8::Value> &info) -> void {
-                                 double first = info[0].As<v8::Number>()->Value();
-                                 double second = info[1].As<v8::Number>()->Value();
-                                 info.GetReturnValue().Set(first * second);
-                             }).ToLocalChecked())
-                        .FromJust());
-
-    v8::Local<v8::Value> argv[] = {v8::String::NewFromUtf8Literal(isolate, "foo")};
-    // 调用foo模块
-    v8::Local<v8::Object> fooModule = require->Call(context, context->Global(), 1, argv).ToLocalChecked().As<v8::Object>();
-    // 把模块foo模块的属性值result设置到bar的属性params上
-    EXPECT_TRUE(exports->Set(context, v8::String::NewFromUtf8Literal(isolate, "params"),
-                             fooModule->Get(context, v8::String::NewFromUtf8Literal(isolate, "result")).ToLocalChecked())
-                        .FromJust());
-}
-
-
 TEST_F(Environment, node_build_in_module_test) {
     v8::Isolate *isolate = getIsolate();
     v8::HandleScope handleScope(isolate);
     v8::Local<v8::Context> context = v8::Context::New(isolate);
     v8::Context::Scope context_scope(context);
 
-    // 注册内建模块
-    buildInNodeModuleRegister("foo", fooBuildInModule);
-    buildInNodeModuleRegister("bar", barBuildInModule);
-
+    // 内建模块在编译期注册，见 BUILD_IN_MODULE_LIST
     v8::Local<v8::Object> process = v8::Object::New(isolate);
     // 设置 process.binding()函数
     EXPECT_TRUE(process->Set(context, v8::String::NewFromUtf8Literal(isolate, "binding"),
@@ -166,6 +27,60 @@ TEST_F(Environment, node_build_in_module_test) {
     v8::Local<v8::Script> script = v8::Script::Compile(context, v8::String::NewFromUtf8(isolate, source).ToLocalChecked()).ToLocalChecked();
     v8::Local<v8::Value> result = script->Run(context).ToLocalChecked();
     EXPECT_TRUE(result.As<v8::Number>()->Value() == 2);
-    // 清空所有的内建模块
-    clearBuildInNodeModule();
-}
\ No newline at end of file
+}
+TEST_F(Environment, node_build_in_module_lookup_test) {
+    EXPECT_EQ(std::string(findBuildInNodeModule("foo", 3)->nodeModuleName), "foo");
+    EXPECT_EQ(findBuildInNodeModule("bar", 3)->nodeModuleRegisterFun, barBuildInModule);
+    EXPECT_EQ(findBuildInNodeModule("fo", 2), nullptr);
+    EXPECT_EQ(findBuildInNodeModule("food", 4), nullptr);
+    EXPECT_EQ(findBuildInNodeModule("", 0), nullptr);
+}
+
+TEST_F(Environment, node_build_in_module_cache_test) {
+    v8::Isolate *isolate = getIsolate();
+    v8::HandleScope handleScope(isolate);
+    const char *source = "const first = process.binding('bar');\n"
+                         "const second = process.binding('bar');\n"
+                         "globalThis.foo = process.binding('foo');\n"
+                         "first === second && process.binding('none') === null;";
+    v8::Local<v8::Value> foo[2];
+    void *templates[2];
+    for (int i = 0; i < 2; i++) {
+        v8::Local<v8::Context> context = v8::Context::New(isolate);
+        v8::Context::Scope context_scope(context);
+        v8::Local<v8::Object> process = v8::Object::New(isolate);
+        EXPECT_TRUE(process->Set(context, v8::String::NewFromUtf8Literal(isolate, "binding"),
+                                 v8::Function::New(context, internalBinding).ToLocalChecked())
+                            .FromJust());
+        EXPECT_TRUE(context->Global()->Set(context, v8::String::NewFromUtf8Literal(isolate, "process"), process).FromJust());
+        v8::Local<v8::Script> script = v8::Script::Compile(context, v8::String::NewFromUtf8(isolate, source).ToLocalChecked()).ToLocalChecked();
+        EXPECT_TRUE(script->Run(context).ToLocalChecked()->IsTrue());
+        foo[i] = context->Global()->Get(context, v8::String::NewFromUtf8Literal(isolate, "foo")).ToLocalChecked();
+        templates[i] = isolate->GetData(IsolateDataIndex::kBuildInModuleTemplates);
+    }
+    // 每个上下文有自己的导出对象
+    EXPECT_FALSE(foo[0]->StrictEquals(foo[1]));
+    // 导出模板在隔离实例上只创建一次
+    EXPECT_NE(templates[0], nullptr);
+    EXPECT_EQ(templates[0], templates[1]);
+}
+
+TEST_F(Environment, node_build_in_module_lazy_method_test) {
+    v8::Isolate *isolate = getIsolate();
+    v8::HandleScope handleScope(isolate);
+    v8::Local<v8::Context> context = v8::Context::New(isolate);
+    v8::Context::Scope context_scope(context);
+    v8::Local<v8::Object> process = v8::Object::New(isolate);
+    EXPECT_TRUE(process->Set(context, v8::String::NewFromUtf8Literal(isolate, "binding"),
+                             v8::Function::New(context, internalBinding).ToLocalChecked())
+                        .FromJust());
+    EXPECT_TRUE(context->Global()->Set(context, v8::String::NewFromUtf8Literal(isolate, "process"), process).FromJust());
+    // 函数在第一次访问时创建，之后是普通的数据属性
+    const char *source = "const foo = process.binding('foo');\n"
+                         "const keys = Object.keys(foo).join(',');\n"
+                         "const add = foo.add;\n"
+                         "const descriptor = Object.getOwnPropertyDescriptor(foo, 'add');\n"
+                         "keys === 'add,result' && add === foo.add && add.name === 'add' && descriptor.writable && add(1, 2) === 3;";
+    v8::Local<v8::Script> script = v8::Script::Compile(context, v8::String::NewFromUtf8(isolate, source).ToLocalChecked()).ToLocalChecked();
+    EXPECT_TRUE(script->Run(context).ToLocalChecked()->IsTrue());
+}
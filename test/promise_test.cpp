@@ -1,6 +1,7 @@
 
 #include "./base/abstractAsyncTask.h"
 #include "./base/environment.h"
+#include "./base/eventLoop.h"
 #include "libplatform/libplatform.h"
 #include <iostream>
 #include <thread>
@@ -9,27 +10,33 @@ static unsigned int global_count = 0;
 TEST_F(Environment, async_callback_read_file) {
     global_count = 0;
     v8::Isolate *isolate = getIsolate();
+    EventLoop loop(isolate, g_default_platform);
     {
         v8::HandleScope handleScope(isolate);
         v8::Local<v8::Context> context = v8::Context::New(isolate);
         v8::Context::Scope context_scope(context);
         v8::Local<v8::Function> function = v8::Function::New(context, [](const v8::FunctionCallbackInfo<v8::Value> &info) -> void {
             global_count++;
+            EXPECT_TRUE(info[0]->IsString());
         }).ToLocalChecked();
 
         v8::Global<v8::Context> persistentContext(isolate, context);
         v8::Global<v8::Function> persistentFunction(isolate, function);
 
-        std::thread thread([](v8::Isolate* isolate, v8::Global<v8::Context> persistentContext,
-                              v8::Global<v8::Function> persistentFunction) -> void {
-            v8::Locker locker(isolate);
-            v8::Isolate::Scope scope(isolate);
-            v8::HandleScope handleScope(isolate);
-            v8::Local<v8::Context> context = persistentContext.Get(isolate);
-            v8::Local<v8::Function> callBack = persistentFunction.Get(isolate);
-            callBack->Call(context,v8::Null(isolate), 0 , {}).ToLocalChecked();
-        },isolate, std::move(persistentContext), std::move(persistentFunction));
-        // std::this_thread::sleep_for(std::chrono::seconds(3));
+        // 工作线程只读文件，不加锁执行 js；回调交给事件循环，在隔离实例所在的线程上执行
+        loop.ref();
+        std::thread thread([&loop, &persistentContext, &persistentFunction]() -> void {
+            std::string content = Environment::ReadFile("./source/test_read_file.json");
+            loop.post([&loop, &persistentContext, &persistentFunction, content]() -> void {
+                v8::Isolate *isolate = loop.getIsolate();
+                v8::Local<v8::Context> context = persistentContext.Get(isolate);
+                v8::Context::Scope context_scope(context);
+                v8::Local<v8::Value> argv[] = {v8::String::NewFromUtf8(isolate, content.c_str()).ToLocalChecked()};
+                persistentFunction.Get(isolate)->Call(context, v8::Null(isolate), 1, argv).ToLocalChecked();
+                loop.unref();
+            });
+        });
+        loop.run();
         thread.join();
         EXPECT_EQ(global_count, 1);
     }
@@ -122,26 +129,26 @@ private:
     v8::Persistent<v8::Context> persistentContext;
     v8::Persistent<v8::Promise::Resolver> persistentResolver;
     v8::Isolate *isolate;
+    EventLoop *loop;
 
 public:
-    PromiseAsyncTask(v8::Isolate *isolate, v8::Local<v8::Context> context, v8::Local<v8::Promise::Resolver> resolver) : AbstractAsyncTask() {
-        this->isolate = isolate;
+    PromiseAsyncTask(EventLoop *loop, v8::Local<v8::Context> context, v8::Local<v8::Promise::Resolver> resolver) : AbstractAsyncTask() {
+        this->loop = loop;
+        this->isolate = loop->getIsolate();
         this->persistentContext.Reset(isolate, context);
         this->persistentResolver.Reset(isolate, resolver);
     }
     void run() override {
-        v8::Locker locker(isolate);
-        v8::Isolate::Scope scope(isolate);
-        {
-            v8::HandleScope handleScope(isolate);
+        // 在工作线程上只提交完成回调，兑现 promise 在事件循环线程上进行
+        loop->post([this]() -> void {
             v8::Local<v8::Context> context = persistentContext.Get(isolate);
             v8::Context::Scope context_scope(context);
             v8::Local<v8::Promise::Resolver> resolver = persistentResolver.Get(isolate);
             EXPECT_TRUE(resolver->Resolve(context, v8::Number::New(isolate, 1)).FromJust());
+            // 微任务在 tick 结束时执行
             EXPECT_EQ(global_count, 0);
-            isolate->PerformMicrotaskCheckpoint();
-            EXPECT_EQ(global_count, 1);
-        }
+            loop->unref();
+        });
     }
     ~PromiseAsyncTask() {
         persistentResolver.Reset();
@@ -152,8 +159,8 @@ public:
 TEST_F(Environment, promise_async_resolver) {
     global_count = 0;
     v8::Isolate *isolate = getIsolate();
-    // 设置微任务队列策略为明确执行得
-    isolate->SetMicrotasksPolicy(v8::MicrotasksPolicy::kExplicit);
+    // 事件循环把微任务队列策略设置为明确执行
+    EventLoop loop(isolate, g_default_platform);
     std::unique_ptr<PromiseAsyncTask> promiseAsyncTask;
     {
         v8::HandleScope handleScope(isolate);
@@ -172,9 +179,11 @@ TEST_F(Environment, promise_async_resolver) {
                                            }).ToLocalChecked())
                             .ToLocal(&promise));
         // 异步执行
-        promiseAsyncTask = std::make_unique<PromiseAsyncTask>(isolate, context, resolver);
+        promiseAsyncTask = std::make_unique<PromiseAsyncTask>(&loop, context, resolver);
     }
+    loop.ref();
     promiseAsyncTask->start();
+    loop.run();
     promiseAsyncTask->join();
     EXPECT_EQ(global_count, 1);
 }
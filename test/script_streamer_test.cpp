@@ -0,0 +1,55 @@
+#include "./base/environment.h"
+#include "./base/scriptStreamer.h"
+#include <cstdio>
+#include <fstream>
+
+TEST_F(Environment, script_streamer_compile_chunks) {
+    v8::Isolate *isolate = getIsolate();
+    v8::HandleScope handleScope(isolate);
+    v8::Local<v8::Context> context = v8::Context::New(isolate);
+    v8::Context::Scope context_scope(context);
+    const std::string path = "script_streamer_test.js";
+    std::string body = "function sum() { return '中文'.length; }\n";
+    {
+        std::ofstream out(path.c_str(), std::ios::binary | std::ios::trunc);
+        // 带 BOM 的 UTF-8 文件，超过多个块的大小
+        out << "\xEF\xBB\xBF" << body;
+        for (int i = 0; i < 20000; i++) {
+            out << "var value" << i << " = " << i << "; // 注释\n";
+        }
+        out << "sum() + value19999;\n";
+    }
+    ScriptStreamer streamer(isolate, path);
+    v8::Local<v8::Script> script;
+    ASSERT_TRUE(streamer.finish(context).ToLocal(&script));
+    EXPECT_GT(streamer.getChunkCount(), 1);
+    EXPECT_EQ(script->Run(context).ToLocalChecked().As<v8::Number>()->Value(), 2 + 19999);
+    // 完整源码与流中的内容一致
+    v8::Local<v8::Value> sum = context->Global()->Get(context, v8::String::NewFromUtf8Literal(isolate, "sum")).ToLocalChecked();
+    v8::String::Utf8Value text(isolate, sum.As<v8::Function>()->FunctionProtoToString(context).ToLocalChecked());
+    EXPECT_EQ(std::string(*text) + "\n", body);
+    std::remove(path.c_str());
+}
+
+TEST_F(Environment, script_streamer_error) {
+    v8::Isolate *isolate = getIsolate();
+    v8::HandleScope handleScope(isolate);
+    v8::Local<v8::Context> context = v8::Context::New(isolate);
+    v8::Context::Scope context_scope(context);
+    {
+        v8::TryCatch tryCatch(isolate);
+        EXPECT_TRUE(ScriptStreamer::Compile(context, "script_streamer_missing.js").IsEmpty());
+        EXPECT_TRUE(tryCatch.HasCaught());
+    }
+    const std::string path = "script_streamer_syntax.js";
+    {
+        std::ofstream out(path.c_str(), std::ios::binary | std::ios::trunc);
+        out << "var = ;\n";
+    }
+    {
+        v8::TryCatch tryCatch(isolate);
+        EXPECT_TRUE(ScriptStreamer::Compile(context, path).IsEmpty());
+        EXPECT_TRUE(tryCatch.HasCaught());
+    }
+    std::remove(path.c_str());
+}
@@ -0,0 +1,45 @@
+#include "./base/environment.h"
+#include "./base/builtins.h"
+#include "./base/snapshot.h"
+
+static const char *builtinCheckSource = "typeof process.binding === 'function' &&\n"
+                                        "typeof console.log === 'function' &&\n"
+                                        "typeof print === 'function' &&\n"
+                                        "process.binding('none') === null &&\n"
+                                        "property === 1 && fun() === 2;";
+
+TEST_F(Environment, snapshot_builtin_context) {
+    v8::Isolate *isolate = getIsolate();
+    v8::HandleScope handleScope(isolate);
+    // 有快照时反序列化，没有快照时在运行时安装，两种方式的结果一致
+    v8::Local<v8::Context> context = Snapshot::NewBuiltinContext(isolate);
+    v8::Context::Scope context_scope(context);
+    v8::Local<v8::Value> result = v8::Script::Compile(context, v8::String::NewFromUtf8(isolate, builtinCheckSource).ToLocalChecked()).ToLocalChecked()->Run(context).ToLocalChecked();
+    EXPECT_TRUE(result->IsTrue());
+    // 默认上下文不包含内建对象
+    v8::Local<v8::Context> defaultContext = v8::Context::New(isolate);
+    EXPECT_TRUE(defaultContext->Global()->Get(defaultContext, v8::String::NewFromUtf8Literal(isolate, "process")).ToLocalChecked()->IsUndefined());
+}
+
+TEST(snapshot_test, create_and_boot) {
+    v8::StartupData startupData = Snapshot::Create();
+    ASSERT_TRUE(startupData.data != nullptr);
+    EXPECT_TRUE(startupData.IsValid());
+    v8::Isolate::CreateParams create_params;
+    create_params.snapshot_blob = &startupData;
+    create_params.external_references = Builtins::GetExternalReferences();
+    create_params.array_buffer_allocator = v8::ArrayBuffer::Allocator::NewDefaultAllocator();
+    v8::Isolate *isolate = v8::Isolate::New(create_params);
+    {
+        v8::Isolate::Scope scope(isolate);
+        v8::HandleScope handleScope(isolate);
+        v8::Local<v8::Context> context;
+        EXPECT_TRUE(v8::Context::FromSnapshot(isolate, Snapshot::kBuiltinContextIndex).ToLocal(&context));
+        v8::Context::Scope context_scope(context);
+        v8::Local<v8::Value> result = v8::Script::Compile(context, v8::String::NewFromUtf8(isolate, builtinCheckSource).ToLocalChecked()).ToLocalChecked()->Run(context).ToLocalChecked();
+        EXPECT_TRUE(result->IsTrue());
+    }
+    isolate->Dispose();
+    delete create_params.array_buffer_allocator;
+    delete[] startupData.data;
+}
@@ -0,0 +1,4 @@
+exports.loaded = false;
+const b = require('./b');
+exports.fromB = b.sawLoaded;
+exports.loaded = true;
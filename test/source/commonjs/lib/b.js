@@ -0,0 +1,2 @@
+const a = require('./a');
+exports.sawLoaded = a.loaded;
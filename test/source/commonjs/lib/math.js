@@ -0,0 +1,4 @@
+exports.add = function (first, second) {
+    return first + second;
+};
+exports.result = 1;
@@ -0,0 +1,15 @@
+const math = require('./lib/math');
+const pkg = require('pkg');
+const data = require('./data.json');
+const a = require('./lib/a');
+
+module.exports = {
+    sum: math.add(1, 2),
+    same: require('./lib/math.js') === math,
+    pkg: pkg.name,
+    dep: pkg.dep,
+    value: data.value,
+    cycle: a.fromB,
+    filename: __filename,
+    dirname: __dirname,
+};
@@ -0,0 +1,78 @@
+#include "./base/environment.h"
+#include "./base/sourceFile.h"
+#include <cstdio>
+
+/**
+ * 写入临时文件
+ * @param path
+ * @param content
+ */
+static void writeFile(const std::string &path, const std::string &content) {
+    std::ofstream out(path.c_str(), std::ios::binary | std::ios::trunc);
+    out << content;
+}
+
+TEST_F(Environment, source_file_read_file) {
+    // 读取整个文件，保留换行符
+    std::string source = Environment::ReadFile("./source/test_read_file.json");
+    EXPECT_EQ(source, "{\n  \"params\": 1\n}");
+    EXPECT_EQ(Environment::ReadFile("./source/not_exist.json"), "");
+
+    // 超过 256 个字符的行不会被截断
+    std::string longLine(1000, 'a');
+    writeFile("source_file_long_line.txt", longLine + "\n" + longLine);
+    EXPECT_EQ(Environment::ReadFile("source_file_long_line.txt"), longLine + "\n" + longLine);
+    std::remove("source_file_long_line.txt");
+}
+
+TEST_F(Environment, source_file_load_external_one_byte) {
+    v8::Isolate *isolate = getIsolate();
+    v8::HandleScope handleScope(isolate);
+    v8::Local<v8::Context> context = v8::Context::New(isolate);
+    v8::Context::Scope context_scope(context);
+    std::string source = "var sum = 0;\n";
+    while (source.size() < SourceFile::kExternalThreshold * 2) {
+        source += "sum += 1;\n";
+    }
+    source += "sum;";
+    writeFile("source_file_one_byte.js", source);
+    v8::Local<v8::String> string;
+    EXPECT_TRUE(SourceFile::Load(isolate, "source_file_one_byte.js").ToLocal(&string));
+    // ASCII 源码直接引用映射的内存
+    EXPECT_TRUE(string->IsExternalOneByte());
+    EXPECT_EQ(static_cast<size_t>(string->Length()), source.size());
+    v8::Local<v8::Value> result = v8::Script::Compile(context, string).ToLocalChecked()->Run(context).ToLocalChecked();
+    EXPECT_EQ(result.As<v8::Number>()->Value(), (source.size() - 17) / 10);
+    std::remove("source_file_one_byte.js");
+}
+
+TEST_F(Environment, source_file_load_external_two_byte) {
+    v8::Isolate *isolate = getIsolate();
+    v8::HandleScope handleScope(isolate);
+    v8::Local<v8::Context> context = v8::Context::New(isolate);
+    v8::Context::Scope context_scope(context);
+    std::string source = "\xEF\xBB\xBF// 中文注释\n";
+    while (source.size() < SourceFile::kExternalThreshold * 2) {
+        source += "// 多字节字符 😀\n";
+    }
+    source += "'完成';";
+    writeFile("source_file_two_byte.js", source);
+    v8::Local<v8::String> string;
+    EXPECT_TRUE(SourceFile::Load(isolate, "source_file_two_byte.js").ToLocal(&string));
+    EXPECT_TRUE(string->IsExternalTwoByte());
+    // 去掉 BOM 后和 v8 自己解码的结果一致
+    EXPECT_TRUE(string->StrictEquals(v8::String::NewFromUtf8(isolate, source.data() + 3, v8::NewStringType::kNormal, static_cast<int>(source.size() - 3)).ToLocalChecked()));
+    v8::Local<v8::Value> result = v8::Script::Compile(context, string).ToLocalChecked()->Run(context).ToLocalChecked();
+    EXPECT_TRUE(result->StrictEquals(v8::String::NewFromUtf8Literal(isolate, "完成")));
+    std::remove("source_file_two_byte.js");
+
+    // 文件不存在
+    EXPECT_TRUE(SourceFile::Load(isolate, "source_file_not_exist.js").IsEmpty());
+}
+
+TEST(source_file_test, is_ascii) {
+    EXPECT_TRUE(SourceFile::IsAscii("", 0));
+    EXPECT_TRUE(SourceFile::IsAscii("0123456789abcdef", 16));
+    EXPECT_FALSE(SourceFile::IsAscii("0123456789abcde\x80", 16));
+    EXPECT_FALSE(SourceFile::IsAscii("\xE4\xB8\xAD", 3));
+}
@@ -0,0 +1,163 @@
+#include "./base/environment.h"
+#include "./base/jsonModuleCache.h"
+#include "./base/moduleMap.h"
+#include <thread>
+#include <unordered_map>
+
+static const char *kJsonSource = "{\"params\": 1, \"list\": [1, 2, 3]}";
+
+/**
+ * data.json 和 copy.json 内容相同，bad.json 有语法错误
+ * @param isolate
+ * @param path
+ * @return
+ */
+static v8::MaybeLocal<v8::String> loadJson(v8::Isolate *isolate, const std::string &path) {
+    static const std::unordered_map<std::string, const char *> sources = {
+            {"/app/data.json", kJsonSource},
+            {"/app/copy.json", kJsonSource},
+            {"/app/bad.json", "{\"params\": "},
+    };
+    auto it = sources.find(path);
+    if (it == sources.end()) {
+        return v8::MaybeLocal<v8::String>();
+    }
+    return v8::String::NewFromUtf8(isolate, it->second);
+}
+
+static v8::MaybeLocal<v8::Module> compileMain(v8::Isolate *isolate, ModuleMap *moduleMap, const char *source) {
+    v8::ScriptOrigin origin(isolate, v8::String::NewFromUtf8Literal(isolate, "/app/main.js"), 0, 0, false, -1, v8::Local<v8::Value>(), false, false, true);
+    v8::ScriptCompiler::Source compilerSource(v8::String::NewFromUtf8(isolate, source).ToLocalChecked(), origin);
+    v8::Local<v8::Module> module;
+    if (!v8::ScriptCompiler::CompileModule(isolate, &compilerSource).ToLocal(&module)) {
+        return v8::MaybeLocal<v8::Module>();
+    }
+    moduleMap->insert("/app/main.js", module);
+    return module;
+}
+
+TEST_F(Environment, synthetic_module_import) {
+    v8::Isolate *isolate = getIsolate();
+    v8::HandleScope handleScope(isolate);
+    v8::Local<v8::Context> context = v8::Context::New(isolate);
+    v8::Context::Scope context_scope(context);
+    JsonModuleCache jsonCache;
+    ModuleMap moduleMap(context, "/app", loadJson);
+    moduleMap.setJsonCache(&jsonCache);
+    EXPECT_EQ(moduleMap.resolve("foo", "/app/main.js"), "node:foo");
+    EXPECT_EQ(moduleMap.resolve("node:bar", "/app/main.js"), "node:bar");
+    EXPECT_EQ(moduleMap.resolve("./foo", "/app/main.js"), "/app/foo");
+    EXPECT_TRUE(ModuleMap::IsSynthetic("/app/data.json"));
+    EXPECT_FALSE(ModuleMap::IsSynthetic("/app/foo"));
+
+    const char *source = "import data from './data.json';\n"
+                         "import copy from './copy.json';\n"
+                         "import foo, { add, result } from 'foo';\n"
+                         "import * as bar from 'node:bar';\n"
+                         "globalThis.result = bar.mul(add(data.params, result), data.list.length);\n"
+                         "globalThis.same = data === copy;\n"
+                         "globalThis.params = bar.params + foo.result;";
+    v8::Local<v8::Module> module = compileMain(isolate, &moduleMap, source).ToLocalChecked();
+    ASSERT_TRUE(module->InstantiateModule(context, ModuleMap::ResolveCallback).FromJust());
+    v8::TryCatch tryCatch(isolate);
+    module->Evaluate(context).ToLocalChecked();
+    ASSERT_FALSE(tryCatch.HasCaught());
+    ASSERT_EQ(module->GetStatus(), v8::Module::kEvaluated);
+    v8::Local<v8::Object> global = context->Global();
+    EXPECT_EQ(global->Get(context, v8::String::NewFromUtf8Literal(isolate, "result")).ToLocalChecked().As<v8::Number>()->Value(), 6);
+    EXPECT_EQ(global->Get(context, v8::String::NewFromUtf8Literal(isolate, "params")).ToLocalChecked().As<v8::Number>()->Value(), 2);
+    // 内容相同的两个 JSON 模块只解析一次，但各自得到独立的对象
+    EXPECT_TRUE(global->Get(context, v8::String::NewFromUtf8Literal(isolate, "same")).ToLocalChecked()->IsFalse());
+    EXPECT_EQ(jsonCache.getParseCount(), 1);
+    EXPECT_EQ(jsonCache.getHitCount(), 1);
+    EXPECT_EQ(jsonCache.getSize(), 1);
+
+    v8::Local<v8::Module> foo = moduleMap.get("node:foo").ToLocalChecked();
+    EXPECT_TRUE(foo->IsSyntheticModule());
+    EXPECT_EQ(foo->GetStatus(), v8::Module::kEvaluated);
+}
+
+TEST_F(Environment, synthetic_module_error) {
+    v8::Isolate *isolate = getIsolate();
+    v8::HandleScope handleScope(isolate);
+    v8::Local<v8::Context> context = v8::Context::New(isolate);
+    v8::Context::Scope context_scope(context);
+    ModuleMap moduleMap(context, "/app", loadJson);
+    {
+        // JSON 语法错误在加载时抛出
+        v8::TryCatch tryCatch(isolate);
+        EXPECT_TRUE(moduleMap.load("/app/bad.json").IsEmpty());
+        ASSERT_TRUE(tryCatch.HasCaught());
+        v8::String::Utf8Value message(isolate, tryCatch.Exception());
+        EXPECT_EQ(std::string(*message).compare(0, 11, "SyntaxError"), 0);
+    }
+    {
+        v8::TryCatch tryCatch(isolate);
+        EXPECT_TRUE(moduleMap.load("node:missing").IsEmpty());
+        EXPECT_TRUE(tryCatch.HasCaught());
+    }
+    EXPECT_FALSE(moduleMap.contains("/app/bad.json"));
+}
+
+TEST_F(Environment, json_module_cache_background_parse) {
+    JsonModuleCache jsonCache;
+    // 在后台线程自己的隔离实例上解析
+    std::thread thread([&jsonCache]() -> void {
+        v8::Isolate::CreateParams createParams;
+        std::unique_ptr<v8::ArrayBuffer::Allocator> allocator(v8::ArrayBuffer::Allocator::NewDefaultAllocator());
+        createParams.array_buffer_allocator = allocator.get();
+        v8::Isolate *isolate = v8::Isolate::New(createParams);
+        {
+            v8::Locker locker(isolate);
+            v8::Isolate::Scope isolateScope(isolate);
+            v8::HandleScope handleScope(isolate);
+            v8::Local<v8::Context> context = v8::Context::New(isolate);
+            v8::Context::Scope contextScope(context);
+            EXPECT_TRUE(jsonCache.prepare(context, v8::String::NewFromUtf8(isolate, kJsonSource).ToLocalChecked()));
+        }
+        isolate->Dispose();
+    });
+    thread.join();
+    EXPECT_EQ(jsonCache.getParseCount(), 1);
+
+    v8::Isolate *isolate = getIsolate();
+    v8::HandleScope handleScope(isolate);
+    v8::Local<v8::Context> context = v8::Context::New(isolate);
+    v8::Context::Scope context_scope(context);
+    v8::Local<v8::String> source = v8::String::NewFromUtf8(isolate, kJsonSource).ToLocalChecked();
+    EXPECT_TRUE(jsonCache.contains(isolate, source));
+    v8::Local<v8::Value> value = jsonCache.parse(context, source).ToLocalChecked();
+    EXPECT_EQ(jsonCache.getParseCount(), 1);
+    EXPECT_EQ(jsonCache.getHitCount(), 1);
+    v8::Local<v8::Value> params = value.As<v8::Object>()->Get(context, v8::String::NewFromUtf8Literal(isolate, "params")).ToLocalChecked();
+    EXPECT_EQ(params.As<v8::Number>()->Value(), 1);
+    // 反序列化的对象属于当前上下文
+    EXPECT_TRUE(value.As<v8::Object>()->GetCreationContext().ToLocalChecked() == context);
+}
+
+TEST_F(Environment, json_module_cache_distinct_content) {
+    v8::Isolate *isolate = getIsolate();
+    v8::HandleScope handleScope(isolate);
+    v8::Local<v8::Context> context = v8::Context::New(isolate);
+    v8::Context::Scope context_scope(context);
+    JsonModuleCache jsonCache;
+    // 长度相同、内容不同
+    v8::Local<v8::String> first = v8::String::NewFromUtf8Literal(isolate, "[1]");
+    v8::Local<v8::String> second = v8::String::NewFromUtf8Literal(isolate, "[2]");
+    // "€" 的 UTF-8 字节与 Latin-1 字符串 "â\u0082¬" 的字节相同，但不是同样的内容
+    v8::Local<v8::String> twoByte = v8::String::NewFromUtf8Literal(isolate, "\"\xe2\x82\xac\"");
+    const uint8_t latin1[] = {'"', 0xe2, 0x82, 0xac, '"'};
+    v8::Local<v8::String> oneByte = v8::String::NewFromOneByte(isolate, latin1, v8::NewStringType::kNormal, sizeof(latin1)).ToLocalChecked();
+    EXPECT_EQ(jsonCache.parse(context, first).ToLocalChecked().As<v8::Array>()->Get(context, 0).ToLocalChecked().As<v8::Number>()->Value(), 1);
+    EXPECT_EQ(jsonCache.parse(context, second).ToLocalChecked().As<v8::Array>()->Get(context, 0).ToLocalChecked().As<v8::Number>()->Value(), 2);
+    v8::Local<v8::Value> euro = jsonCache.parse(context, twoByte).ToLocalChecked();
+    v8::Local<v8::Value> chars = jsonCache.parse(context, oneByte).ToLocalChecked();
+    EXPECT_TRUE(euro->StrictEquals(v8::String::NewFromUtf8Literal(isolate, "\xe2\x82\xac")));
+    EXPECT_EQ(chars.As<v8::String>()->Length(), 3);
+    EXPECT_EQ(jsonCache.getParseCount(), 4);
+    EXPECT_EQ(jsonCache.getHitCount(), 0);
+    EXPECT_EQ(jsonCache.getSize(), 4);
+    // 同样的内容命中缓存
+    EXPECT_TRUE(jsonCache.parse(context, twoByte).ToLocalChecked()->StrictEquals(euro));
+    EXPECT_EQ(jsonCache.getHitCount(), 1);
+}
@@ -0,0 +1,138 @@
+#include "./base/cpuTopology.h"
+#include "./base/numaPageAllocator.h"
+#include "./base/threadPool.h"
+#include "gtest/gtest.h"
+#include <cstdio>
+#include <cstring>
+#include <future>
+#include <string>
+#include <vector>
+#if defined(LINUX)
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+TEST(thread_placement_test, parse_cpu_list) {
+    EXPECT_EQ(CpuTopology::ParseCpuList("0-3,6\n"), std::vector<int>({0, 1, 2, 3, 6}));
+    EXPECT_EQ(CpuTopology::ParseCpuList("8"), std::vector<int>({8}));
+    EXPECT_TRUE(CpuTopology::ParseCpuList("\n").empty());
+    EXPECT_TRUE(CpuTopology::ParseCpuList("").empty());
+}
+
+#if defined(LINUX)
+/**
+ * 在临时目录中构造 sysfs 的 system 目录，析构时删除
+ */
+class FakeSysfs {
+public:
+    FakeSysfs() {
+        char root[] = "/tmp/v8_learn_sysfs_XXXXXX";
+        _root = mkdtemp(root);
+        _dirs.push_back(_root);
+    }
+    ~FakeSysfs() {
+        for (auto it = _files.rbegin(); it != _files.rend(); ++it) {
+            remove(it->c_str());
+        }
+        for (auto it = _dirs.rbegin(); it != _dirs.rend(); ++it) {
+            rmdir(it->c_str());
+        }
+    }
+    void mkdir(const std::string &path) {
+        _dirs.push_back(_root + "/" + path);
+        ::mkdir(_dirs.back().c_str(), 0700);
+    }
+    void write(const std::string &path, const std::string &content) {
+        _files.push_back(_root + "/" + path);
+        FILE *file = fopen(_files.back().c_str(), "w");
+        fputs(content.c_str(), file);
+        fclose(file);
+    }
+    const std::string &getRoot() const { return _root; }
+
+private:
+    std::string _root;
+    std::vector<std::string> _dirs;
+    std::vector<std::string> _files;
+};
+
+TEST(thread_placement_test, detect_nodes) {
+    FakeSysfs sysfs;
+    sysfs.mkdir("node");
+    sysfs.mkdir("node/node0");
+    sysfs.mkdir("node/node1");
+    sysfs.write("node/online", "0-1\n");
+    sysfs.write("node/node0/cpulist", "0-1\n");
+    sysfs.write("node/node0/distance", "10 21\n");
+    sysfs.write("node/node1/cpulist", "2-3\n");
+    sysfs.write("node/node1/distance", "21 10\n");
+    CpuTopology topology = CpuTopology::Detect(sysfs.getRoot());
+    ASSERT_EQ(topology.getNodes().size(), 2);
+    EXPECT_EQ(topology.getCpuCount(), 4);
+    EXPECT_EQ(topology.getNodeOfCpu(1), 0);
+    EXPECT_EQ(topology.getNodeOfCpu(3), 1);
+    EXPECT_EQ(topology.getNodeOfCpu(4), -1);
+    EXPECT_EQ(topology.getNode(1)->distances, std::vector<int>({21, 10}));
+    EXPECT_EQ(topology.getNode(2), nullptr);
+    std::vector<ThreadPlacement> placements = topology.getNodePlacements();
+    ASSERT_EQ(placements.size(), 2);
+    EXPECT_EQ(placements[1].numaNode, 1);
+
+    FILE *out = tmpfile();
+    topology.report(out);
+    rewind(out);
+    char line[256] = {};
+    ASSERT_NE(fgets(line, sizeof(line), out), nullptr);
+    EXPECT_EQ(std::string(line).compare(0, 61, "{\"nodes\": [{\"id\": 0, \"cpus\": [0, 1], \"distances\": [10, 21]}, "), 0);
+    fclose(out);
+}
+
+TEST(thread_placement_test, detect_without_numa) {
+    // 没有节点信息时所有在线的 cpu 属于节点 0
+    FakeSysfs sysfs;
+    sysfs.mkdir("cpu");
+    sysfs.write("cpu/online", "0-2\n");
+    CpuTopology topology = CpuTopology::Detect(sysfs.getRoot());
+    ASSERT_EQ(topology.getNodes().size(), 1);
+    EXPECT_EQ(topology.getNodes()[0].cpus, std::vector<int>({0, 1, 2}));
+}
+
+TEST(thread_placement_test, thread_pool_affinity) {
+    int cpu = CpuTopology::GetThreadAffinity().front();
+    ThreadPlacement placement;
+    placement.cpus.push_back(cpu);
+    ThreadPool pool(2, std::vector<ThreadPlacement>{placement});
+    EXPECT_EQ(pool.getPlacement(1).cpus, placement.cpus);
+    std::promise<std::vector<int>> affinity;
+    pool.submit([&affinity]() -> void {
+        affinity.set_value(CpuTopology::GetThreadAffinity());
+    });
+    EXPECT_EQ(affinity.get_future().get(), std::vector<int>({cpu}));
+}
+
+TEST(thread_placement_test, numa_page_allocator) {
+    NumaPageAllocator allocator;
+    const size_t length = 1024 * 1024;
+    const size_t alignment = 256 * 1024;
+    // 没有设置节点时不绑定
+    void *unbound = allocator.AllocatePages(nullptr, length, alignment, v8::PageAllocator::kNoAccess);
+    ASSERT_NE(unbound, nullptr);
+    EXPECT_EQ(allocator.getBoundBytes(), 0);
+    EXPECT_TRUE(allocator.FreePages(unbound, length));
+
+    int node = CpuTopology::Get().getNodes().front().id;
+    NumaPageAllocator::SetThreadNode(node);
+    void *address = allocator.AllocatePages(allocator.GetRandomMmapAddr(), length, alignment, v8::PageAllocator::kNoAccess);
+    NumaPageAllocator::SetThreadNode(-1);
+    ASSERT_NE(address, nullptr);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(address) % alignment, 0);
+    // 内核不支持 NUMA 时绑定失败，内存仍然可以使用
+    EXPECT_EQ(allocator.getBoundBytes() + allocator.getBindFailureCount() * length, length);
+    ASSERT_TRUE(allocator.SetPermissions(address, length, v8::PageAllocator::kReadWrite));
+    memset(address, 1, length);
+    EXPECT_TRUE(allocator.DiscardSystemPages(address, length));
+    EXPECT_EQ(static_cast<uint8_t *>(address)[0], 0);
+    EXPECT_TRUE(allocator.ReleasePages(address, length, length / 2));
+    EXPECT_TRUE(allocator.FreePages(address, length / 2));
+}
+#endif
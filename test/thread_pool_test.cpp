@@ -0,0 +1,79 @@
+#include "./base/abstractAsyncTask.h"
+#include "./base/threadPool.h"
+#include "gtest/gtest.h"
+#include <atomic>
+#include <chrono>
+
+TEST(thread_pool_test, run_all_tasks) {
+    std::atomic<int> count{0};
+    {
+        ThreadPool pool(4);
+        EXPECT_EQ(pool.getThreadCount(), 4);
+        for (int i = 0; i < 1000; ++i) {
+            pool.submit([&count]() -> void { count++; });
+        }
+        // 析构时执行完剩余的任务
+    }
+    EXPECT_EQ(count.load(), 1000);
+}
+
+TEST(thread_pool_test, steal) {
+    ThreadPool pool(4);
+    std::atomic<int> count{0};
+    // 在同一个工作线程上提交的任务都进入该线程自己的队列，其他线程只能通过窃取获得
+    pool.submit([&pool, &count]() -> void {
+        for (int i = 0; i < 64; ++i) {
+            pool.submit([&count]() -> void {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                count++;
+            });
+        }
+    });
+    while (pool.getExecutedCount() < 65) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_GT(pool.getStealCount(), 0);
+    EXPECT_EQ(pool.getQueueDepth(), 0);
+    EXPECT_EQ(count.load(), 64);
+}
+
+class CountAsyncTask : public AbstractAsyncTask {
+public:
+    explicit CountAsyncTask(ThreadPool *threadPool, std::atomic<int> *count) : AbstractAsyncTask(threadPool), count(count) {}
+    void run() override {
+        (*count)++;
+    }
+
+private:
+    std::atomic<int> *count;
+};
+
+TEST(thread_pool_test, abstract_async_task_join) {
+    ThreadPool pool(2);
+    std::atomic<int> count{0};
+    std::vector<std::unique_ptr<CountAsyncTask>> tasks;
+    // 任务数量远大于线程数量，不会为每个任务创建线程
+    for (int i = 0; i < 500; ++i) {
+        tasks.push_back(std::make_unique<CountAsyncTask>(&pool, &count));
+        tasks.back()->start();
+    }
+    for (std::unique_ptr<CountAsyncTask> &task : tasks) {
+        task->join();
+    }
+    EXPECT_EQ(count.load(), 500);
+    // 未启动的任务 join 直接返回
+    CountAsyncTask task(&pool, &count);
+    task.join();
+    EXPECT_EQ(count.load(), 500);
+}
+
+TEST(thread_pool_test, abstract_async_task_destroy_without_join) {
+    // 启动后没有 join 就销毁时终止进程，release 构建中也一样
+    EXPECT_DEATH({
+        ThreadPool pool(1);
+        std::atomic<int> count{0};
+        CountAsyncTask task(&pool, &count);
+        task.start();
+    },
+                 "destroyed without join");
+}
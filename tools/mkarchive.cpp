@@ -0,0 +1,75 @@
+//
+// Created by user on 2026/10/17.
+//
+// 构建步骤：把模块源码和代码缓存打包成单文件归档
+// 用法: v8_learn_mkarchive [--no-code-cache] <输出文件> <根目录> <模块文件>...
+// 模块在归档内的路径为相对于根目录的路径，运行时挂载到任意目录
+#include "../test/base/moduleArchive.h"
+#include "libplatform/libplatform.h"
+#include "v8.h"
+#include <cstring>
+#include <iostream>
+
+int main(int argc, char **argv) {
+    bool codeCache = true;
+    int first = 1;
+    if (argc > 1 && strcmp(argv[1], "--no-code-cache") == 0) {
+        codeCache = false;
+        first++;
+    }
+    if (argc - first < 2) {
+        std::cerr << "usage: " << argv[0] << " [--no-code-cache] <output file> <root directory> <module file>..." << std::endl;
+        return 1;
+    }
+    std::string output = argv[first];
+    std::string root = argv[first + 1];
+    if (!root.empty() && root.back() == '/') {
+        root.pop_back();
+    }
+    ModuleArchive::Builder builder;
+    for (int i = first + 2; i < argc; i++) {
+        std::string file = argv[i];
+        if (file.compare(0, root.size() + 1, root + "/") != 0) {
+            std::cerr << file << " is not under " << root << std::endl;
+            return 1;
+        }
+        std::unique_ptr<MappedFile> mapped = MappedFile::Open(file);
+        if (mapped == nullptr) {
+            std::cerr << "failed to read " << file << std::endl;
+            return 1;
+        }
+        if (!builder.add(file.substr(root.size()), std::string(mapped->data(), mapped->size()))) {
+            std::cerr << file << " is not valid UTF-8" << std::endl;
+            return 1;
+        }
+    }
+
+    bool success;
+    if (codeCache) {
+        // 代码缓存和运行时的 v8 版本、flags 绑定，必须使用同一个 v8 生成
+        v8::V8::InitializeICUDefaultLocation(argv[0]);
+        v8::V8::InitializeExternalStartupData(argv[0]);
+        std::unique_ptr<v8::Platform> platform = v8::platform::NewDefaultPlatform();
+        v8::V8::InitializePlatform(platform.get());
+        v8::V8::Initialize();
+        v8::Isolate::CreateParams create_params;
+        create_params.array_buffer_allocator = v8::ArrayBuffer::Allocator::NewDefaultAllocator();
+        v8::Isolate *isolate = v8::Isolate::New(create_params);
+        {
+            v8::Isolate::Scope isolateScope(isolate);
+            success = builder.write(output, isolate);
+        }
+        isolate->Dispose();
+        delete create_params.array_buffer_allocator;
+        v8::V8::Dispose();
+        v8::V8::ShutdownPlatform();
+    } else {
+        success = builder.write(output);
+    }
+    if (!success) {
+        std::cerr << "failed to write archive " << output << std::endl;
+        return 1;
+    }
+    std::cout << "packed " << builder.getSize() << " modules into " << output << std::endl;
+    return 0;
+}
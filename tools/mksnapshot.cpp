@@ -0,0 +1,31 @@
+//
+// Created by user on 2026/10/17.
+//
+// 构建步骤：生成预置内建对象的启动快照
+// 用法: v8_learn_mksnapshot <输出文件>
+#include "../test/base/snapshot.h"
+#include "libplatform/libplatform.h"
+#include "v8.h"
+#include <iostream>
+
+int main(int argc, char **argv) {
+    if (argc != 2) {
+        std::cerr << "usage: " << argv[0] << " <output file>" << std::endl;
+        return 1;
+    }
+    v8::V8::InitializeICUDefaultLocation(argv[0]);
+    v8::V8::InitializeExternalStartupData(argv[0]);
+    std::unique_ptr<v8::Platform> platform = v8::platform::NewDefaultPlatform();
+    v8::V8::InitializePlatform(platform.get());
+    v8::V8::Initialize();
+    v8::StartupData startupData = Snapshot::Create();
+    bool success = startupData.data != nullptr && Snapshot::WriteFile(argv[1], startupData);
+    delete[] startupData.data;
+    v8::V8::Dispose();
+    v8::V8::ShutdownPlatform();
+    if (!success) {
+        std::cerr << "failed to create snapshot " << argv[1] << std::endl;
+        return 1;
+    }
+    return 0;
+}